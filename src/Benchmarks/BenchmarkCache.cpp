@@ -0,0 +1,1169 @@
+// para medir tiempos de alta resolucion
+#include <chrono>
+// para entrada/salida estandar
+#include <iostream>
+// para generar la traza aleatoria
+#include <random>
+// para contenedor vector
+#include <vector>
+// para componer nombres de los casos
+#include <string>
+// para funciones generales como EXIT_SUCCESS
+#include <cstdlib>
+// para std::max
+#include <algorithm>
+// para consultar el numero de nucleos
+#include <thread>
+// para borrar la traza temporal
+#include <cstdio>
+// para escribir el informe JSON y el modelo OBJ temporal
+#include <fstream>
+// para las cargas de trabajo de la seccion 22
+#include <memory>
+// para avisar de un caso desconocido
+#include <stdexcept>
+// nuestro archivo de cache
+#include "Cache/Cache.hpp"
+// jerarquia de varios niveles de cache
+#include "Cache/JerarquiaCache.hpp"
+// distancias de pila para todas las caches LRU a la vez
+#include "Cache/DistanciaPila.hpp"
+// nucleos con caches coherentes
+#include "Cache/SistemaCoherente.hpp"
+// latencias, MSHR y fallos no bloqueantes
+#include "Cache/ModeloTiempo.hpp"
+// TLB y recorrido de la tabla de paginas
+#include "Cache/Tlb.hpp"
+// caches con la geometria fijada en compilacion
+#include "Cache/CacheFija.hpp"
+// generador de patrones de acceso
+#include "DataGenerators/GeneradorDatos.hpp"
+// cargas de trabajo generadas por tramos
+#include "DataGenerators/CargasTrabajo.hpp"
+// lectura y escritura de trazas binarias
+#include "DataLoaders/TrazaBinaria.hpp"
+// importadores de trazas de otras herramientas
+#include "DataLoaders/ImportadorTrazas.hpp"
+// carga de modelos OBJ
+#include "DataLoaders/LectorModelos3D.hpp"
+// carga de nubes de puntos en segundo plano
+#include "DataLoaders/NubePuntos.hpp"
+// transformacion y proyeccion de vertices del renderizador
+#include "Graficos/Proyeccion.hpp"
+
+// reloj monotono usado en todas las mediciones
+using Reloj = std::chrono::steady_clock;
+
+// numero de mediciones independientes por defecto (--mediciones cambia el valor)
+constexpr int MEDICIONES_POR_DEFECTO = 5;
+
+// operaciones por muestra: cada medicion se cronometra por tramos de este tamaño y los
+// percentiles salen de todos los tramos, no de las pocas mediciones completas
+constexpr std::size_t OPERACIONES_POR_MUESTRA = std::size_t(1) << 16;
+
+// resultado de un caso: segundos de cada medicion y operaciones de cada una
+struct ResultadoBenchmark {
+    std::string nombre;
+    double operaciones;
+    std::vector<double> segundos;
+    // ns/op de cada tramo de todas las mediciones; vacio si el caso solo se puede medir
+    // entero (una llamada opaca), y entonces los percentiles son de las mediciones
+    std::vector<double> muestras;
+    uint64_t aciertos;
+};
+
+// cronometro de una medicion que ademas guarda el ns/op de cada tramo de al menos
+// OPERACIONES_POR_MUESTRA operaciones
+class Cronometro {
+private:
+    std::vector<double>& muestras;
+    const Reloj::time_point inicio;
+    Reloj::time_point marca;
+    // operaciones desde la ultima marca
+    std::size_t pendientes = 0;
+
+    void marcar(Reloj::time_point ahora) {
+        muestras.push_back(std::chrono::duration<double, std::nano>(ahora - marca).count() /
+                           static_cast<double>(pendientes));
+        marca = ahora;
+        pendientes = 0;
+    }
+
+public:
+    explicit Cronometro(std::vector<double>& muestras) :
+        muestras(muestras), inicio(Reloj::now()), marca(inicio) {}
+
+    // cuenta operaciones hechas; cierra un tramo al llegar al tamaño de muestra
+    void avanzar(std::size_t operaciones) {
+        pendientes += operaciones;
+        if (pendientes >= OPERACIONES_POR_MUESTRA) marcar(Reloj::now());
+    }
+    // segundos de la medicion completa; el resto final solo es muestra si llega a medio tramo
+    // (en un resto pequeño pesaria mas la lectura del reloj que el trabajo)
+    double terminar() {
+        const Reloj::time_point ahora = Reloj::now();
+        if (pendientes >= OPERACIONES_POR_MUESTRA / 2) marcar(ahora);
+        return std::chrono::duration<double>(ahora - inicio).count();
+    }
+};
+
+// llama a funcion(primera, cantidad) sobre [0, total) por tramos de tamaño de muestra
+template <typename Funcion>
+static void porTramos(Cronometro& cronometro, std::size_t total, Funcion&& funcion,
+                      std::size_t tramo = OPERACIONES_POR_MUESTRA) {
+    for (std::size_t primera = 0; primera < total; primera += tramo) {
+        const std::size_t cantidad = std::min(tramo, total - primera);
+        funcion(primera, cantidad);
+        cronometro.avanzar(cantidad);
+    }
+}
+
+// mediciones de cada caso y resultados acumulados para el informe JSON
+static int mediciones = MEDICIONES_POR_DEFECTO;
+static std::vector<ResultadoBenchmark> resultados;
+// comprobaciones de equivalencia fallidas (el benchmark termina con error si hay alguna)
+static int comprobacionesFallidas = 0;
+
+// comprueba que dos caminos que deben coincidir dan el mismo valor
+static void comprobarIguales(const std::string& descripcion, uint64_t obtenido, uint64_t esperado) {
+    if (obtenido == esperado) return;
+    std::cerr << "Error: " << descripcion << ": " << obtenido << " frente a " << esperado << "\n";
+    ++comprobacionesFallidas;
+}
+
+// comprueba que un valor exacto cae dentro del intervalo centro +- margen de una estimacion
+static void comprobarEnIntervalo(const std::string& descripcion, double exacto, double centro, double margen) {
+    if (exacto >= centro - margen && exacto <= centro + margen) return;
+    std::cerr << "Error: " << descripcion << ": " << exacto << " fuera de " << centro << " +- " << margen << "\n";
+    ++comprobacionesFallidas;
+}
+
+// aciertos del ultimo caso registrado con ese nombre
+static uint64_t aciertosDe(const std::string& nombre) {
+    for (auto resultado = resultados.rbegin(); resultado != resultados.rend(); ++resultado) {
+        if (resultado->nombre == nombre) return resultado->aciertos;
+    }
+    throw std::invalid_argument("Caso de benchmark desconocido: " + nombre);
+}
+
+// aciertos de un modelo LRU ingenuo (una lista por conjunto, el bloque mas reciente delante)
+// que sirve de referencia a la politica LRU de Cache
+static uint64_t aciertosLruReferencia(const std::vector<uint64_t>& traza, int conjuntos, int vias, int bloque) {
+    std::vector<std::vector<uint64_t>> pilas(conjuntos);
+    uint64_t aciertos = 0;
+    for (uint64_t direccion : traza) {
+        const uint64_t numeroBloque = direccion / static_cast<uint64_t>(bloque);
+        std::vector<uint64_t>& pila = pilas[numeroBloque % static_cast<uint64_t>(conjuntos)];
+        auto posicion = std::find(pila.begin(), pila.end(), numeroBloque);
+        if (posicion != pila.end()) {
+            ++aciertos;
+            std::rotate(pila.begin(), posicion, posicion + 1);
+            continue;
+        }
+        if (pila.size() == static_cast<std::size_t>(vias)) pila.pop_back();
+        pila.insert(pila.begin(), numeroBloque);
+    }
+    return aciertos;
+}
+
+// percentil p (0-100) de valores ordenados, interpolando entre vecinos
+static double percentil(const std::vector<double>& ordenados, double p) {
+    if (ordenados.empty()) return 0.0;
+    const double posicion = p / 100.0 * static_cast<double>(ordenados.size() - 1);
+    const std::size_t abajo = static_cast<std::size_t>(posicion);
+    const std::size_t arriba = std::min(abajo + 1, ordenados.size() - 1);
+    return ordenados[abajo] + (ordenados[arriba] - ordenados[abajo]) * (posicion - static_cast<double>(abajo));
+}
+
+// nanosegundos por operacion de cada medicion, de menor a mayor
+static std::vector<double> nsPorOperacion(const ResultadoBenchmark& resultado) {
+    std::vector<double> ns;
+    for (double segundos : resultado.segundos) {
+        ns.push_back(segundos * 1e9 / resultado.operaciones);
+    }
+    std::sort(ns.begin(), ns.end());
+    return ns;
+}
+
+// distribucion de la que salen los percentiles: los tramos si los hay, si no las mediciones
+static std::vector<double> distribucion(const ResultadoBenchmark& resultado) {
+    if (resultado.muestras.empty()) return nsPorOperacion(resultado);
+    std::vector<double> ns = resultado.muestras;
+    std::sort(ns.begin(), ns.end());
+    return ns;
+}
+
+// registra un caso e imprime una linea con formato uniforme (mejor medicion y mediana)
+// muestras son los ns/op por tramo de todas las mediciones (vacio si no se trocean)
+static void imprimirResultado(const std::string& nombre, double operaciones,
+                              const std::vector<double>& segundos, uint64_t aciertos,
+                              const std::vector<double>& muestras = {}) {
+    resultados.push_back(ResultadoBenchmark{nombre, operaciones, segundos, muestras, aciertos});
+    const std::vector<double> ns = nsPorOperacion(resultados.back());
+    const std::vector<double> tramos = distribucion(resultados.back());
+    std::cout << nombre << ": " << (1e3 / ns.front()) << " M op/s, mediana "
+              << percentil(tramos, 50) << " ns/op, p99 " << percentil(tramos, 99)
+              << " ns/op (aciertos=" << aciertos << ")\n";
+}
+
+// ejecuta la traza completa sobre una cache nueva en cada medicion y registra el caso
+// con enLote=true la traza se entrega entera a Cache::accederLote
+static void medirTraza(const std::string& nombre, const std::vector<uint64_t>& traza, int repeticiones,
+                       int tamano, int bloque, int vias,
+                       PoliticaReemplazo politica = PoliticaReemplazo::LRU, bool enLote = false) {
+    std::vector<double> tiempos;
+    std::vector<double> muestras;
+    uint64_t aciertos = 0;
+    for (int m = 0; m < mediciones; ++m) {
+        // cache recien construida para que todas las mediciones partan del mismo estado
+        Cache cache(tamano, bloque, vias, politica);
+
+        // marca tiempo inicial
+        Cronometro cronometro(muestras);
+        // recorre la traza las veces pedidas para amortizar el coste del reloj
+        for (int r = 0; r < repeticiones; ++r) {
+            porTramos(cronometro, traza.size(), [&](std::size_t primera, std::size_t cantidad) {
+                if (enLote) {
+                    cache.accederLote(traza.data() + primera, cantidad);
+                    return;
+                }
+                for (std::size_t i = primera; i < primera + cantidad; ++i) {
+                    cache.acceder(traza[i]);
+                }
+            });
+        }
+        // tiempo transcurrido en segundos
+        tiempos.push_back(cronometro.terminar());
+
+        // guarda aciertos para que el compilador no elimine el bucle
+        aciertos = cache.getAciertos();
+    }
+    imprimirResultado(nombre, static_cast<double>(traza.size()) * repeticiones, tiempos, aciertos, muestras);
+}
+
+// escribe una cadena JSON escapando comillas y barras
+static void escribirCadenaJson(std::ostream& salida, const std::string& texto) {
+    salida << '"';
+    for (char c : texto) {
+        if (c == '"' || c == '\\') salida << '\\';
+        salida << c;
+    }
+    salida << '"';
+}
+
+// escribe todos los resultados como JSON: ns/op minimo, percentiles, media y maximo de la
+// distribucion por tramos (muestras > mediciones) o por mediciones completas, y el mejor y la
+// mediana de las mediciones completas
+static bool escribirJson(const std::string& ruta, unsigned nucleos) {
+    std::ofstream salida(ruta);
+    if (!salida) return false;
+    salida << "{\n  \"mediciones\": " << mediciones << ",\n  \"nucleos\": " << nucleos
+           << ",\n  \"operaciones_por_muestra\": " << OPERACIONES_POR_MUESTRA
+           << ",\n  \"resultados\": [\n";
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoBenchmark& resultado = resultados[i];
+        const std::vector<double> completas = nsPorOperacion(resultado);
+        const std::vector<double> ns = distribucion(resultado);
+        double media = 0.0;
+        for (double valor : ns) media += valor;
+        media /= static_cast<double>(ns.size());
+        salida << "    {\"nombre\": ";
+        escribirCadenaJson(salida, resultado.nombre);
+        salida << ", \"operaciones\": " << static_cast<uint64_t>(resultado.operaciones)
+               << ", \"aciertos\": " << resultado.aciertos << ", \"muestras\": " << ns.size()
+               << ", \"ns_por_op\": {\"min\": " << ns.front() << ", \"p50\": " << percentil(ns, 50)
+               << ", \"p90\": " << percentil(ns, 90) << ", \"p99\": " << percentil(ns, 99)
+               << ", \"media\": " << media << ", \"max\": " << ns.back() << "}"
+               << ", \"ns_por_op_medicion\": {\"min\": " << completas.front()
+               << ", \"p50\": " << percentil(completas, 50) << "}"
+               << ", \"op_por_segundo\": " << 1e9 / completas.front() << "}"
+               << (i + 1 < resultados.size() ? ",\n" : "\n");
+    }
+    salida << "  ]\n}\n";
+    return static_cast<bool>(salida);
+}
+
+// punto de entrada del benchmark de la cache
+// uso: benchmark_cache [--json archivo] [--mediciones N]
+// termina con EXIT_FAILURE si dos caminos que deben dar los mismos resultados no coinciden
+int main(int argc, char* argv[]) {
+    std::string rutaJson;
+    for (int i = 1; i < argc; ++i) {
+        const std::string opcion = argv[i];
+        if (opcion == "--json" && i + 1 < argc) {
+            rutaJson = argv[++i];
+        } else if (opcion == "--mediciones" && i + 1 < argc) {
+            mediciones = std::atoi(argv[++i]);
+        } else {
+            mediciones = 0;
+        }
+        if (mediciones <= 0) {
+            std::cerr << "Uso: " << argv[0] << " [--json archivo] [--mediciones N]\n";
+            return EXIT_FAILURE;
+        }
+    }
+    uint64_t aciertos = 0;
+
+    // 1. secuencia optimizada de la aplicacion, sobre la geometria de principal.cpp
+    std::vector<uint64_t> optimizada = GeneradorDatos::generarSecuenciaOptimizada(1024, 64, 4);
+    medirTraza("optimizada  1K/64B/4 vias", optimizada, 5000, 1024, 64, 4);
+
+    // 2. traza aleatoria grande sobre una cache de 32K y 8 vias
+    const std::size_t tamanoTraza = 20000000;
+    std::vector<uint64_t> aleatoria(tamanoTraza);
+    // semilla fija para que las ejecuciones sean comparables
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> dist(0, (1 << 24) - 1);
+    for (auto& direccion : aleatoria) {
+        direccion = dist(gen);
+    }
+    medirTraza("aleatoria  32K/64B/8 vias", aleatoria, 1, 32768, 64, 8);
+    // la misma traza desplazada por encima de 4 GiB: mismos aciertos y mismo coste
+    std::vector<uint64_t> aleatoriaAlta(aleatoria);
+    for (auto& direccion : aleatoriaAlta) {
+        direccion += uint64_t(1) << 40;
+    }
+    medirTraza("aleatoria  32K/64B/8 vias, direcciones > 4 GiB", aleatoriaAlta, 1, 32768, 64, 8);
+
+    // 3. politicas de reemplazo en caches de alta asociatividad
+    // la traza cubre el doble de la capacidad para mezclar aciertos y fallos
+    const PoliticaReemplazo politicasMedidas[] = {
+        PoliticaReemplazo::LRU, PoliticaReemplazo::PLRU_ARBOL, PoliticaReemplazo::SRRIP,
+        PoliticaReemplazo::BRRIP, PoliticaReemplazo::FIFO, PoliticaReemplazo::ALEATORIA
+    };
+    std::vector<uint64_t> reutilizacion(tamanoTraza / 4);
+    std::uniform_int_distribution<int> distReutilizacion(0, 2 * 262144 - 1);
+    for (auto& direccion : reutilizacion) {
+        direccion = distReutilizacion(gen);
+    }
+    for (int vias : {16, 32}) {
+        const std::string geometria = std::string("256K/64B/") + std::to_string(vias) + " vias ";
+        for (PoliticaReemplazo politica : politicasMedidas) {
+            medirTraza("politica " + geometria + nombrePoliticaReemplazo(politica), reutilizacion, 1, 262144, 64,
+                       vias, politica);
+        }
+        // LRU exacto: los mismos aciertos que el modelo de referencia
+        comprobarIguales("LRU " + geometria + "frente al modelo de referencia",
+                         aciertosDe("politica " + geometria + "LRU"),
+                         aciertosLruReferencia(reutilizacion, 262144 / (64 * vias), vias, 64));
+    }
+
+    // 4. acceso por direccion frente a acceso por lotes (mismos aciertos esperados)
+    medirTraza("lote optimizada  1K/64B/4 vias", optimizada, 5000, 1024, 64, 4, PoliticaReemplazo::LRU, true);
+    medirTraza("lote aleatoria  32K/64B/8 vias", aleatoria, 1, 32768, 64, 8, PoliticaReemplazo::LRU, true);
+    for (int vias : {16, 32}) {
+        medirTraza(std::string("individual 256K/64B/") + std::to_string(vias) + " vias LRU",
+                   reutilizacion, 1, 262144, 64, vias);
+        medirTraza(std::string("lote       256K/64B/") + std::to_string(vias) + " vias LRU",
+                   reutilizacion, 1, 262144, 64, vias, PoliticaReemplazo::LRU, true);
+    }
+    comprobarIguales("lote frente a individual, optimizada 1K", aciertosDe("lote optimizada  1K/64B/4 vias"),
+                     aciertosDe("optimizada  1K/64B/4 vias"));
+    comprobarIguales("lote frente a individual, aleatoria 32K", aciertosDe("lote aleatoria  32K/64B/8 vias"),
+                     aciertosDe("aleatoria  32K/64B/8 vias"));
+    for (int vias : {16, 32}) {
+        const std::string geometria = std::string("256K/64B/") + std::to_string(vias) + " vias LRU";
+        comprobarIguales("lote frente a individual, " + geometria, aciertosDe("lote       " + geometria),
+                         aciertosDe("individual " + geometria));
+    }
+    // la comparacion vectorial de etiquetas da el mismo mapa que la escalar
+    // (etiquetas de un rango pequeño para que haya varias coincidencias por conjunto)
+    {
+        uint64_t etiquetasConjunto[Cache::MAX_VIAS + RELLENO_ETIQUETAS];
+        std::uniform_int_distribution<uint64_t> distEtiqueta(0, 7);
+        uint64_t mapasDistintos = 0;
+        for (int prueba = 0; prueba < 100000; ++prueba) {
+            const int vias = 1 + prueba % Cache::MAX_VIAS;
+            for (uint64_t& etiqueta : etiquetasConjunto) etiqueta = distEtiqueta(gen);
+            const uint64_t buscada = distEtiqueta(gen);
+            const uint64_t mascara = vias == 64 ? ~uint64_t(0) : (uint64_t(1) << vias) - 1;
+            mapasDistintos += (coincidenciasSIMD(etiquetasConjunto, buscada, vias) & mascara) !=
+                              coincidenciasEscalar(etiquetasConjunto, buscada, vias);
+        }
+        comprobarIguales("comparacion SIMD frente a escalar, mapas distintos", mapasDistintos, 0);
+    }
+
+    // 5. coste de la jerarquia frente a una L1 aislada en una traza dominada por aciertos
+    // tiempos de cada medicion completa y ns/op de cada tramo, compartidos por los casos
+    std::vector<double> tiempos;
+    std::vector<double> muestras;
+    for (int m = 0; m < mediciones; ++m) {
+        JerarquiaCache jerarquia({{1024, 64, 4}, {8192, 64, 8}, {65536, 64, 16}},
+                                 PoliticaInclusion::INCLUSIVA);
+        Cronometro cronometro(muestras);
+        for (int r = 0; r < 5000; ++r) {
+            for (uint64_t direccion : optimizada) {
+                jerarquia.acceder(direccion);
+            }
+            cronometro.avanzar(optimizada.size());
+        }
+        tiempos.push_back(cronometro.terminar());
+        aciertos = jerarquia.getNivel(0).getAciertos();
+    }
+    imprimirResultado("jerarquia  1K/8K/64K inclusiva",
+                      static_cast<double>(optimizada.size()) * 5000, tiempos, aciertos, muestras);
+
+    // 6. simulacion repartida por conjuntos (mismos aciertos con cualquier numero de hilos)
+    const unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    // cada llamada arranca sus hilos: tramos de 1M accesos para que el arranque no domine
+    const std::size_t tramoParalelo = std::size_t(1) << 20;
+    // referencia en serie: mismos aciertos y fallos y mismo contenido final
+    Cache serie(262144, 64, 16);
+    serie.accederLote(aleatoria);
+    const std::size_t comprobadasContenido = std::min<std::size_t>(aleatoria.size(), std::size_t(1) << 16);
+    for (unsigned hilos = 1; hilos <= std::max(4u, nucleos); hilos *= 2) {
+        tiempos.clear();
+        muestras.clear();
+        const std::string nombre = std::string("paralelo 256K/64B/16 vias LRU, ") + std::to_string(hilos) + " hilos";
+        for (int m = 0; m < mediciones; ++m) {
+            Cache cache(262144, 64, 16);
+            Cronometro cronometro(muestras);
+            porTramos(cronometro, aleatoria.size(), [&](std::size_t primera, std::size_t cantidad) {
+                cache.accederParalelo(aleatoria.data() + primera, cantidad, hilos);
+            }, tramoParalelo);
+            tiempos.push_back(cronometro.terminar());
+            aciertos = cache.getAciertos();
+            comprobarIguales(nombre + ", aciertos frente a la serie", aciertos, serie.getAciertos());
+            comprobarIguales(nombre + ", fallos frente a la serie", cache.getFallos(), serie.getFallos());
+            // las ultimas direcciones de la traza estan o no en la cache igual que en serie
+            uint64_t contenidoDistinto = 0;
+            for (std::size_t i = aleatoria.size() - comprobadasContenido; i < aleatoria.size(); ++i) {
+                contenidoDistinto += cache.contiene(aleatoria[i]) != serie.contiene(aleatoria[i]);
+            }
+            comprobarIguales(nombre + ", lineas distintas de la serie", contenidoDistinto, 0);
+        }
+        imprimirResultado(nombre + " (" + std::to_string(nucleos) + " nucleos)",
+                          static_cast<double>(aleatoria.size()), tiempos, aciertos, muestras);
+    }
+
+    // 7. la traza aleatoria leida en flujo desde un archivo binario proyectado en memoria
+    const std::string rutaTraza = "benchmark_cache.traza";
+    {
+        EscritorTrazaBinaria escritor(rutaTraza);
+        for (uint64_t direccion : aleatoria) {
+            escritor.escribir(direccion);
+        }
+    }
+    tiempos.clear();
+    muestras.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        Cache cache(32768, 64, 8);
+        LectorTrazaBinaria lector(rutaTraza);
+        TramoTraza tramo;
+        Cronometro cronometro(muestras);
+        while (lector.siguienteTramo(tramo)) {
+            cache.accederLote(tramo.direcciones);
+            cronometro.avanzar(tramo.direcciones.size());
+        }
+        tiempos.push_back(cronometro.terminar());
+        aciertos = cache.getAciertos();
+    }
+    std::remove(rutaTraza.c_str());
+    imprimirResultado("traza mmap 32K/64B/8 vias",
+                      static_cast<double>(aleatoria.size()), tiempos, aciertos, muestras);
+
+    // 8. prefetchers sobre tres recorridos de 2M accesos, cada uno con sus pc:
+    // palabras de 8 B seguidas, cuatro flujos de palabras intercalados y dos strides
+    // intercalados (5 y -3 bloques, que solo sigue el prefetch por PC)
+    struct RecorridoPrefetch {
+        std::string nombre;
+        std::vector<uint64_t> direcciones;
+        std::vector<uint64_t> pcs;
+    };
+    std::vector<RecorridoPrefetch> recorridos(3);
+    recorridos[0].nombre = "secuencial";
+    recorridos[1].nombre = "cuatro flujos";
+    recorridos[2].nombre = "strides 5 y -3 bloques";
+    for (int i = 0; i < 2000000; ++i) {
+        recorridos[0].direcciones.push_back(uint64_t(i) * 8);
+        recorridos[0].pcs.push_back(0x401000);
+        // flujo i % 4 en su propia region de 64 MiB
+        recorridos[1].direcciones.push_back((uint64_t(i % 4) << 26) + uint64_t(i / 4) * 8);
+        recorridos[1].pcs.push_back(0x401000 + (i % 4) * 0x40);
+    }
+    for (int i = 0; i < 1000000; ++i) {
+        recorridos[2].direcciones.push_back(i * 320);
+        recorridos[2].pcs.push_back(0x401000);
+        recorridos[2].direcciones.push_back(500000000 - i * 192);
+        recorridos[2].pcs.push_back(0x401040);
+    }
+    for (const RecorridoPrefetch& recorrido : recorridos) {
+        for (TipoPrefetcher tipo : {TipoPrefetcher::NINGUNO, TipoPrefetcher::LINEA_SIGUIENTE,
+                                    TipoPrefetcher::STRIDE_PC, TipoPrefetcher::FLUJO}) {
+            ConfiguracionPrefetch configuracion;
+            configuracion.tipo = tipo;
+            // antelacion por encima de la latencia tambien en el recorrido secuencial
+            configuracion.distancia = 16;
+            configuracion.latencia = 10;
+            tiempos.clear();
+            muestras.clear();
+            EstadisticasPrefetch prefetch;
+            uint64_t fallos = 0;
+            for (int m = 0; m < mediciones; ++m) {
+                Cache cache(32768, 64, 8);
+                cache.configurarPrefetch(configuracion);
+                Cronometro cronometro(muestras);
+                porTramos(cronometro, recorrido.direcciones.size(), [&](std::size_t primera, std::size_t cantidad) {
+                    for (std::size_t i = primera; i < primera + cantidad; ++i) {
+                        cache.accederConPrefetch(recorrido.direcciones[i], recorrido.pcs[i]);
+                    }
+                });
+                tiempos.push_back(cronometro.terminar());
+                aciertos = cache.getAciertos();
+                fallos = cache.getFallos();
+                prefetch = cache.getEstadisticasPrefetch();
+            }
+            imprimirResultado("prefetch " + recorrido.nombre + ", " + nombreTipoPrefetcher(tipo) + " 32K/64B/8 vias",
+                              static_cast<double>(recorrido.direcciones.size()), tiempos, aciertos, muestras);
+            std::cout << "  precision=" << prefetch.precision() * 100.0 << "%"
+                      << " cobertura=" << prefetch.cobertura(fallos) * 100.0 << "%"
+                      << " puntualidad=" << prefetch.puntualidad() * 100.0 << "%\n";
+        }
+    }
+
+    // 9. politicas de escritura sobre la traza de reutilizacion con un 30% de escrituras
+    std::vector<TipoAcceso> tipos(reutilizacion.size());
+    std::bernoulli_distribution esEscritura(0.3);
+    for (auto& tipo : tipos) {
+        tipo = esEscritura(gen) ? TipoAcceso::ESCRITURA : TipoAcceso::LECTURA;
+    }
+    for (PoliticaEscritura escritura : {PoliticaEscritura::WRITE_BACK, PoliticaEscritura::WRITE_THROUGH}) {
+        for (bool asignar : {true, false}) {
+            tiempos.clear();
+            muestras.clear();
+            uint64_t bytesLeidos = 0;
+            uint64_t bytesEscritos = 0;
+            for (int m = 0; m < mediciones; ++m) {
+                Cache cache(262144, 64, 16);
+                cache.configurarEscritura(escritura, asignar);
+                Cronometro cronometro(muestras);
+                porTramos(cronometro, reutilizacion.size(), [&](std::size_t primera, std::size_t cantidad) {
+                    cache.accederLote(reutilizacion.data() + primera, tipos.data() + primera, cantidad);
+                });
+                tiempos.push_back(cronometro.terminar());
+                aciertos = cache.getAciertos();
+                bytesLeidos = cache.getBytesLeidos();
+                bytesEscritos = cache.getBytesEscritos();
+            }
+            imprimirResultado(std::string("escritura 256K/64B/16 vias ") +
+                              (escritura == PoliticaEscritura::WRITE_BACK ? "write-back" : "write-through") +
+                              (asignar ? " con asignacion" : " sin asignacion"),
+                              static_cast<double>(reutilizacion.size()), tiempos, aciertos, muestras);
+            std::cout << "  bytes leidos=" << bytesLeidos << " bytes escritos=" << bytesEscritos << "\n";
+        }
+    }
+
+    // 10. barrido de caches LRU: una simulacion por geometria frente a una pasada de distancias de pila
+    const std::vector<int> conjuntosBarrido = {64, 256, 1024};
+    const int viasBarrido[] = {1, 2, 4, 8, 16, 32, 64};
+    const std::size_t cachesBarrido = conjuntosBarrido.size() * std::size(viasBarrido);
+    std::vector<uint64_t> fallosSimulados;
+    tiempos.clear();
+    muestras.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        fallosSimulados.clear();
+        Cronometro cronometro(muestras);
+        for (int conjuntos : conjuntosBarrido) {
+            for (int vias : viasBarrido) {
+                Cache cache(conjuntos * vias * 64, 64, vias);
+                porTramos(cronometro, reutilizacion.size(), [&](std::size_t primera, std::size_t cantidad) {
+                    cache.accederLote(reutilizacion.data() + primera, cantidad);
+                });
+                fallosSimulados.push_back(cache.getFallos());
+            }
+        }
+        tiempos.push_back(cronometro.terminar());
+    }
+    std::sort(tiempos.begin(), tiempos.end());
+    const double segundosBarrido = tiempos[tiempos.size() / 2];
+    imprimirResultado("barrido LRU " + std::to_string(cachesBarrido) + " caches, simulacion",
+                      static_cast<double>(reutilizacion.size() * cachesBarrido), tiempos, fallosSimulados.size(),
+                      muestras);
+
+    tiempos.clear();
+    muestras.clear();
+    std::unique_ptr<DistanciaPila> distancias;
+    for (int m = 0; m < mediciones; ++m) {
+        distancias = std::make_unique<DistanciaPila>(64, conjuntosBarrido);
+        Cronometro cronometro(muestras);
+        porTramos(cronometro, reutilizacion.size(), [&](std::size_t primera, std::size_t cantidad) {
+            distancias->accederLote(reutilizacion.data() + primera, cantidad);
+        });
+        tiempos.push_back(cronometro.terminar());
+    }
+    std::sort(tiempos.begin(), tiempos.end());
+    const double segundosPila = tiempos[tiempos.size() / 2];
+    imprimirResultado("barrido LRU " + std::to_string(cachesBarrido) + " caches, distancias de pila",
+                      static_cast<double>(reutilizacion.size()), tiempos, cachesBarrido, muestras);
+
+    // las dos formas deben dar exactamente los mismos fallos
+    int discrepancias = 0;
+    std::size_t punto = 0;
+    for (std::size_t g = 0; g < conjuntosBarrido.size(); ++g) {
+        for (int vias : viasBarrido) {
+            const uint64_t fallosPila = distancias->fallos(g, vias);
+            if (fallosPila != fallosSimulados[punto]) ++discrepancias;
+            comprobarIguales("distancias de pila frente a Cache LRU, " + std::to_string(conjuntosBarrido[g]) +
+                             " conjuntos y " + std::to_string(vias) + " vias", fallosPila, fallosSimulados[punto]);
+            ++punto;
+        }
+    }
+    std::cout << "barrido LRU " << fallosSimulados.size() << " caches: simulacion " << segundosBarrido
+              << " s, distancias de pila " << segundosPila << " s (x" << (segundosBarrido / segundosPila)
+              << ", discrepancias=" << discrepancias << ")\n";
+
+    // 11. cuatro nucleos con contadores vecinos en el mismo bloque (comparticion falsa),
+    // un bloque realmente compartido y datos privados; mismos resultados con 1 y N hilos
+    // (con un fallo cada pocos accesos las rondas son cortas y el sistema va en serie)
+    std::vector<TrazaNucleo> trazasNucleos(4);
+    std::uniform_int_distribution<int> distPrivada(0, 65535);
+    for (int nucleo = 0; nucleo < 4; ++nucleo) {
+        TrazaNucleo& traza = trazasNucleos[nucleo];
+        for (int i = 0; i < 250000; ++i) {
+            const int clase = i % 10;
+            if (clase == 0) {
+                // contador propio, vecino de los de los demas nucleos
+                traza.direcciones.push_back(0x1000 + nucleo * 8);
+                traza.tipos.push_back(TipoAcceso::ESCRITURA);
+            } else if (clase == 1) {
+                // dato compartido de verdad
+                traza.direcciones.push_back(0x2000);
+                traza.tipos.push_back(nucleo == 0 ? TipoAcceso::ESCRITURA : TipoAcceso::LECTURA);
+            } else {
+                traza.direcciones.push_back((uint64_t(nucleo + 1) << 24) + distPrivada(gen));
+                traza.tipos.push_back(clase == 2 ? TipoAcceso::ESCRITURA : TipoAcceso::LECTURA);
+            }
+        }
+    }
+    for (ProtocoloCoherencia protocolo : {ProtocoloCoherencia::MESI, ProtocoloCoherencia::MOESI}) {
+        for (unsigned hilos : {1u, 4u}) {
+            tiempos.clear();
+            EstadisticasCoherencia coherencia;
+            uint64_t bytesCoherencia = 0;
+            for (int m = 0; m < mediciones; ++m) {
+                SistemaCoherente sistema(4, {32768, 64, 8}, {1048576, 64, 16}, protocolo);
+                auto inicio = Reloj::now();
+                sistema.simular(trazasNucleos, hilos);
+                double segundos = std::chrono::duration<double>(Reloj::now() - inicio).count();
+                tiempos.push_back(segundos);
+                aciertos = 0;
+                for (int nucleo = 0; nucleo < 4; ++nucleo) aciertos += sistema.getPrivada(nucleo).getAciertos();
+                coherencia = sistema.getEstadisticas();
+                bytesCoherencia = sistema.getBytesCoherencia();
+            }
+            imprimirResultado(std::string("coherencia ") + nombreProtocoloCoherencia(protocolo) + " 4 nucleos, " +
+                              std::to_string(hilos) + " hilos (" + std::to_string(nucleos) + " nucleos)",
+                              1000000.0, tiempos, aciertos);
+            std::cout << "  invalidaciones=" << coherencia.invalidaciones
+                      << " falsas=" << coherencia.invalidacionesFalsas
+                      << " transferencias=" << coherencia.transferencias
+                      << " bytes coherencia=" << bytesCoherencia << "\n";
+        }
+    }
+
+    // cuatro nucleos que trabajan sobre 16K privados que caben en su L1 y solo escriben el
+    // dato compartido una vez cada 4096 accesos: rondas largas, donde los hilos escalan
+    std::vector<TrazaNucleo> trazasPrivadas(4);
+    std::uniform_int_distribution<int> distL1(0, 16383);
+    for (int nucleo = 0; nucleo < 4; ++nucleo) {
+        TrazaNucleo& traza = trazasPrivadas[nucleo];
+        for (int i = 0; i < 1000000; ++i) {
+            if (i % 4096 == 0) {
+                traza.direcciones.push_back(0x2000);
+                traza.tipos.push_back(TipoAcceso::ESCRITURA);
+            } else {
+                traza.direcciones.push_back((uint64_t(nucleo + 1) << 24) + distL1(gen));
+                traza.tipos.push_back(i % 8 == 0 ? TipoAcceso::ESCRITURA : TipoAcceso::LECTURA);
+            }
+        }
+    }
+    for (unsigned hilos : {1u, 2u, 4u}) {
+        tiempos.clear();
+        for (int m = 0; m < mediciones; ++m) {
+            SistemaCoherente sistema(4, {32768, 64, 8}, {1048576, 64, 16});
+            auto inicio = Reloj::now();
+            sistema.simular(trazasPrivadas, hilos);
+            double segundos = std::chrono::duration<double>(Reloj::now() - inicio).count();
+            tiempos.push_back(segundos);
+            aciertos = 0;
+            for (int nucleo = 0; nucleo < 4; ++nucleo) aciertos += sistema.getPrivada(nucleo).getAciertos();
+        }
+        imprimirResultado("coherencia datos privados 4 nucleos, " + std::to_string(hilos) + " hilos (" +
+                          std::to_string(nucleos) + " nucleos)", 4000000.0, tiempos, aciertos);
+    }
+
+    // 12. modelo de tiempo: la misma jerarquia con cache bloqueante y con mas MSHR
+    for (int mshr : {1, 4, 16}) {
+        ConfiguracionTiempo configuracionTiempo;
+        configuracionTiempo.numMSHR = mshr;
+        tiempos.clear();
+        muestras.clear();
+        EstadisticasTiempo tiempo;
+        for (int m = 0; m < mediciones; ++m) {
+            ModeloTiempo modelo({{32768, 64, 8}, {262144, 64, 16}}, PoliticaInclusion::NINE, configuracionTiempo);
+            Cronometro cronometro(muestras);
+            porTramos(cronometro, reutilizacion.size(), [&](std::size_t primera, std::size_t cantidad) {
+                modelo.accederLote(reutilizacion.data() + primera, nullptr, cantidad);
+            });
+            tiempos.push_back(cronometro.terminar());
+            tiempo = modelo.getEstadisticas();
+            aciertos = modelo.getJerarquia().getNivel(0).getAciertos();
+        }
+        imprimirResultado(std::string("tiempo 32K/256K, ") + std::to_string(mshr) + " MSHR",
+                          static_cast<double>(reutilizacion.size()), tiempos, aciertos, muestras);
+        std::cout << "  AMAT=" << tiempo.amat() << " ciclos=" << tiempo.ciclos << " MLP=" << tiempo.mlp()
+                  << " parada=" << tiempo.ciclosParada << " fusionados=" << tiempo.fallosFusionados << "\n";
+    }
+
+    // 13. TLB: accesos aleatorios sobre 1 GiB con paginas de 4K, 2M y 1G
+    std::vector<uint64_t> dispersos(tamanoTraza / 4);
+    for (auto& direccion : dispersos) {
+        direccion = (uint64_t(1) << 32) + (static_cast<uint64_t>(gen()) % (uint64_t(1) << 30));
+    }
+    for (TamanoPagina tamano : {TamanoPagina::PAGINA_4K, TamanoPagina::PAGINA_2M, TamanoPagina::PAGINA_1G}) {
+        ConfiguracionTlb configuracionTlb;
+        configuracionTlb.paginaPorDefecto = tamano;
+        tiempos.clear();
+        muestras.clear();
+        EstadisticasTlb traduccion;
+        for (int m = 0; m < mediciones; ++m) {
+            Tlb tlb(configuracionTlb);
+            Cache cache(262144, 64, 8);
+            aciertos = 0;
+            Cronometro cronometro(muestras);
+            porTramos(cronometro, dispersos.size(), [&](std::size_t primera, std::size_t cantidad) {
+                for (std::size_t i = primera; i < primera + cantidad; ++i) {
+                    if (tlb.acceder(dispersos[i], cache)) ++aciertos;
+                }
+            });
+            tiempos.push_back(cronometro.terminar());
+            traduccion = tlb.getEstadisticas();
+        }
+        imprimirResultado(std::string("TLB paginas de ") + nombreTamanoPagina(tamano) + ", cache 256K",
+                          static_cast<double>(dispersos.size()), tiempos, aciertos, muestras);
+        std::cout << "  fallos L1 TLB=" << traduccion.tasaFallosL1() * 100 << "% L2 TLB="
+                  << traduccion.tasaFallosL2() * 100 << "% lecturas de tabla=" << traduccion.referenciasRecorrido
+                  << " que fallan=" << traduccion.referenciasRecorrido - traduccion.aciertosRecorrido << "\n";
+    }
+
+    // 14. patrones basicos sobre 32K/64B/8 vias, con acceder y con accederConPrefetch
+    const std::size_t accesosPatron = 4000000;
+    std::vector<std::pair<std::string, std::vector<uint64_t>>> patrones = {
+        {"secuencial", {}}, {"stride 4160B", {}}, {"aleatorio", {}}, {"persecucion de punteros", {}}
+    };
+    // persecucion de punteros: un ciclo aleatorio sobre nodos de 64 bytes
+    std::vector<uint32_t> siguienteNodo(1 << 20);
+    for (uint32_t nodo = 0; nodo < siguienteNodo.size(); ++nodo) siguienteNodo[nodo] = nodo;
+    for (std::size_t i = siguienteNodo.size() - 1; i > 0; --i) {
+        std::swap(siguienteNodo[i], siguienteNodo[std::uniform_int_distribution<std::size_t>(0, i - 1)(gen)]);
+    }
+    uint32_t nodo = 0;
+    for (std::size_t i = 0; i < accesosPatron; ++i) {
+        patrones[0].second.push_back(i * 8);
+        patrones[1].second.push_back(i * 4160);
+        patrones[2].second.push_back(aleatoria[i]);
+        patrones[3].second.push_back(static_cast<uint64_t>(nodo) * 64);
+        nodo = siguienteNodo[nodo];
+    }
+    for (const auto& [patron, traza] : patrones) {
+        medirTraza("patron " + patron + " 32K/64B/8 vias", traza, 1, 32768, 64, 8);
+        ConfiguracionPrefetch configuracion;
+        configuracion.tipo = TipoPrefetcher::STRIDE_PC;
+        configuracion.distancia = 4;
+        tiempos.clear();
+        muestras.clear();
+        for (int m = 0; m < mediciones; ++m) {
+            Cache cache(32768, 64, 8);
+            cache.configurarPrefetch(configuracion);
+            Cronometro cronometro(muestras);
+            porTramos(cronometro, traza.size(), [&](std::size_t primera, std::size_t cantidad) {
+                for (std::size_t i = primera; i < primera + cantidad; ++i) {
+                    cache.accederConPrefetch(traza[i], 0x402000);
+                }
+            });
+            tiempos.push_back(cronometro.terminar());
+            aciertos = cache.getAciertos();
+        }
+        imprimirResultado("patron " + patron + " 32K/64B/8 vias, prefetch stride",
+                          static_cast<double>(traza.size()), tiempos, aciertos, muestras);
+    }
+
+    // 15. generacion de trazas (direcciones por segundo)
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        std::vector<uint64_t> secuencia = GeneradorDatos::generarSecuenciaLineal(0, accesosPatron * 64, 64);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = secuencia.size();
+    }
+    imprimirResultado("generador lineal", static_cast<double>(accesosPatron), tiempos, aciertos);
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        std::vector<uint64_t> secuencia = GeneradorDatos::generarSecuenciaAleatoria(accesosPatron, 0, (1 << 30) - 1);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = secuencia.size();
+    }
+    imprimirResultado("generador aleatorio", static_cast<double>(accesosPatron), tiempos, aciertos);
+    // generador optimizado de una LLC de 16M con un hilo y con 4 (fijo, aunque la maquina
+    // tenga menos nucleos); la secuencia con varios hilos debe ser identica a la de uno
+    std::vector<uint64_t> optimizadaSerie;
+    for (unsigned hilos : {1u, 4u}) {
+        tiempos.clear();
+        std::size_t generadas = 0;
+        for (int m = 0; m < mediciones; ++m) {
+            auto inicio = Reloj::now();
+            std::vector<uint64_t> secuencia = GeneradorDatos::generarSecuenciaOptimizada(
+                16 << 20, 64, 16, 0, GeneradorDatos::SEMILLA_POR_DEFECTO, hilos);
+            tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+            generadas = secuencia.size();
+            aciertos = generadas;
+            if (hilos == 1) {
+                optimizadaSerie = std::move(secuencia);
+                continue;
+            }
+            // posiciones que difieren de la secuencia de un hilo
+            uint64_t distintas = 0;
+            for (std::size_t i = 0; i < std::min(secuencia.size(), optimizadaSerie.size()); ++i) {
+                if (secuencia[i] != optimizadaSerie[i]) ++distintas;
+            }
+            const std::string descripcion = "generador optimizado " + std::to_string(hilos) + " hilos";
+            comprobarIguales(descripcion + ", longitud frente a 1 hilo", secuencia.size(), optimizadaSerie.size());
+            comprobarIguales(descripcion + ", posiciones distintas de 1 hilo", distintas, 0);
+        }
+        imprimirResultado(hilos == 1 ? "generador optimizado 1 hilo"
+                                     : "generador optimizado " + std::to_string(hilos) + " hilos",
+                          static_cast<double>(generadas), tiempos, aciertos);
+    }
+    optimizadaSerie = std::vector<uint64_t>();
+
+    // 16. carga de un modelo OBJ (vertices por segundo)
+    const std::string rutaModelo = "benchmark_cache.obj";
+    const int verticesModelo = 500000;
+    std::uniform_real_distribution<float> coordenada(-10.0f, 10.0f);
+    {
+        std::ofstream modelo(rutaModelo);
+        for (int i = 0; i < verticesModelo; ++i) {
+            modelo << "v " << coordenada(gen) << " " << coordenada(gen) << " " << coordenada(gen) << "\n";
+        }
+        for (int i = 1; i + 2 <= verticesModelo; i += 3) {
+            modelo << "f " << i << " " << i + 1 << " " << i + 2 << "\n";
+        }
+    }
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        std::vector<Vertice> cargados = LectorModelos3D::cargarModeloOBJ(rutaModelo);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = cargados.size();
+    }
+    imprimirResultado("carga OBJ", static_cast<double>(verticesModelo), tiempos, aciertos);
+    // malla completa con caras, en paralelo (aciertos = triangulos; los MB/s se imprimen aparte)
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        MallaIndexada malla = LectorModelos3D::cargarMallaOBJ(rutaModelo);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = malla.numTriangulos();
+    }
+    std::ifstream tamanoModelo(rutaModelo, std::ios::binary | std::ios::ate);
+    const double megabytesModelo = static_cast<double>(tamanoModelo.tellg()) / 1e6;
+    tamanoModelo.close();
+    imprimirResultado("carga OBJ malla indexada", static_cast<double>(verticesModelo), tiempos, aciertos);
+    std::sort(tiempos.begin(), tiempos.end());
+    std::cout << "  " << megabytesModelo / tiempos[tiempos.size() / 2] << " MB/s\n";
+    // misma malla desde la cache binaria proyectada (la primera apertura la genera)
+    const std::string rutaMalla = rutaMallaBinaria(rutaModelo);
+    std::remove(rutaMalla.c_str());
+    LectorModelos3D::abrirMallaOBJ(rutaModelo);
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        MallaProyectada malla = LectorModelos3D::abrirMallaOBJ(rutaModelo);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = malla.estaProyectada() ? malla.getNumTriangulos() : 0;
+    }
+    std::remove(rutaMalla.c_str());
+    std::remove(rutaModelo.c_str());
+    imprimirResultado("carga malla binaria", static_cast<double>(verticesModelo), tiempos, aciertos);
+
+    // nube de puntos en segundo plano: carga completa y espera hasta el primer bloque
+    const std::string rutaNube = "benchmark_cache.xyz";
+    {
+        std::ofstream nube(rutaNube);
+        for (int i = 0; i < verticesModelo; ++i) {
+            nube << coordenada(gen) << " " << coordenada(gen) << " " << coordenada(gen) << "\n";
+        }
+    }
+    // recoge bloques hasta que el cargador esta al dia; devuelve los ms hasta el primero
+    auto recogerNube = [&](CargadorNubePuntos& cargador, const Reloj::time_point& inicio) {
+        BloquePuntos bloque;
+        double primero = 0.0;
+        aciertos = 0;
+        while (true) {
+            if (!cargador.siguienteBloque(bloque)) {
+                if (cargador.estaAlDia()) return primero;
+                std::this_thread::yield();
+                continue;
+            }
+            if (aciertos == 0) primero = std::chrono::duration<double, std::milli>(Reloj::now() - inicio).count();
+            aciertos += bloque.puntos.size();
+        }
+    };
+    std::vector<double> primeros;
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        CargadorNubePuntos cargador(rutaNube);
+        primeros.push_back(recogerNube(cargador, inicio));
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+    }
+    imprimirResultado("carga nube en flujo", static_cast<double>(verticesModelo), tiempos, aciertos);
+    std::sort(primeros.begin(), primeros.end());
+    std::cout << "  primer bloque " << primeros[primeros.size() / 2] << " ms\n";
+    // indice espacial: construccion y celdas a menos de 5 del origen (de una caja de 20 de lado)
+    const std::string rutaIndice = rutaIndiceNube(rutaNube);
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        construirIndiceNube(rutaNube, rutaIndice);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+    }
+    imprimirResultado("indice nube", static_cast<double>(verticesModelo), tiempos, verticesModelo);
+    ConfiguracionNube configuracionNube;
+    configuracionNube.usarIndice = true;
+    configuracionNube.radio = 5.0f;
+    primeros.clear();
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        CargadorNubePuntos cargador(rutaNube, configuracionNube);
+        primeros.push_back(recogerNube(cargador, inicio));
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+    }
+    std::remove(rutaIndice.c_str());
+    std::remove(rutaNube.c_str());
+    imprimirResultado("carga nube con indice", static_cast<double>(aciertos), tiempos, aciertos);
+    std::sort(primeros.begin(), primeros.end());
+    std::cout << "  primer bloque " << primeros[primeros.size() / 2] << " ms\n";
+
+    // 17. transformacion y proyeccion de vertices del renderizador
+    std::vector<Vertice> vertices(1000000);
+    for (Vertice& v : vertices) {
+        v = Vertice{coordenada(gen), coordenada(gen), coordenada(gen)};
+    }
+    Camara camara;
+    camara.rotX = 0.3f;
+    camara.rotY = 0.7f;
+    std::vector<PuntoProyectado> proyectados;
+    tiempos.clear();
+    for (int m = 0; m < mediciones; ++m) {
+        auto inicio = Reloj::now();
+        Proyeccion::proyectarVertices(vertices, camara, proyectados);
+        tiempos.push_back(std::chrono::duration<double>(Reloj::now() - inicio).count());
+        aciertos = 0;
+        for (const PuntoProyectado& p : proyectados) {
+            if (p.x != Proyeccion::FUERA_DE_PANTALLA) ++aciertos;
+        }
+    }
+    imprimirResultado("proyeccion de vertices", static_cast<double>(vertices.size()), tiempos, aciertos);
+
+    // 18. cache dinamica frente a CacheFija con la misma geometria, sobre la traza de
+    // reutilizacion con escrituras: mismos aciertos, fallos y bloques devueltos
+    const std::pair<int, int> geometriasFijas[] = {{32768, 8}, {262144, 16}};
+    for (const auto& [tamanoFijo, viasFijas] : geometriasFijas) {
+        for (PoliticaReemplazo politica : {PoliticaReemplazo::LRU, PoliticaReemplazo::SRRIP}) {
+            const std::string geometria = std::to_string(tamanoFijo / 1024) + "K/64B/" +
+                                          std::to_string(viasFijas) + " vias " + nombrePoliticaReemplazo(politica);
+            // contadores de la ultima medicion de cada variante: [0] Cache, [1] CacheFija
+            uint64_t aciertosVariante[2] = {};
+            uint64_t fallosVariante[2] = {};
+            uint64_t devueltosVariante[2] = {};
+            for (int fija = 0; fija < 2; ++fija) {
+                tiempos.clear();
+                muestras.clear();
+                for (int m = 0; m < mediciones; ++m) {
+                    conCacheEspecializada(tamanoFijo, 64, viasFijas, politica, [&](auto& cache) {
+                        Cronometro cronometro(muestras);
+                        porTramos(cronometro, reutilizacion.size(), [&](std::size_t primera, std::size_t cantidad) {
+                            cache.accederLote(reutilizacion.data() + primera, tipos.data() + primera, cantidad);
+                        });
+                        tiempos.push_back(cronometro.terminar());
+                        aciertosVariante[fija] = cache.getAciertos();
+                        fallosVariante[fija] = cache.getFallos();
+                        devueltosVariante[fija] = cache.getTrafico().bloquesDevueltos;
+                    }, fija == 1);
+                }
+                imprimirResultado(std::string(fija == 1 ? "CacheFija " : "dinamica ") + geometria,
+                                  static_cast<double>(reutilizacion.size()), tiempos, aciertosVariante[fija], muestras);
+            }
+            comprobarIguales("CacheFija " + geometria + ", aciertos frente a Cache", aciertosVariante[1],
+                             aciertosVariante[0]);
+            comprobarIguales("CacheFija " + geometria + ", fallos frente a Cache", fallosVariante[1],
+                             fallosVariante[0]);
+            comprobarIguales("CacheFija " + geometria + ", bloques devueltos frente a Cache", devueltosVariante[1],
+                             devueltosVariante[0]);
+        }
+    }
+
+    // 19. muestreo de conjuntos en una cache de ultimo nivel (1 de cada 32 conjuntos); la tasa
+    // de la simulacion completa debe caer dentro del intervalo de confianza de la estimacion
+    medirTraza("LLC 2M/64B/16 vias completa", aleatoria, 1, 2097152, 64, 16, PoliticaReemplazo::LRU, true);
+    tiempos.clear();
+    muestras.clear();
+    EstimacionMuestreo estimacion;
+    for (int m = 0; m < mediciones; ++m) {
+        Cache cache(2097152, 64, 16);
+        cache.configurarMuestreo(32);
+        Cronometro cronometro(muestras);
+        porTramos(cronometro, aleatoria.size(), [&](std::size_t primera, std::size_t cantidad) {
+            cache.accederLote(aleatoria.data() + primera, cantidad);
+        });
+        tiempos.push_back(cronometro.terminar());
+        estimacion = cache.estimarMuestreo();
+        aciertos = estimacion.aciertosEstimados;
+    }
+    imprimirResultado("LLC 2M/64B/16 vias muestreo 1/32 (aciertos estimados)",
+                      static_cast<double>(aleatoria.size()), tiempos, aciertos, muestras);
+    comprobarEnIntervalo("LLC 2M/64B/16 vias, tasa completa frente al IC95 del muestreo 1/32",
+                         100.0 * static_cast<double>(aciertosDe("LLC 2M/64B/16 vias completa")) /
+                             static_cast<double>(aleatoria.size()),
+                         estimacion.tasaAciertos, estimacion.margen);
+
+    // 20. funciones de indice: 1024 conjuntos (mascara, xor) y 1536 conjuntos, como una LLC
+    // de 12 porciones (modulo, primo, sesgada), con accesos aleatorios y con un paso de 64 KiB
+    std::vector<uint64_t> pasoPatologico(accesosPatron);
+    for (std::size_t i = 0; i < accesosPatron; ++i) {
+        pasoPatologico[i] = (i % 4096) * 65536;
+    }
+    const std::pair<FuncionIndice, int> indices[] = {
+        {FuncionIndice::MASCARA, 1024}, {FuncionIndice::XOR, 1024}, {FuncionIndice::MODULO, 1536},
+        {FuncionIndice::PRIMO, 1536}, {FuncionIndice::SESGADA, 1536}};
+    for (const auto& [indice, conjuntos] : indices) {
+        for (const auto& [patron, traza] : {std::make_pair("aleatoria", &aleatoria),
+                                           std::make_pair("paso 64K", &pasoPatologico)}) {
+            tiempos.clear();
+            muestras.clear();
+            for (int m = 0; m < mediciones; ++m) {
+                Cache cache(conjuntos * 64 * 8, 64, 8, PoliticaReemplazo::LRU, indice);
+                Cronometro cronometro(muestras);
+                porTramos(cronometro, traza->size(), [&](std::size_t primera, std::size_t cantidad) {
+                    cache.accederLote(traza->data() + primera, cantidad);
+                });
+                tiempos.push_back(cronometro.terminar());
+                aciertos = cache.getAciertos();
+            }
+            imprimirResultado(std::string("indice ") + nombreFuncionIndice(indice) + " " + std::to_string(conjuntos) +
+                              " conjuntos/8 vias " + patron, static_cast<double>(traza->size()), tiempos, aciertos,
+                              muestras);
+        }
+    }
+
+    // 21. importacion en flujo de trazas DineroIV, lackey y ChampSim hacia una cache de 32K
+    // los tres archivos llevan la misma secuencia de accesos (una instruccion, tres lecturas
+    // y una escritura), asi que los accesos por segundo son comparables; los MB/s de lectura
+    // se imprimen aparte porque cada formato ocupa distinto
+    const std::pair<FormatoTrazaExterna, std::string> trazasExternas[] = {
+        {FormatoTrazaExterna::DINERO, "benchmark_cache.din"},
+        {FormatoTrazaExterna::LACKEY, "benchmark_cache.lackey"},
+        {FormatoTrazaExterna::CHAMPSIM, "benchmark_cache.champsim"}};
+    {
+        std::ofstream dinero(trazasExternas[0].second, std::ios::binary);
+        std::ofstream lackey(trazasExternas[1].second, std::ios::binary);
+        std::ofstream champsim(trazasExternas[2].second, std::ios::binary);
+        char texto[64];
+        uint64_t registro[8] = {};
+        for (std::size_t i = 0; i < accesosPatron; ++i) {
+            // desplazada un bloque: ChampSim usa la direccion cero para los huecos sin acceso
+            const uint64_t direccion = aleatoria[i] + 64;
+            const bool escritura = i % 4 == 3;
+            // busqueda de instruccion cada cuatro accesos a datos
+            if (i % 4 == 0) {
+                const unsigned long long ip = 0x400000ull + i;
+                dinero.write(texto, std::snprintf(texto, sizeof(texto), "2 %llx\n", ip));
+                lackey.write(texto, std::snprintf(texto, sizeof(texto), "I  %08llx,4\n", ip));
+                std::fill(std::begin(registro), std::end(registro), 0);
+                registro[0] = ip;
+            }
+            dinero.write(texto, std::snprintf(texto, sizeof(texto), "%d %llx 8\n", escritura ? 1 : 0,
+                                              static_cast<unsigned long long>(direccion)));
+            lackey.write(texto, std::snprintf(texto, sizeof(texto), " %c %08llx,8\n", escritura ? 'S' : 'L',
+                                              static_cast<unsigned long long>(direccion)));
+            // un registro de ChampSim por instruccion: sus lecturas van en los origenes y la
+            // escritura en el primer destino (el importador da la ip, los origenes y los destinos)
+            if (escritura) registro[2] = direccion;
+            else registro[4 + i % 4] = direccion;
+            if (escritura || i + 1 == accesosPatron) {
+                champsim.write(reinterpret_cast<const char*>(registro), sizeof(registro));
+            }
+        }
+    }
+    for (const auto& [formato, ruta] : trazasExternas) {
+        tiempos.clear();
+        muestras.clear();
+        uint64_t registros = 0;
+        uint64_t bytes = 0;
+        for (int m = 0; m < mediciones; ++m) {
+            Cache cache(32768, 64, 8);
+            ImportadorTraza importador(ruta, formato);
+            TramoTraza tramo;
+            Cronometro cronometro(muestras);
+            while (importador.siguienteTramo(tramo)) {
+                cache.accederLote(tramo.direcciones.data(), tramo.tipos.data(), tramo.direcciones.size());
+                cronometro.avanzar(tramo.direcciones.size());
+            }
+            tiempos.push_back(cronometro.terminar());
+            aciertos = cache.getAciertos();
+            registros = importador.getRegistros();
+            bytes = importador.getBytesLeidos();
+        }
+        std::remove(ruta.c_str());
+        imprimirResultado(std::string("importar traza ") + nombreFormatoTrazaExterna(formato) + " 32K/64B/8 vias",
+                          static_cast<double>(registros), tiempos, aciertos, muestras);
+        std::sort(tiempos.begin(), tiempos.end());
+        std::cout << "  " << registros << " accesos, " << bytes / 1e6 / tiempos[tiempos.size() / 2] << " MB/s\n";
+    }
+
+    // 22. cargas de trabajo perezosas generadas por tramos directamente hacia una cache de 32K
+    // (generacion y simulacion juntas, sin guardar la traza)
+    std::vector<std::pair<std::string, std::unique_ptr<CargaTrabajo>>> cargas;
+    cargas.emplace_back("producto de matrices 160x160", std::make_unique<MultiplicacionMatrices>(160));
+    cargas.emplace_back("producto de matrices 160x160 teselas 16", std::make_unique<MultiplicacionMatrices>(160, 16));
+    cargas.emplace_back("estencil 2D 1024x1024", std::make_unique<Estencil>(1024, 1024));
+    cargas.emplace_back("estencil 3D 96x96x96", std::make_unique<Estencil>(96, 96, 96));
+    cargas.emplace_back("persecucion de punteros 64 MiB", std::make_unique<PersecucionPunteros>(1 << 20, accesosPatron));
+    cargas.emplace_back("sondeo hash 1M entradas carga 0.5", std::make_unique<SondeoHash>(1 << 20, 1000000));
+    cargas.emplace_back("copia en flujo 32 MiB", std::make_unique<CopiaFlujo>(32 << 20));
+    for (auto& [nombre, carga] : cargas) {
+        tiempos.clear();
+        muestras.clear();
+        for (int m = 0; m < mediciones; ++m) {
+            Cache cache(32768, 64, 8);
+            carga->reiniciar();
+            Cronometro cronometro(muestras);
+            while (carga->siguienteTramo()) {
+                cache.accederLote(carga->direcciones(), carga->tipos(), carga->cantidad());
+                cronometro.avanzar(carga->cantidad());
+            }
+            tiempos.push_back(cronometro.terminar());
+            aciertos = cache.getAciertos();
+        }
+        imprimirResultado("carga " + nombre + " 32K/64B/8 vias", static_cast<double>(carga->getGenerados()),
+                          tiempos, aciertos, muestras);
+    }
+
+    // informe JSON para comparar ejecuciones entre compilaciones
+    if (!rutaJson.empty()) {
+        if (!escribirJson(rutaJson, nucleos)) {
+            std::cerr << "Error: no se pudo escribir " << rutaJson << "\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << "Resultados JSON en " << rutaJson << "\n";
+    }
+
+    if (comprobacionesFallidas > 0) {
+        std::cerr << "Error: " << comprobacionesFallidas << " comprobaciones de equivalencia fallidas\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -8,22 +8,78 @@
 #include <algorithm>
 // para tipos enteros de tamaño fijo
 #include <cstdint>
+// para la simulacion repartida entre hilos
+#include <thread>
+// raiz cuadrada del intervalo de confianza del muestreo
+#include <cmath>
+// barrera entre rondas de la simulacion paralela
+#include "Common/BarreraHilos.hpp"
+// nucleo del acceso comun con CacheFija
+#include "NucleoCache.hpp"
+
+// comprueba si un valor positivo es potencia de dos
+static bool esPotenciaDeDos(int valor) {
+    return valor > 0 && (valor & (valor - 1)) == 0;
+}
+
+// calcula log2 de una potencia de dos
+static uint32_t log2Entero(uint32_t valor) {
+    uint32_t resultado = 0;
+    while (valor > 1) {
+        valor >>= 1;
+        ++resultado;
+    }
+    return resultado;
+}
+
+// deja cada conjunto en el estado inicial de la politica
+template <typename Politica>
+void Cache::inicializarEstados() {
+    for (int conjunto = 0; conjunto < numConjuntos; ++conjunto) {
+        EstadoReemplazo estado = estadoDe(conjunto, geometria());
+        Politica::inicializarConjunto(estado, static_cast<uint32_t>(conjunto));
+    }
+}
 
 // constructor de la clase Cache
-Cache::Cache(int tamano, int tamanoBloque, int asociatividad) :
+Cache::Cache(int tamano, int tamanoBloque, int asociatividad, PoliticaReemplazo politica, FuncionIndice indice) :
     // inicializa tamaño total de cache
     tamanoCache(tamano), 
     // inicializa tamaño de bloque
     tamanoBloque(tamanoBloque), 
     // inicializa nivel de asociatividad
     asociatividad(asociatividad),
+    // guarda la politica de reemplazo y la funcion de indice
+    politica(politica), funcionIndice(indice), relojSesgado(0),
     // inicializa contadores a cero
-    aciertos(0), fallos(0) {
+    aciertos(0), fallos(0),
+    // write-back con asignacion por defecto
+    escritura(PoliticaEscritura::WRITE_BACK), asignarEnEscritura(true), bytesPorEscritura(4),
+    // reloj del prefetch
+    instante(0), aciertoEnPrefetch(false),
+    // sin muestreo de conjuntos
+    mascaraMuestreo(0), accesosDescartados(0) {
     
     // valida que los parametros sean positivos
     if (tamano <= 0 || tamanoBloque <= 0 || asociatividad <= 0) {
         throw std::invalid_argument("Parámetros deben ser positivos");
     }
+    // el mapa de validez de cada conjunto tiene un bit por via
+    if (asociatividad > MAX_VIAS) {
+        throw std::invalid_argument("Asociatividad máxima es 64 vías");
+    }
+    // el desplazamiento de bloque requiere potencia de dos
+    if (!esPotenciaDeDos(tamanoBloque)) {
+        throw std::invalid_argument("Tamaño de bloque debe ser potencia de dos");
+    }
+    // el arbol binario del pseudo-lru necesita un numero de vias potencia de dos
+    if (politica == PoliticaReemplazo::PLRU_ARBOL && !esPotenciaDeDos(asociatividad)) {
+        throw std::invalid_argument("PLRU de árbol requiere asociatividad potencia de dos");
+    }
+    // cada via de la cache sesgada mira un conjunto distinto: el reemplazo es lru por linea
+    if (indice == FuncionIndice::SESGADA && politica != PoliticaReemplazo::LRU) {
+        throw std::invalid_argument("La indexación sesgada solo admite LRU");
+    }
 
     // calcula el numero de conjuntos (total bloques / asociatividad)
     numConjuntos = tamanoCache / (tamanoBloque * asociatividad);
@@ -31,114 +87,581 @@ Cache::Cache(int tamano, int tamanoBloque, int asociatividad) :
     if (numConjuntos == 0) {
         throw std::invalid_argument("Número de conjuntos no puede ser cero");
     }
+    // la seleccion de conjunto por mascara (y el plegado xor) requiere potencia de dos
+    const bool conMascara = indice == FuncionIndice::MASCARA || indice == FuncionIndice::XOR;
+    if (conMascara && !esPotenciaDeDos(numConjuntos)) {
+        throw std::invalid_argument("Número de conjuntos debe ser potencia de dos");
+    }
+
+    // precalcula desplazamientos y mascaras de la geometria
+    desplazamientoBloque = log2Entero(static_cast<uint32_t>(tamanoBloque));
+    bitsConjunto = log2Entero(static_cast<uint32_t>(numConjuntos));
+    mascaraConjunto = static_cast<uint32_t>(numConjuntos - 1);
+    // solo la mascara deja fuera de la etiqueta los bits del conjunto; las demas funciones
+    // guardan el numero de bloque completo para poder reconstruir la direccion
+    desplazamientoEtiqueta = desplazamientoBloque + (indice == FuncionIndice::MASCARA ? bitsConjunto : 0);
+    // divisor del resto rapido (los conjuntos por encima del primo quedan sin usar)
+    const uint32_t divisor = static_cast<uint32_t>(numConjuntos);
+    moduloConjuntos = ModuloRapido(indice == FuncionIndice::PRIMO ? primoMenorOIgual(divisor) : divisor);
+    mascaraVias = asociatividad == MAX_VIAS ? ~uint64_t(0) : (uint64_t(1) << asociatividad) - 1;
 
-    // redimensiona la estructura de cache
-    cache.resize(numConjuntos, std::vector<LineaCache>(asociatividad));
+    // reserva el almacenamiento plano de todas las lineas
+    const std::size_t totalLineas = static_cast<std::size_t>(numConjuntos) * asociatividad;
+    etiquetas.assign(totalLineas + RELLENO_ETIQUETAS, 0);
+    estadoVias.assign(totalLineas, 0);
+    validos.assign(numConjuntos, 0);
+    modificados.assign(numConjuntos, 0);
+    estadoConjuntos.assign(numConjuntos, 0);
     // inicializa contadores de aciertos por conjunto
     aciertosPorConjunto.resize(numConjuntos, 0);
     // inicializa contadores de fallos por conjunto
     fallosPorConjunto.resize(numConjuntos, 0);
+    // ninguna linea traida por prefetch
+    prefetchados.assign(numConjuntos, 0);
+
+    // estado inicial propio de la politica (relojes, semillas...)
+    conPolitica([this](auto p) { inicializarEstados<decltype(p)>(); });
 }
 
-// actualiza una linea como mas recientemente usada (mru)
-void Cache::actualizarComoMRU(int conjunto, int via) {
-    // verifica indices validos
-    if (conjunto < 0 || conjunto >= numConjuntos || via < 0 || via >= asociatividad) return;
-    
-    // decrementa contadores de todas las lineas validas
-    for (auto& linea : cache[conjunto]) {
-        if (linea.valido && linea.contadorAccesos > 0) {
-            linea.contadorAccesos--;
-        }
-    }
-    // marca la linea actual como mru
-    cache[conjunto][via].contadorAccesos = asociatividad;
+// acceso a memoria con la politica de reemplazo insertada en linea
+template <typename Politica, bool ContarEstadisticas>
+bool Cache::accederCon(uint64_t direccion, Desalojo& desalojo) {
+    // conjunto y etiqueta mediante desplazamientos y mascara precalculados
+    const uint32_t conjunto = conjuntoDe(direccion);
+    const uint64_t etiqueta = direccion >> desplazamientoEtiqueta;
+    return accederConjunto<Politica, ContarEstadisticas>(conjunto, etiqueta, desalojo, geometria());
 }
 
-// encuentra la linea menos recientemente usada en un conjunto
-std::size_t Cache::encontrarLRU(int conjunto) const {
-    // verifica indice valido
-    if (conjunto < 0 || conjunto >= numConjuntos) return 0;
-    
-    // inicializa con la primera via
-    std::size_t viaLRU = 0;
-    int minAccesos = cache[conjunto][0].contadorAccesos;
-    
-    // busca la via con menor contador de accesos
-    for (std::size_t via = 1; via < cache[conjunto].size(); ++via) {
-        if (cache[conjunto][via].contadorAccesos < minAccesos) {
-            minAccesos = cache[conjunto][via].contadorAccesos;
-            viaLRU = via;
+// busca el bloque en la linea candidata de cada via de la cache sesgada
+bool Cache::buscarSesgado(uint64_t bloque, uint32_t& conjunto, uint32_t& via) const {
+    for (uint32_t v = 0; v < static_cast<uint32_t>(asociatividad); ++v) {
+        const uint32_t c = conjuntoSesgado(bloque, v, static_cast<uint32_t>(numConjuntos));
+        if (((validos[c] >> v) & 1) != 0 && etiquetas[static_cast<std::size_t>(c) * asociatividad + v] == bloque) {
+            conjunto = c;
+            via = v;
+            return true;
         }
     }
-    return viaLRU;
+    return false;
 }
 
-// simula un acceso a memoria
-bool Cache::acceder(int direccion) {
-    // verifica direccion valida
-    if (direccion < 0) return false;
-    
-    // calcula conjunto mediante hash simple
-    uint32_t conjunto = (direccion / tamanoBloque) & (numConjuntos - 1);
-    // verifica conjunto valido
-    if (conjunto >= cache.size()) return false;
-    
-    // calcula etiqueta de direccion
-    uint32_t etiqueta = direccion / (tamanoBloque * numConjuntos);
-    
-    // busca la etiqueta en todas las vias del conjunto
-    for (std::size_t via = 0; via < cache[conjunto].size(); ++via) {
-        if (cache[conjunto][via].valido && cache[conjunto][via].etiqueta == etiqueta) {
-            // actualiza contador y marca como mru
-            cache[conjunto][via].contadorAccesos++;
-            actualizarComoMRU(conjunto, via);
-            // incrementa contadores
+// acceso a la cache sesgada: el bloque solo puede estar en una linea por via
+// (conjunto distinto en cada una), la victima es la candidata libre o la de marca mas antigua
+template <bool ContarEstadisticas>
+bool Cache::accederSesgado(uint64_t bloque, Desalojo& desalojo, uint32_t& conjunto, uint32_t& via) {
+    if (buscarSesgado(bloque, conjunto, via)) {
+        estadoVias[static_cast<std::size_t>(conjunto) * asociatividad + via] = ++relojSesgado;
+        if (ContarEstadisticas) {
             aciertos++;
             aciertosPorConjunto[conjunto]++;
-            return true;
+            if (clasificador.activo()) clasificador.observar(bloque, true);
         }
+        return true;
     }
-    
-    // si no encontro, es fallo - busca victima lru
-    std::size_t viaVictima = encontrarLRU(conjunto);
-    if (viaVictima >= cache[conjunto].size()) viaVictima = 0;
-    
+
+    // elige la victima entre las lineas candidatas
+    uint64_t marcaMinima = UINT64_MAX;
+    for (uint32_t v = 0; v < static_cast<uint32_t>(asociatividad); ++v) {
+        const uint32_t c = conjuntoSesgado(bloque, v, static_cast<uint32_t>(numConjuntos));
+        if (((validos[c] >> v) & 1) == 0) {
+            conjunto = c;
+            via = v;
+            break;
+        }
+        const uint64_t marca = estadoVias[static_cast<std::size_t>(c) * asociatividad + v];
+        if (marca < marcaMinima) {
+            marcaMinima = marca;
+            conjunto = c;
+            via = v;
+        }
+    }
+
+    // informa del bloque expulsado (la etiqueta es el numero de bloque)
+    const std::size_t indice = static_cast<std::size_t>(conjunto) * asociatividad + via;
+    const uint64_t bitVictima = uint64_t(1) << via;
+    desalojo.valido = (validos[conjunto] & bitVictima) != 0;
+    desalojo.direccionBloque = etiquetas[indice] << desplazamientoBloque;
+    desalojo.modificado = (modificados[conjunto] & bitVictima) != 0;
+    modificados[conjunto] &= ~bitVictima;
+
     // reemplaza la linea victima
-    cache[conjunto][viaVictima].inicializar(etiqueta, true, false);
-    actualizarComoMRU(conjunto, viaVictima);
-    // incrementa contadores de fallos
-    fallos++;
-    fallosPorConjunto[conjunto]++;
+    etiquetas[indice] = bloque;
+    validos[conjunto] |= bitVictima;
+    estadoVias[indice] = ++relojSesgado;
+    if (ContarEstadisticas) {
+        fallos++;
+        fallosPorConjunto[conjunto]++;
+        trafico.bloquesLeidos++;
+        trafico.bloquesDevueltos += desalojo.modificado;
+        if (clasificador.activo()) clasificador.observar(bloque, false);
+    }
     return false;
 }
 
-// version con prefetching de acceder
-bool Cache::accederConPrefetch(int direccion) {
-    // realiza acceso normal
-    bool acierto = acceder(direccion);
-    
-    // calcula direccion para prefetch (2 bloques adelante)
-    int stride = tamanoBloque * 2;
-    int prefetchAddr = direccion + stride;
-    // verifica que prefetch sea valido y este en mismo conjunto
-    if (prefetchAddr >= 0 && 
-        (prefetchAddr / (tamanoBloque * numConjuntos)) == (direccion / (tamanoBloque * numConjuntos))) {
-        acceder(prefetchAddr);
+// escritura en la cache sesgada, con la misma politica de escritura que escribirConjunto
+bool Cache::escribirSesgado(uint64_t bloque, Desalojo& desalojo) {
+    trafico.escrituras++;
+    uint32_t conjunto = 0, via = 0;
+
+    // fallo sin asignacion: la escritura pasa directa al nivel inferior
+    if (!asignarEnEscritura && !buscarSesgado(bloque, conjunto, via)) {
+        desalojo = Desalojo();
+        fallos++;
+        fallosPorConjunto[conjuntoDeBloque(bloque)]++;
+        trafico.fallosEscritura++;
+        trafico.escriturasDirectas++;
+        if (clasificador.activo()) clasificador.observar(bloque, false, false);
+        return false;
+    }
+
+    const bool acierto = accederSesgado<true>(bloque, desalojo, conjunto, via);
+    if (!acierto) trafico.fallosEscritura++;
+    if (escritura == PoliticaEscritura::WRITE_THROUGH) {
+        trafico.escriturasDirectas++;
+    } else {
+        modificados[conjunto] |= uint64_t(1) << via;
     }
-    
     return acierto;
 }
 
+// simula un acceso a memoria
+bool Cache::acceder(uint64_t direccion) {
+    return accederDemanda(direccion, TipoAcceso::LECTURA, geometria());
+}
+
+// simula un acceso de lectura o escritura
+bool Cache::acceder(uint64_t direccion, TipoAcceso tipo) {
+    return accederDemanda(direccion, tipo, geometria());
+}
+
+// simula un acceso de lectura o escritura informando del bloque expulsado
+bool Cache::acceder(uint64_t direccion, TipoAcceso tipo, Desalojo& desalojo) {
+    return accederGeometria(direccion, tipo, desalojo, geometria());
+}
+
+// simula un acceso a memoria informando del bloque expulsado
+bool Cache::acceder(uint64_t direccion, Desalojo& desalojo) {
+    return accederGeometria(direccion, TipoAcceso::LECTURA, desalojo, geometria());
+}
+
+// simula una secuencia de accesos con un solo despacho de politica
+std::size_t Cache::accederLote(const uint64_t* direcciones, std::size_t cantidad, uint8_t* resultados) {
+    return accederLote(direcciones, nullptr, cantidad, resultados);
+}
+
+// simula una secuencia de lecturas y escrituras con un solo despacho de politica
+std::size_t Cache::accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad,
+                               uint8_t* resultados) {
+    return accederLoteGeometria(direcciones, tipos, nullptr, cantidad, resultados, geometria());
+}
+
+// simula una secuencia de accesos con el pc de cada uno para el prefetcher
+std::size_t Cache::accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, const uint64_t* pcs,
+                               std::size_t cantidad, uint8_t* resultados) {
+    return accederLoteGeometria(direcciones, tipos, pcs, cantidad, resultados, geometria());
+}
+
+// direcciones que se reparten entre los hilos en cada ronda de la simulacion paralela
+constexpr std::size_t TAMANO_TRAMO_PARALELO = std::size_t(1) << 16;
+
+// simulacion paralela por tramos con doble buffer de cubetas:
+// en la ronda k cada hilo reparte su trozo del tramo k+1 en una cubeta por hilo
+// dueño y a la vez consume las cubetas que le tocan del tramo k; una barrera
+// separa las rondas. Los trozos se recorren en orden, asi que cada conjunto
+// recibe sus accesos en orden de programa
+template <typename Politica>
+std::size_t Cache::accederParaleloCon(const uint64_t* direcciones, std::size_t cantidad, unsigned hilos) {
+    const std::size_t numTramos = (cantidad + TAMANO_TRAMO_PARALELO - 1) / TAMANO_TRAMO_PARALELO;
+    // bits de conjunto: el dueño de un conjunto sale de un producto y un desplazamiento
+
+    // cubetas[buffer][productor * hilos + dueño] con las direcciones de cada dueño
+    std::vector<std::vector<uint64_t>> cubetas[2];
+    cubetas[0].resize(static_cast<std::size_t>(hilos) * hilos);
+    cubetas[1].resize(static_cast<std::size_t>(hilos) * hilos);
+    // aciertos y fallos de cada hilo, en lineas del anfitrion distintas
+    struct alignas(TAMANO_LINEA_ANFITRION) TotalesHilo {
+        std::size_t aciertos = 0;
+        std::size_t fallos = 0;
+        std::size_t devueltos = 0;
+    };
+    std::vector<TotalesHilo> totales(hilos);
+    BarreraHilos barrera(hilos);
+
+    // reparte el trozo del tramo que corresponde al hilo productor
+    auto repartir = [&](unsigned productor, std::size_t tramo, int buffer) {
+        const std::size_t inicioTramo = tramo * TAMANO_TRAMO_PARALELO;
+        const std::size_t n = std::min(TAMANO_TRAMO_PARALELO, cantidad - inicioTramo);
+        const std::size_t inicio = inicioTramo + n * productor / hilos;
+        const std::size_t fin = inicioTramo + n * (productor + 1) / hilos;
+        std::vector<uint64_t>* propias = &cubetas[buffer][static_cast<std::size_t>(productor) * hilos];
+        for (unsigned dueno = 0; dueno < hilos; ++dueno) propias[dueno].clear();
+        for (std::size_t i = inicio; i < fin; ++i) {
+            const uint64_t dir = direcciones[i];
+            const uint32_t conjunto = conjuntoDe(dir);
+            propias[(static_cast<uint64_t>(conjunto) * hilos) >> bitsConjunto].push_back(dir);
+        }
+    };
+
+    // aplica, en orden de productor, los accesos a los conjuntos del hilo dueño
+    auto consumir = [&](unsigned dueno, int buffer) {
+        TotalesHilo& total = totales[dueno];
+        const GeometriaVariable g = geometria();
+        Desalojo desalojo;
+        for (unsigned productor = 0; productor < hilos; ++productor) {
+            for (uint64_t dir : cubetas[buffer][static_cast<std::size_t>(productor) * hilos + dueno]) {
+                const uint32_t conjunto = conjuntoDe(dir);
+                // sin contar dentro del nucleo: los totales globales se suman al final
+                const bool acierto = accederConjunto<Politica, false>(conjunto, dir >> desplazamientoEtiqueta,
+                                                                       desalojo, g);
+                // los contadores por conjunto son exclusivos del hilo dueño
+                if (acierto) {
+                    aciertosPorConjunto[conjunto]++;
+                    total.aciertos++;
+                } else {
+                    fallosPorConjunto[conjunto]++;
+                    total.fallos++;
+                    // lineas modificadas por escrituras anteriores al lote
+                    total.devueltos += desalojo.modificado;
+                }
+            }
+        }
+    };
+
+    // cuerpo de cada hilo; el hilo llamador hace de hilo 0
+    auto trabajar = [&](unsigned hilo) {
+        repartir(hilo, 0, 0);
+        barrera.esperar();
+        for (std::size_t tramo = 0; tramo < numTramos; ++tramo) {
+            if (tramo + 1 < numTramos) repartir(hilo, tramo + 1, static_cast<int>((tramo + 1) & 1));
+            consumir(hilo, static_cast<int>(tramo & 1));
+            barrera.esperar();
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(hilos - 1);
+    for (unsigned hilo = 1; hilo < hilos; ++hilo) {
+        trabajadores.emplace_back(trabajar, hilo);
+    }
+    trabajar(0);
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+
+    // suma los totales de cada hilo a los contadores globales
+    std::size_t aciertosTraza = 0;
+    for (const TotalesHilo& total : totales) {
+        aciertos += total.aciertos;
+        fallos += total.fallos;
+        trafico.bloquesLeidos += total.fallos;
+        trafico.bloquesDevueltos += total.devueltos;
+        aciertosTraza += total.aciertos;
+    }
+    return aciertosTraza;
+}
+
+// simula una secuencia de accesos repartiendo los conjuntos entre hilos
+std::size_t Cache::accederParalelo(const uint64_t* direcciones, std::size_t cantidad, unsigned hilos) {
+    // por defecto un hilo por nucleo del anfitrion
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    // nunca mas hilos que conjuntos (cada hilo necesita al menos uno)
+    hilos = std::min(hilos, static_cast<unsigned>(numConjuntos));
+    // con un solo hilo no hay nada que repartir; el prefetcher ve todos los conjuntos
+    // a la vez y tampoco se puede repartir; lo mismo la cache en sombra del clasificador
+    // con muestreo el lote ya simula una fraccion de los accesos; el reparto por dueño
+    // necesita conjuntos potencia de dos y un conjunto por acceso
+    if (hilos == 1 || cantidad == 0 || prefetcher.activo() || clasificador.activo() || mascaraMuestreo != 0 ||
+        !esPotenciaDeDos(numConjuntos) || funcionIndice == FuncionIndice::SESGADA) {
+        return accederLote(direcciones, cantidad);
+    }
+
+    return conPolitica([&](auto p) { return accederParaleloCon<decltype(p)>(direcciones, cantidad, hilos); });
+}
+
+// coloca un bloque traido por la jerarquia sin contarlo como acceso
+bool Cache::insertar(uint64_t direccion, Desalojo& desalojo, bool modificado) {
+    desalojo = Desalojo();
+    uint32_t conjuntoSesgadoBloque = 0, viaSesgada = 0;
+    const bool presente = funcionIndice == FuncionIndice::SESGADA
+        ? accederSesgado<false>(direccion >> desplazamientoBloque, desalojo, conjuntoSesgadoBloque, viaSesgada)
+        : conPolitica([&](auto p) { return accederCon<decltype(p), false>(direccion, desalojo); });
+    // el bloque llega desde arriba: solo la linea modificada expulsada es trafico hacia abajo
+    trafico.bloquesDevueltos += desalojo.modificado;
+    if (modificado && escritura == PoliticaEscritura::WRITE_BACK) {
+        if (funcionIndice == FuncionIndice::SESGADA) {
+            modificados[conjuntoSesgadoBloque] |= uint64_t(1) << viaSesgada;
+        } else {
+            const uint32_t conjunto = conjuntoDe(direccion);
+            modificados[conjunto] |= buscarCoincidencias(conjunto, direccion >> desplazamientoEtiqueta);
+        }
+    } else if (modificado) {
+        // una cache write-through pasa la escritura devuelta directamente abajo
+        trafico.bloquesDevueltos++;
+    }
+    return presente;
+}
+
+// busca un bloque contando el acceso y lo retira si esta (caches exclusivas)
+bool Cache::extraer(uint64_t direccion, bool* modificado) {
+    const uint32_t conjunto = conjuntoDe(direccion);
+    const bool presente = invalidar(direccion, modificado);
+    if (clasificador.activo()) clasificador.observar(direccion >> desplazamientoBloque, presente);
+    if (!presente) {
+        fallos++;
+        fallosPorConjunto[conjunto]++;
+        return false;
+    }
+    aciertos++;
+    aciertosPorConjunto[conjunto]++;
+    return true;
+}
+
+// invalida un bloque presente (retro-invalidacion de caches inclusivas)
+bool Cache::invalidar(uint64_t direccion, bool* modificado) {
+    uint32_t conjunto = conjuntoDe(direccion);
+    uint64_t coincidencias = 0;
+    if (funcionIndice == FuncionIndice::SESGADA) {
+        uint32_t via = 0;
+        if (buscarSesgado(direccion >> desplazamientoBloque, conjunto, via)) coincidencias = uint64_t(1) << via;
+    } else {
+        coincidencias = buscarCoincidencias(conjunto, direccion >> desplazamientoEtiqueta);
+    }
+    // quien invalida recibe los datos modificados y decide donde escribirlos
+    if (modificado != nullptr) *modificado = (modificados[conjunto] & coincidencias) != 0;
+    modificados[conjunto] &= ~coincidencias;
+    // limpia el bit de validez; la via libre se reutiliza antes que cualquier victima
+    validos[conjunto] &= ~coincidencias;
+    prefetchados[conjunto] &= ~coincidencias;
+    return coincidencias != 0;
+}
+
+// consulta la presencia de un bloque sin efectos secundarios
+bool Cache::contiene(uint64_t direccion) const {
+    if (funcionIndice == FuncionIndice::SESGADA) {
+        uint32_t conjunto, via;
+        return buscarSesgado(direccion >> desplazamientoBloque, conjunto, via);
+    }
+    const uint32_t conjunto = conjuntoDe(direccion);
+    return buscarCoincidencias(conjunto, direccion >> desplazamientoEtiqueta) != 0;
+}
+
+// elige la politica de escritura
+void Cache::configurarEscritura(PoliticaEscritura politica, bool asignarEnEscritura, int bytesPorEscritura) {
+    if (bytesPorEscritura <= 0) {
+        throw std::invalid_argument("Bytes por escritura debe ser positivo");
+    }
+    escritura = politica;
+    this->asignarEnEscritura = asignarEnEscritura;
+    this->bytesPorEscritura = bytesPorEscritura;
+}
+
+// instala un prefetcher y reinicia su estado y sus contadores
+void Cache::configurarPrefetch(const ConfiguracionPrefetch& configuracion) {
+    // el prefetcher necesita ver todos los accesos de demanda
+    if (configuracion.tipo != TipoPrefetcher::NINGUNO && mascaraMuestreo != 0) {
+        throw std::invalid_argument("El prefetch no se combina con el muestreo de conjuntos");
+    }
+    // el prefetch coloca bloques por conjunto y etiqueta
+    if (configuracion.tipo != TipoPrefetcher::NINGUNO && funcionIndice == FuncionIndice::SESGADA) {
+        throw std::invalid_argument("El prefetch no se combina con la indexación sesgada");
+    }
+    prefetcher = Prefetcher(configuracion, tamanoBloque);
+    // las lineas ya presentes pasan a contar como traidas por demanda
+    prefetchados.assign(numConjuntos, 0);
+    llegadaPrefetch.assign(prefetcher.activo() ? static_cast<std::size_t>(numConjuntos) * asociatividad : 0, 0);
+    enVuelo.clear();
+    instante = 0;
+    estadisticasPrefetch = EstadisticasPrefetch();
+}
+
+// activa la clasificacion con una cache en sombra de tantas lineas como la real; con
+// muestreo la sombra solo ve los bloques de los conjuntos muestreados y tiene sus lineas
+void Cache::configurarClasificacion(bool activa) {
+    clasificador = activa ? ClasificadorFallos(numConjuntos * asociatividad / getFactorMuestreo())
+                          : ClasificadorFallos();
+}
+
+// elige la fraccion de conjuntos simulados y reinicia los descartes
+void Cache::configurarMuestreo(int factor) {
+    // con un solo conjunto muestreado no habria varianza que estimar
+    if (!esPotenciaDeDos(factor) || (factor > 1 && factor > numConjuntos / 2)) {
+        throw std::invalid_argument("Factor de muestreo debe ser potencia de dos y dejar al menos dos conjuntos");
+    }
+    if (factor > 1 && prefetcher.activo()) {
+        throw std::invalid_argument("El prefetch no se combina con el muestreo de conjuntos");
+    }
+    // el hash de muestreo es una biyeccion de conjuntos potencia de dos
+    if (factor > 1 && (!esPotenciaDeDos(numConjuntos) || funcionIndice == FuncionIndice::SESGADA)) {
+        throw std::invalid_argument("El muestreo requiere conjuntos potencia de dos sin indexación sesgada");
+    }
+    mascaraMuestreo = static_cast<uint32_t>(factor - 1);
+    accesosDescartados = 0;
+    // la sombra del clasificador se ajusta a las lineas muestreadas, sea cual sea el orden
+    if (clasificador.activo()) configurarClasificacion(true);
+}
+
+// extrapola la tasa de aciertos de los conjuntos muestreados a toda la cache
+// estimador de razon por conglomerados: cada conjunto es un conglomerado de accesos y
+// la varianza sale de los residuos a_i - r * m_i, con correccion por poblacion finita
+EstimacionMuestreo Cache::estimarMuestreo(double z) const {
+    EstimacionMuestreo estimacion;
+    estimacion.conjuntosTotales = numConjuntos;
+    uint64_t aciertosMuestra = 0;
+    for (int c = 0; c < numConjuntos; ++c) {
+        if (!conjuntoMuestreado(static_cast<uint32_t>(c))) continue;
+        estimacion.conjuntosMuestreados++;
+        aciertosMuestra += aciertosPorConjunto[c];
+        estimacion.accesosMuestreados += aciertosPorConjunto[c] + fallosPorConjunto[c];
+    }
+    estimacion.accesosTotales = estimacion.accesosMuestreados + accesosDescartados;
+    if (estimacion.accesosMuestreados == 0) return estimacion;
+
+    const double razon = static_cast<double>(aciertosMuestra) / static_cast<double>(estimacion.accesosMuestreados);
+    estimacion.tasaAciertos = razon * 100.0;
+    estimacion.aciertosEstimados = static_cast<uint64_t>(razon * static_cast<double>(estimacion.accesosTotales) + 0.5);
+    estimacion.fallosEstimados = estimacion.accesosTotales - estimacion.aciertosEstimados;
+
+    // varianza del estimador de razon (nula si se simulan todos los conjuntos)
+    if (estimacion.conjuntosMuestreados == numConjuntos) return estimacion;
+    const double n = estimacion.conjuntosMuestreados;
+    double sumaResiduos = 0.0;
+    for (int c = 0; c < numConjuntos; ++c) {
+        if (!conjuntoMuestreado(static_cast<uint32_t>(c))) continue;
+        const double residuo = static_cast<double>(aciertosPorConjunto[c]) -
+                               razon * static_cast<double>(aciertosPorConjunto[c] + fallosPorConjunto[c]);
+        sumaResiduos += residuo * residuo;
+    }
+    const double accesosMedios = static_cast<double>(estimacion.accesosMuestreados) / n;
+    const double correccion = 1.0 - n / numConjuntos;
+    const double varianza = correccion * sumaResiduos / ((n - 1.0) * n * accesosMedios * accesosMedios);
+    estimacion.margen = z * std::sqrt(varianza) * 100.0;
+    return estimacion;
+}
+
+// coloca un bloque pedido por el prefetcher, sin contarlo como acceso
+template <typename Politica>
+void Cache::rellenarPrefetch(uint64_t bloque) {
+    const uint32_t conjunto = conjuntoDeBloque(bloque);
+    const uint64_t etiqueta = etiquetaDeBloque(bloque);
+    // la demanda pudo traerlo mientras estaba en vuelo
+    if (buscarCoincidencias(conjunto, etiqueta) != 0) return;
+
+    Desalojo desalojo;
+    accederConjunto<Politica, false>(conjunto, etiqueta, desalojo, geometria());
+    // el relleno del prefetch tambien es trafico con el nivel inferior
+    trafico.bloquesLeidos++;
+    trafico.bloquesDevueltos += desalojo.modificado;
+    // marca la via recien ocupada como traida por prefetch
+    const uint64_t via = buscarCoincidencias(conjunto, etiqueta);
+    prefetchados[conjunto] |= via;
+    llegadaPrefetch[static_cast<std::size_t>(conjunto) * asociatividad + __builtin_ctzll(via)] = instante;
+}
+
+// filtra un candidato del prefetcher y lo pide
+template <typename Politica>
+void Cache::emitirPrefetch(uint64_t numeroBloque) {
+    // fuera del espacio de direcciones
+    if (numeroBloque > (UINT64_MAX >> desplazamientoBloque)) return;
+
+    // ya presente o ya pedido
+    const uint32_t conjunto = conjuntoDeBloque(numeroBloque);
+    const uint64_t etiqueta = etiquetaDeBloque(numeroBloque);
+    bool pedido = buscarCoincidencias(conjunto, etiqueta) != 0;
+    for (const PrefetchEnVuelo& peticion : enVuelo) {
+        pedido = pedido || peticion.bloque == numeroBloque;
+    }
+    if (pedido) {
+        estadisticasPrefetch.redundantes++;
+        return;
+    }
+
+    const ConfiguracionPrefetch& configuracion = prefetcher.getConfiguracion();
+    // sin latencia el bloque llega en el mismo acceso
+    if (configuracion.latencia == 0) {
+        estadisticasPrefetch.emitidos++;
+        rellenarPrefetch<Politica>(numeroBloque);
+        return;
+    }
+    // cola llena: la peticion se pierde
+    if (enVuelo.size() >= static_cast<std::size_t>(configuracion.maxEnVuelo)) {
+        estadisticasPrefetch.descartados++;
+        return;
+    }
+    estadisticasPrefetch.emitidos++;
+    enVuelo.push_back(PrefetchEnVuelo{numeroBloque, instante + static_cast<uint64_t>(configuracion.latencia)});
+}
+
+// acceso de demanda con prefetch: llegadas, acceso, entrenamiento y peticiones
+template <typename Politica>
+bool Cache::accederConPrefetchCon(uint64_t direccion, uint64_t pc, TipoAcceso tipo) {
+    ++instante;
+    // 1. coloca los bloques cuya peticion ya ha llegado
+    while (!enVuelo.empty() && enVuelo.front().listo <= instante) {
+        rellenarPrefetch<Politica>(enVuelo.front().bloque);
+        enVuelo.pop_front();
+    }
+
+    // 2. la demanda alcanza a un prefetch en vuelo: se pidio bien pero tarde
+    const uint64_t bloque = direccion >> desplazamientoBloque;
+    for (auto peticion = enVuelo.begin(); peticion != enVuelo.end(); ++peticion) {
+        if (peticion->bloque == bloque) {
+            estadisticasPrefetch.tardios++;
+            enVuelo.erase(peticion);
+            break;
+        }
+    }
+
+    // 3. acceso de demanda, el unico que cuenta en aciertos y fallos
+    aciertoEnPrefetch = false;
+    Desalojo desalojo;
+    const bool acierto = tipo == TipoAcceso::ESCRITURA
+        ? escribirConjunto<Politica>(conjuntoDeBloque(bloque),
+                                     direccion >> desplazamientoEtiqueta, desalojo, geometria())
+        : accederCon<Politica, true>(direccion, desalojo);
+
+    // 4. entrena al prefetcher y pide sus candidatos
+    candidatosPrefetch.clear();
+    prefetcher.observar(direccion, pc, !acierto || aciertoEnPrefetch, candidatosPrefetch);
+    for (uint64_t candidato : candidatosPrefetch) {
+        emitirPrefetch<Politica>(candidato);
+    }
+    return acierto;
+}
+
+// acceso de demanda que entrena al prefetcher configurado
+bool Cache::accederConPrefetch(uint64_t direccion, uint64_t pc, TipoAcceso tipo) {
+    // sin prefetcher es un acceso normal
+    if (!prefetcher.activo()) {
+        Desalojo desalojo;
+        return acceder(direccion, tipo, desalojo);
+    }
+
+    return conPolitica([&](auto p) { return accederConPrefetchCon<decltype(p)>(direccion, pc, tipo); });
+}
+
 // muestra estadisticas de la cache
 void Cache::imprimirEstadisticas() const {
     std::cout << "\n=== Estadísticas de Caché ===\n";
+    std::cout << "Política de reemplazo: " << nombrePoliticaReemplazo(politica) << "\n";
+    if (funcionIndice != FuncionIndice::MASCARA) {
+        std::cout << "Función de índice: " << nombreFuncionIndice(funcionIndice) << " (" << numConjuntos
+                  << " conjuntos)\n";
+    }
     std::cout << "Total accesos: " << (aciertos + fallos) << "\n";
     std::cout << "Aciertos: " << aciertos << " (" 
               << (aciertos * 100.0 / (aciertos + fallos)) << "%)\n";
     std::cout << "Fallos: " << fallos << " (" 
               << (fallos * 100.0 / (aciertos + fallos)) << "%)\n";
     
+    // con muestreo los contadores son solo de los conjuntos simulados
+    if (mascaraMuestreo != 0) {
+        const EstimacionMuestreo estimacion = estimarMuestreo();
+        std::cout << "Muestreo: " << estimacion.conjuntosMuestreados << " de " << estimacion.conjuntosTotales
+                  << " conjuntos, " << accesosDescartados << " accesos descartados\n";
+        std::cout << "Tasa de aciertos estimada: " << estimacion.tasaAciertos << "% (IC 95%: "
+                  << estimacion.inferior() << "% - " << estimacion.superior() << "%)\n";
+    }
+
     // muestra estadisticas por conjunto
     for (int c = 0; c < numConjuntos; ++c) {
         if (aciertosPorConjunto[c] + fallosPorConjunto[c] > 0) {
@@ -147,6 +670,41 @@ void Cache::imprimirEstadisticas() const {
                       << "% aciertos\n";
         }
     }
+
+    // escrituras y trafico con el nivel inferior
+    std::cout << "Escritura: " << (escritura == PoliticaEscritura::WRITE_BACK ? "write-back" : "write-through")
+              << (asignarEnEscritura ? ", con asignación" : ", sin asignación") << "\n";
+    std::cout << "Escrituras: " << trafico.escrituras << " (fallos: " << trafico.fallosEscritura << ")\n";
+    std::cout << "Tráfico con el nivel inferior: " << getBytesLeidos() << " bytes leídos ("
+              << trafico.bloquesLeidos << " bloques), " << getBytesEscritos() << " bytes escritos ("
+              << trafico.bloquesDevueltos << " bloques devueltos, "
+              << trafico.escriturasDirectas << " escrituras directas)\n";
+
+    // causas de los fallos de demanda
+    if (clasificador.activo()) {
+        const ClasificacionFallos& c = clasificador.getClasificacion();
+        const double total = c.total() > 0 ? static_cast<double>(c.total()) : 1.0;
+        std::cout << "Fallos por causa: obligatorios " << c.obligatorios << " (" << c.obligatorios * 100.0 / total
+                  << "%), capacidad " << c.capacidad << " (" << c.capacidad * 100.0 / total
+                  << "%), conflicto " << c.conflicto << " (" << c.conflicto * 100.0 / total << "%)\n";
+    }
+
+    // el prefetch se informa aparte de los accesos de demanda
+    if (prefetcher.activo()) {
+        const ConfiguracionPrefetch& configuracion = prefetcher.getConfiguracion();
+        const EstadisticasPrefetch& p = estadisticasPrefetch;
+        std::cout << "Prefetch: " << nombreTipoPrefetcher(configuracion.tipo)
+                  << " (grado " << configuracion.grado << ", distancia " << configuracion.distancia
+                  << ", latencia " << configuracion.latencia << ")\n";
+        std::cout << "  Emitidos: " << p.emitidos << "  Redundantes: " << p.redundantes
+                  << "  Descartados: " << p.descartados << "\n";
+        std::cout << "  Útiles: " << p.utiles << "  Tardíos: " << p.tardios
+                  << "  Inútiles: " << p.inutiles << "\n";
+        std::cout << "  Precisión: " << p.precision() * 100.0 << "%"
+                  << "  Cobertura: " << p.cobertura(fallos) * 100.0 << "%"
+                  << "  Puntualidad: " << p.puntualidad() * 100.0 << "%"
+                  << "  Antelación media: " << p.antelacionMedia() << " accesos\n";
+    }
 }
 
 // muestra estado actual de la cache
@@ -156,17 +714,30 @@ void Cache::imprimirEstado() const {
     for (int conjunto = 0; conjunto < numConjuntos; ++conjunto) {
         std::cout << "Conjunto " << conjunto << ":\n";
         // recorre todas las vias de cada conjunto
-        for (std::size_t via = 0; via < cache[conjunto].size(); ++via) {
-            const auto& linea = cache[conjunto][via];
+        for (int via = 0; via < asociatividad; ++via) {
+            const LineaCache linea = obtenerLinea(conjunto, via);
             std::cout << "  Via " << via << ": ";
             if (linea.valido) {
                 // muestra info de linea valida
                 std::cout << "Tag=" << linea.etiqueta 
-                          << " (Accesos=" << linea.contadorAccesos << ")";
+                          << " (Reemplazo=" << linea.contadorAccesos << ")"
+                          << (linea.modificado ? " Modificada" : "");
             } else {
                 std::cout << "Inválido";
             }
             std::cout << "\n";
         }
     }
-}
\ No newline at end of file
+}
+
+// reconstruye la linea de una via a partir del almacenamiento plano
+LineaCache Cache::obtenerLinea(int conjunto, int via) const {
+    LineaCache linea;
+    // verifica indices validos
+    if (conjunto < 0 || conjunto >= numConjuntos || via < 0 || via >= asociatividad) return linea;
+
+    const std::size_t indice = static_cast<std::size_t>(conjunto) * asociatividad + via;
+    linea.inicializar(etiquetas[indice], (validos[conjunto] >> via) & 1, (modificados[conjunto] >> via) & 1);
+    linea.contadorAccesos = estadoVias[indice];
+    return linea;
+}
@@ -8,12 +8,96 @@
 #include <cstddef>
 // inclusion para tipos enteros de tamaño fijo
 #include <cstdint>
+// inclusion para la cola de prefetches en vuelo
+#include <deque>
 // inclusion del archivo con la definicion de LineaCache
 #include "LineaCache.hpp"
+// inclusion de las politicas de reemplazo
+#include "PoliticasReemplazo.hpp"
+// inclusion de la comparacion vectorial de etiquetas
+#include "ComparacionEtiquetas.hpp"
+// inclusion de las funciones de indice de conjunto
+#include "IndiceConjunto.hpp"
+// inclusion del motor de prefetch
+#include "Prefetcher.hpp"
+// inclusion del clasificador de fallos en obligatorios, capacidad y conflicto
+#include "ClasificadorFallos.hpp"
+// inclusion del asignador alineado a linea de cache
+#include "Common/AsignadorAlineado.hpp"
+// inclusion del tipo de acceso (lectura, escritura, instruccion)
+#include "Common/TipoAcceso.hpp"
+
+// bloque expulsado de la cache para hacer sitio a otro
+struct Desalojo {
+    // true si se expulso una linea valida
+    bool valido = false;
+    // direccion del primer byte del bloque expulsado
+    uint64_t direccionBloque = 0;
+    // true si la linea expulsada estaba modificada y debe escribirse abajo
+    bool modificado = false;
+};
+
+// que hace la cache con los datos de una escritura que acierta
+enum class PoliticaEscritura {
+    WRITE_BACK,    // marca la linea modificada y la escribe abajo al expulsarla
+    WRITE_THROUGH  // envia cada escritura al nivel inferior, la linea nunca queda modificada
+};
+
+// datos movidos entre la cache y el nivel inferior
+struct TraficoCache {
+    // accesos de escritura y cuantos fallaron
+    uint64_t escrituras = 0;
+    uint64_t fallosEscritura = 0;
+    // bloques traidos del nivel inferior (fallos que asignan y prefetch)
+    uint64_t bloquesLeidos = 0;
+    // bloques modificados escritos abajo al expulsarlos (write-back)
+    uint64_t bloquesDevueltos = 0;
+    // escrituras enviadas abajo sin bloque (write-through o fallo sin asignacion)
+    uint64_t escriturasDirectas = 0;
+};
+
+// estimacion de los contadores globales a partir de los conjuntos muestreados
+struct EstimacionMuestreo {
+    // conjuntos simulados y conjuntos de la cache
+    int conjuntosMuestreados = 0;
+    int conjuntosTotales = 0;
+    // accesos simulados y accesos vistos (simulados mas descartados)
+    uint64_t accesosMuestreados = 0;
+    uint64_t accesosTotales = 0;
+    // tasa de aciertos estimada en porcentaje (estimador de razon sobre los conjuntos)
+    double tasaAciertos = 0.0;
+    // semiamplitud del intervalo de confianza de la tasa, en puntos porcentuales
+    // (0 si se simulan todos los conjuntos)
+    double margen = 0.0;
+    // aciertos y fallos extrapolados a todos los accesos
+    uint64_t aciertosEstimados = 0;
+    uint64_t fallosEstimados = 0;
+
+    // limites del intervalo de confianza, recortados a [0, 100]
+    double inferior() const { return tasaAciertos - margen > 0.0 ? tasaAciertos - margen : 0.0; }
+    double superior() const { return tasaAciertos + margen < 100.0 ? tasaAciertos + margen : 100.0; }
+};
+
+// geometria que usa el nucleo del acceso, leida de la cache en tiempo de ejecucion
+// GeometriaFija (CacheFija.hpp) tiene los mismos campos como constantes de compilacion,
+// con lo que el mismo nucleo se instancia con las vias y las mascaras conocidas
+struct GeometriaVariable {
+    static constexpr bool FIJA = false;
+    uint32_t vias;
+    uint32_t desplazamientoBloque;
+    uint32_t desplazamientoEtiqueta;
+    uint32_t bitsConjunto;
+    uint32_t mascaraConjunto;
+    uint64_t mascaraVias;
+};
 
 // clase que representa una memoria cache
 class Cache {
 private:
+    // vector cuya memoria empieza en una linea de cache del anfitrion
+    template <typename T>
+    using VectorAlineado = std::vector<T, AsignadorAlineado<T>>;
+
     // tamaño total de la cache en bytes
     int tamanoCache;
     // tamaño de cada bloque de cache en bytes
@@ -22,59 +106,365 @@ private:
     int asociatividad;
     // numero de conjuntos en la cache
     int numConjuntos;
+    // politica de reemplazo elegida en la construccion
+    PoliticaReemplazo politica;
+    // funcion de indice elegida en la construccion
+    FuncionIndice funcionIndice;
+
+    // geometria precalculada en el constructor para evitar divisiones por acceso
+    // log2 del tamaño de bloque (direccion -> numero de bloque)
+    uint32_t desplazamientoBloque;
+    // direccion -> etiqueta: log2 del tamaño de bloque por numero de conjuntos con MASCARA;
+    // con las demas funciones la etiqueta es el numero de bloque completo
+    uint32_t desplazamientoEtiqueta;
+    // log2 del numero de conjuntos (solo si es potencia de dos)
+    uint32_t bitsConjunto;
+    // mascara para extraer el conjunto del numero de bloque (los conjuntos caben en 32 bits)
+    uint32_t mascaraConjunto;
+    // resto rapido por el numero de conjuntos (MODULO) o por el primo (PRIMO)
+    ModuloRapido moduloConjuntos;
+    // reloj de las marcas lru de la cache sesgada
+    uint64_t relojSesgado;
+    // mascara con un bit por via existente
+    uint64_t mascaraVias;
+
+    // almacenamiento plano en forma de estructura de arreglos
+    // la via v del conjunto c ocupa la posicion c * asociatividad + v
+    // etiquetas de todas las lineas (mas RELLENO_ETIQUETAS para las lecturas vectoriales)
+    VectorAlineado<uint64_t> etiquetas;
+    // estado de reemplazo de todas las lineas (lo interpreta la politica)
+    VectorAlineado<uint64_t> estadoVias;
+    // un mapa de bits de validez por conjunto (bit v = via v valida)
+    VectorAlineado<uint64_t> validos;
+    // un mapa de bits de lineas modificadas por conjunto (solo write-back)
+    VectorAlineado<uint64_t> modificados;
+    // estado de reemplazo de cada conjunto (lo interpreta la politica)
+    VectorAlineado<uint64_t> estadoConjuntos;
 
-    // estructura principal que almacena las lineas de cache
-    // vector de conjuntos, cada conjunto es un vector de lineas
-    std::vector<std::vector<LineaCache>> cache;
     // contador de aciertos por cada conjunto
-    std::vector<int> aciertosPorConjunto;
+    std::vector<uint64_t> aciertosPorConjunto;
     // contador de fallos por cada conjunto
-    std::vector<int> fallosPorConjunto;
+    std::vector<uint64_t> fallosPorConjunto;
 
-    // contador total de aciertos
-    int aciertos;
+    // contador total de aciertos (64 bits: las trazas reales superan los 2^31 accesos)
+    uint64_t aciertos;
     // contador total de fallos
-    int fallos;
+    uint64_t fallos;
+
+    // escrituras
+    // politica de escritura en acierto
+    PoliticaEscritura escritura;
+    // true si un fallo de escritura trae el bloque (write-allocate)
+    bool asignarEnEscritura;
+    // bytes que mueve cada escritura directa
+    int bytesPorEscritura;
+    // trafico con el nivel inferior
+    TraficoCache trafico;
+
+    // prefetch (los bloques traidos por prefetch no cuentan como accesos de demanda)
+    // generador de candidatos, inactivo por defecto
+    Prefetcher prefetcher;
+    // un mapa por conjunto de lineas traidas por prefetch que la demanda aun no ha usado
+    VectorAlineado<uint64_t> prefetchados;
+    // instante de llegada de cada linea traida por prefetch (solo con prefetch activo)
+    std::vector<uint64_t> llegadaPrefetch;
+    // peticion de prefetch pendiente de llegar
+    struct PrefetchEnVuelo {
+        uint64_t bloque;
+        uint64_t listo;
+    };
+    // peticiones en vuelo, ordenadas por instante de llegada (latencia constante)
+    std::deque<PrefetchEnVuelo> enVuelo;
+    // candidatos del ultimo acceso, reutilizado para no reservar memoria por acceso
+    std::vector<uint64_t> candidatosPrefetch;
+    // accesos de demanda vistos por el prefetch, reloj de latencias y antelaciones
+    uint64_t instante;
+    // true si el ultimo acierto fue el primer uso de una linea traida por prefetch
+    bool aciertoEnPrefetch;
+    // contadores del prefetch
+    EstadisticasPrefetch estadisticasPrefetch;
 
-    // metodo para marcar una linea como mas recientemente usada (mru)
-    void actualizarComoMRU(int conjunto, int via);
-    // metodo para encontrar la linea menos recientemente usada (lru) en un conjunto
-    std::size_t encontrarLRU(int conjunto) const;
+    // clasificacion de fallos, inactiva por defecto
+    ClasificadorFallos clasificador;
+
+    // muestreo de conjuntos (factor 1 = se simulan todos)
+    // se simula el conjunto si los bits bajos de su hash son cero
+    uint32_t mascaraMuestreo;
+    // accesos a conjuntos no muestreados, descartados sin simular
+    uint64_t accesosDescartados;
+
+    // geometria de la cache para el nucleo del acceso
+    GeometriaVariable geometria() const {
+        return GeometriaVariable{static_cast<uint32_t>(asociatividad), desplazamientoBloque, desplazamientoEtiqueta,
+                                 bitsConjunto, mascaraConjunto, mascaraVias};
+    }
+    // vista del estado de reemplazo de un conjunto
+    template <typename Geometria>
+    EstadoReemplazo estadoDe(uint32_t conjunto, const Geometria& g) {
+        return EstadoReemplazo{&estadoVias[static_cast<std::size_t>(conjunto) * g.vias],
+                               estadoConjuntos[conjunto], g.vias};
+    }
+    // true si el conjunto se simula con el muestreo activo
+    // el hash es una biyeccion de los indices de conjunto: se simula exactamente uno
+    // de cada factor conjuntos, repartidos por toda la cache
+    bool conjuntoMuestreado(uint32_t conjunto) const {
+        uint32_t hash = (conjunto * 0x9E3779B1u) & mascaraConjunto;
+        hash ^= hash >> ((bitsConjunto + 1) / 2);
+        return (hash & mascaraMuestreo) == 0;
+    }
+    // conjunto de un numero de bloque segun la funcion de indice
+    // MASCARA es un salto predecible y una mascara; el resto no divide
+    uint32_t conjuntoDeBloque(uint64_t bloque) const {
+        switch (funcionIndice) {
+            case FuncionIndice::MASCARA: return static_cast<uint32_t>(bloque) & mascaraConjunto;
+            case FuncionIndice::XOR:
+                return static_cast<uint32_t>(bloque ^ (bloque >> bitsConjunto) ^ (bloque >> (2 * bitsConjunto))) &
+                       mascaraConjunto;
+            case FuncionIndice::SESGADA:
+                // conjunto de la via 0 (contadores por conjunto de los fallos sin asignacion)
+                return conjuntoSesgado(bloque, 0, static_cast<uint32_t>(numConjuntos));
+            case FuncionIndice::MODULO:
+            case FuncionIndice::PRIMO: break;
+        }
+        return moduloConjuntos(bloque);
+    }
+    // conjunto de una direccion
+    uint32_t conjuntoDe(uint64_t direccion) const { return conjuntoDeBloque(direccion >> desplazamientoBloque); }
+    // con geometria fija la funcion de indice es siempre MASCARA
+    template <typename Geometria>
+    uint32_t conjuntoDe(uint64_t direccion, const Geometria& g) const {
+        if constexpr (Geometria::FIJA) return static_cast<uint32_t>(direccion >> g.desplazamientoBloque) & g.mascaraConjunto;
+        else return conjuntoDe(direccion);
+    }
+    // etiqueta de un numero de bloque
+    uint64_t etiquetaDeBloque(uint64_t bloque) const {
+        return bloque >> (desplazamientoEtiqueta - desplazamientoBloque);
+    }
+    // numero de bloque a partir de conjunto y etiqueta
+    uint64_t bloqueDe(uint32_t conjunto, uint64_t etiqueta) const {
+        if (funcionIndice != FuncionIndice::MASCARA) return etiqueta;
+        return (etiqueta << bitsConjunto) | conjunto;
+    }
+    template <typename Geometria>
+    uint64_t bloqueDe(uint32_t conjunto, uint64_t etiqueta, const Geometria& g) const {
+        if constexpr (Geometria::FIJA) return (etiqueta << g.bitsConjunto) | conjunto;
+        else return bloqueDe(conjunto, etiqueta);
+    }
+    // llama a f con la politica activa como tipo, resolviendo el switch una sola vez
+    template <typename Funcion>
+    decltype(auto) conPolitica(Funcion&& f);
+    // deja todos los conjuntos en el estado inicial de la politica
+    template <typename Politica>
+    void inicializarEstados();
+    // devuelve el mapa de vias validas del conjunto que contienen la etiqueta
+    template <typename Geometria>
+    uint64_t buscarCoincidencias(uint32_t conjunto, uint64_t etiqueta, const Geometria& g) const;
+    uint64_t buscarCoincidencias(uint32_t conjunto, uint64_t etiqueta) const {
+        return buscarCoincidencias(conjunto, etiqueta, geometria());
+    }
+    // acceso con la politica resuelta en tiempo de compilacion
+    // los rellenos de la jerarquia no cuentan como accesos (ContarEstadisticas=false)
+    template <typename Politica, bool ContarEstadisticas>
+    bool accederCon(uint64_t direccion, Desalojo& desalojo);
+    // nucleo del acceso con conjunto y etiqueta ya calculados
+    // (las plantillas del nucleo estan en NucleoCache.hpp)
+    template <typename Politica, bool ContarEstadisticas, typename Geometria>
+    bool accederConjunto(uint32_t conjunto, uint64_t etiqueta, Desalojo& desalojo, const Geometria& g);
+    // escritura con la politica resuelta en tiempo de compilacion
+    template <typename Politica, typename Geometria>
+    bool escribirConjunto(uint32_t conjunto, uint64_t etiqueta, Desalojo& desalojo, const Geometria& g);
+    // lote de accesos con la politica resuelta una sola vez (tipos nulo = todo lecturas)
+    template <typename Politica, typename Geometria>
+    std::size_t accederLoteCon(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad,
+                               uint8_t* resultados, const Geometria& g);
+    // simulacion repartida por conjuntos con la politica resuelta una sola vez
+    template <typename Politica>
+    std::size_t accederParaleloCon(const uint64_t* direcciones, std::size_t cantidad, unsigned hilos);
+    // acceso de demanda que entrena al prefetcher y atiende sus peticiones
+    template <typename Politica>
+    bool accederConPrefetchCon(uint64_t direccion, uint64_t pc, TipoAcceso tipo);
+    // coloca en la cache un bloque pedido por el prefetcher
+    template <typename Politica>
+    void rellenarPrefetch(uint64_t bloque);
+    // filtra un candidato y lo pide o lo encola
+    template <typename Politica>
+    void emitirPrefetch(uint64_t bloque);
+    // cache sesgada: cada via tiene su propio conjunto para el bloque
+    // busca el bloque en sus lineas candidatas; conjunto y via reciben la posicion
+    bool buscarSesgado(uint64_t bloque, uint32_t& conjunto, uint32_t& via) const;
+    // acceso con lru entre las lineas candidatas (primero una libre)
+    template <bool ContarEstadisticas>
+    bool accederSesgado(uint64_t bloque, Desalojo& desalojo, uint32_t& conjunto, uint32_t& via);
+    // escritura con la politica de escritura configurada
+    bool escribirSesgado(uint64_t bloque, Desalojo& desalojo);
+
+protected:
+    // caminos de acceso con la geometria como tipo: Cache los llama con GeometriaVariable
+    // y CacheFija con su GeometriaFija, sin otra copia del algoritmo
+    // acceso de lectura o escritura que informa del bloque expulsado
+    template <typename Geometria>
+    bool accederGeometria(uint64_t direccion, TipoAcceso tipo, Desalojo& desalojo, const Geometria& g);
+    // acceso de demanda (con prefetcher activo pasa por accederConPrefetch)
+    template <typename Geometria>
+    bool accederDemanda(uint64_t direccion, TipoAcceso tipo, const Geometria& g);
+    // lote con el tipo y el pc de cada acceso (tipos nulo = todo lecturas, pcs nulo = pc 0)
+    template <typename Geometria>
+    std::size_t accederLoteGeometria(const uint64_t* direcciones, const TipoAcceso* tipos, const uint64_t* pcs,
+                                     std::size_t cantidad, uint8_t* resultados, const Geometria& g);
 
 public:
+    // numero maximo de vias (el mapa de validez de un conjunto es de 64 bits)
+    static constexpr int MAX_VIAS = 64;
+
     // constructor principal que recibe parametros de configuracion
-    Cache(int tamano, int tamanoBloque, int asociatividad);
-    
+    // el tamaño de bloque debe ser potencia de dos; el numero de conjuntos tambien con
+    // las funciones de indice MASCARA (por defecto) y XOR
+    Cache(int tamano, int tamanoBloque, int asociatividad,
+          PoliticaReemplazo politica = PoliticaReemplazo::LRU,
+          FuncionIndice indice = FuncionIndice::MASCARA);
+
     // metodos principales
     // simula un acceso a la direccion de memoria, devuelve true si fue acierto
-    bool acceder(int direccion);
-    // version con prefetch del acceso a memoria
-    bool accederConPrefetch(int direccion);
-    
+    // las direcciones son de 64 bits: todo el espacio de direcciones es valido
+    bool acceder(uint64_t direccion);
+    // igual que acceder, pero informa del bloque expulsado en caso de fallo
+    bool acceder(uint64_t direccion, Desalojo& desalojo);
+    // acceso de lectura o escritura
+    bool acceder(uint64_t direccion, TipoAcceso tipo);
+    // acceso de lectura o escritura que informa del bloque expulsado
+    bool acceder(uint64_t direccion, TipoAcceso tipo, Desalojo& desalojo);
+    // acceso de demanda con el pc de la instruccion, que usa el prefetcher de strides
+    // sin prefetcher configurado equivale a acceder
+    bool accederConPrefetch(uint64_t direccion, uint64_t pc = 0, TipoAcceso tipo = TipoAcceso::LECTURA);
+    // simula una secuencia de accesos y devuelve cuantos fueron aciertos
+    // resultados (opcional) recibe 1 o 0 por direccion; mismo efecto que llamar a acceder una a una
+    std::size_t accederLote(const uint64_t* direcciones, std::size_t cantidad, uint8_t* resultados = nullptr);
+    // version del lote para una traza completa en memoria
+    std::size_t accederLote(const std::vector<uint64_t>& direcciones) {
+        return accederLote(direcciones.data(), direcciones.size());
+    }
+    // lote con el tipo de cada acceso
+    std::size_t accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad,
+                            uint8_t* resultados = nullptr);
+    // lote con el tipo y el pc de cada acceso (tipos nulo = todo lecturas); los pc solo los
+    // usa el prefetcher de strides, como en accederConPrefetch
+    std::size_t accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, const uint64_t* pcs,
+                            std::size_t cantidad, uint8_t* resultados = nullptr);
+    // simula la secuencia repartiendo los conjuntos entre varios hilos
+    // cada hilo es dueño de un rango contiguo de conjuntos y de sus contadores, y ve
+    // los accesos a sus conjuntos en orden de programa: el resultado es identico al
+    // de accederLote (hilos=0 usa todos los nucleos del anfitrion)
+    std::size_t accederParalelo(const uint64_t* direcciones, std::size_t cantidad, unsigned hilos = 0);
+    // version paralela para una traza completa en memoria
+    std::size_t accederParalelo(const std::vector<uint64_t>& direcciones, unsigned hilos = 0) {
+        return accederParalelo(direcciones.data(), direcciones.size(), hilos);
+    }
+
+    // operaciones usadas por JerarquiaCache
+    // coloca el bloque sin contar un acceso, devuelve true si ya estaba presente
+    // con modificado=true la linea queda modificada (escritura devuelta por el nivel superior);
+    // una cache write-through no la guarda modificada: la cuenta como bloque devuelto y quien
+    // llama debe escribirla en el nivel siguiente (no sirve para subir bloques modificados)
+    bool insertar(uint64_t direccion, Desalojo& desalojo, bool modificado = false);
+    // busca el bloque contando el acceso y, si esta, lo saca de la cache
+    // modificado (opcional) recibe si la linea extraida estaba modificada
+    bool extraer(uint64_t direccion, bool* modificado = nullptr);
+    // invalida el bloque si esta presente, devuelve true si estaba
+    // modificado (opcional) recibe si la linea invalidada estaba modificada
+    bool invalidar(uint64_t direccion, bool* modificado = nullptr);
+    // comprueba si el bloque esta presente sin alterar estado ni estadisticas
+    bool contiene(uint64_t direccion) const;
+
+    // escrituras
+    // elige la politica de escritura (por defecto write-back con asignacion)
+    // bytesPorEscritura es lo que mueve cada escritura directa al nivel inferior
+    void configurarEscritura(PoliticaEscritura politica, bool asignarEnEscritura, int bytesPorEscritura = 4);
+    // trafico con el nivel inferior
+    const TraficoCache& getTrafico() const { return trafico; }
+    // bytes leidos del nivel inferior
+    uint64_t getBytesLeidos() const { return trafico.bloquesLeidos * static_cast<uint64_t>(tamanoBloque); }
+    // bytes escritos en el nivel inferior (bloques devueltos y escrituras directas)
+    uint64_t getBytesEscritos() const {
+        return trafico.bloquesDevueltos * static_cast<uint64_t>(tamanoBloque) +
+               trafico.escriturasDirectas * static_cast<uint64_t>(bytesPorEscritura);
+    }
+    // politica de escritura en uso
+    PoliticaEscritura getPoliticaEscritura() const { return escritura; }
+    // true si los fallos de escritura traen el bloque
+    bool getAsignarEnEscritura() const { return asignarEnEscritura; }
+
+    // prefetch
+    // instala un prefetcher y reinicia sus contadores (no vacia la cache)
+    // acceder, accederConPrefetch y accederLote lo entrenan; accederParalelo pasa a ser secuencial
+    // no disponible con la indexacion sesgada
+    void configurarPrefetch(const ConfiguracionPrefetch& configuracion);
+    // contadores de prefetch: emitidos, utiles, tardios, inutiles...
+    const EstadisticasPrefetch& getEstadisticasPrefetch() const { return estadisticasPrefetch; }
+    // configuracion del prefetcher en uso
+    const ConfiguracionPrefetch& getConfiguracionPrefetch() const { return prefetcher.getConfiguracion(); }
+
+    // clasificacion de fallos
+    // activa o desactiva la clasificacion y reinicia sus contadores; conviene activarla
+    // con la cache vacia, los bloques ya presentes no cuentan como vistos
+    // con la clasificacion activa accederParalelo pasa a ser secuencial
+    void configurarClasificacion(bool activa);
+    // true si la cache clasifica sus fallos
+    bool getClasificacionActiva() const { return clasificador.activo(); }
+    // fallos de demanda por causa (ceros si la clasificacion esta inactiva)
+    const ClasificacionFallos& getClasificacionFallos() const { return clasificador.getClasificacion(); }
+
+    // muestreo de conjuntos
+    // simula solo uno de cada factor conjuntos (factor potencia de dos que deje al menos
+    // dos conjuntos; 1 lo desactiva) y descarta el resto de accesos tras una
+    // comprobacion de mascara; aciertos, fallos y trafico cuentan solo lo simulado y
+    // estimarMuestreo lo extrapola. Conviene activarlo con la cache vacia
+    // no se combina con prefetch ni con la indexacion sesgada y requiere un numero de
+    // conjuntos potencia de dos; la clasificacion ve solo los conjuntos muestreados, con
+    // una sombra de sus lineas (cambiar el factor la reinicia)
+    void configurarMuestreo(int factor);
+    // factor de muestreo en uso (1 = sin muestreo)
+    int getFactorMuestreo() const { return static_cast<int>(mascaraMuestreo) + 1; }
+    // accesos descartados por caer en conjuntos no muestreados
+    uint64_t getAccesosDescartados() const { return accesosDescartados; }
+    // tasa global estimada con su intervalo de confianza (z = 1.96 para el 95%)
+    EstimacionMuestreo estimarMuestreo(double z = 1.96) const;
+
     // metodos de visualizacion
     // muestra estadisticas de aciertos/fallos
     void imprimirEstadisticas() const;
     // muestra el estado actual de la cache
     void imprimirEstado() const;
-    
+
     // metodos de consulta
     // devuelve el numero de conjuntos en la cache
     int calcularNumConjuntos() const { return numConjuntos; }
+    // devuelve la politica de reemplazo en uso
+    PoliticaReemplazo getPolitica() const { return politica; }
+    // devuelve la funcion de indice en uso
+    FuncionIndice getFuncionIndice() const { return funcionIndice; }
+    // devuelve el tamaño total en bytes
+    int getTamano() const { return tamanoCache; }
+    // devuelve el tamaño de bloque en bytes
+    int getTamanoBloque() const { return tamanoBloque; }
+    // devuelve la asociatividad
+    int getAsociatividad() const { return asociatividad; }
     // obtiene el contador total de aciertos
-    int getAciertos() const { return aciertos; }
+    uint64_t getAciertos() const { return aciertos; }
     // obtiene el contador total de fallos
-    int getFallos() const { return fallos; }
+    uint64_t getFallos() const { return fallos; }
     // calcula el porcentaje de aciertos
     double getTasaAciertos() const {
         return (aciertos + fallos) > 0 ? (aciertos * 100.0) / (aciertos + fallos) : 0.0;
     }
-    
+    // devuelve una copia de la linea almacenada en la via de un conjunto
+    LineaCache obtenerLinea(int conjunto, int via) const;
+
     // validacion
     // verifica si una direccion esta dentro del rango manejado por la cache
-    bool direccionValida(int direccion) const {
-        return direccion >= 0 && (direccion / tamanoBloque) < (numConjuntos * asociatividad);
+    bool direccionValida(uint64_t direccion) const {
+        return (direccion >> desplazamientoBloque) < static_cast<uint64_t>(numConjuntos) * asociatividad;
     }
 };
 
 // fin de la directiva de preprocesador ifndef
-#endif
\ No newline at end of file
+#endif
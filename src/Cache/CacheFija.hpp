@@ -0,0 +1,113 @@
+// directiva para evitar inclusiones multiples
+#ifndef CACHEFIJA_HPP
+#define CACHEFIJA_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion de la cache dinamica y de su nucleo de acceso como plantilla
+#include "Cache.hpp"
+#include "NucleoCache.hpp"
+
+// log2 de una potencia de dos en tiempo de compilacion
+constexpr uint32_t log2Constante(uint64_t valor) {
+    return valor > 1 ? 1 + log2Constante(valor >> 1) : 0;
+}
+
+// geometria conocida en tiempo de compilacion, con los mismos campos que GeometriaVariable
+// (indexa siempre con mascara)
+template <int Bloque, int Conjuntos, int Vias>
+struct GeometriaFija {
+    static_assert(Bloque > 0 && (Bloque & (Bloque - 1)) == 0, "Tamaño de bloque debe ser potencia de dos");
+    static_assert(Vias > 0 && Vias <= Cache::MAX_VIAS, "Asociatividad entre 1 y 64 vías");
+    static_assert(Conjuntos > 0 && (Conjuntos & (Conjuntos - 1)) == 0,
+                  "Número de conjuntos debe ser potencia de dos");
+
+    static constexpr bool FIJA = true;
+    static constexpr uint32_t vias = Vias;
+    static constexpr uint32_t desplazamientoBloque = log2Constante(Bloque);
+    static constexpr uint32_t bitsConjunto = log2Constante(Conjuntos);
+    static constexpr uint32_t desplazamientoEtiqueta = desplazamientoBloque + bitsConjunto;
+    static constexpr uint32_t mascaraConjunto = Conjuntos - 1;
+    static constexpr uint64_t mascaraVias = Vias == 64 ? ~uint64_t(0) : (uint64_t(1) << Vias) - 1;
+};
+
+// cache con la geometria fijada en tiempo de compilacion
+// es una Cache (mismo almacenamiento, politicas, contadores y configuracion); solo
+// cambia el camino de acceso, que instancia el nucleo de Cache con GeometriaFija:
+// conjuntos, desplazamientos, mascaras y numero de vias pasan a ser constantes y el
+// compilador desenrolla la comparacion de etiquetas. Los accesos a traves de una
+// referencia a Cache siguen el camino con la geometria leida en ejecucion
+template <int Tamano, int Bloque, int Vias>
+class CacheFija : public Cache {
+public:
+    // numero de conjuntos de la geometria
+    static constexpr int NUM_CONJUNTOS = Tamano / (Bloque * Vias);
+    // geometria con la que se instancia el nucleo
+    using Geometria = GeometriaFija<Bloque, NUM_CONJUNTOS, Vias>;
+
+    // cache vacia con la politica de reemplazo indicada
+    explicit CacheFija(PoliticaReemplazo politica = PoliticaReemplazo::LRU) :
+        Cache(Tamano, Bloque, Vias, politica) {}
+
+    using Cache::acceder;
+    using Cache::accederLote;
+
+    // simula una lectura, devuelve true si fue acierto
+    bool acceder(uint64_t direccion) { return accederDemanda(direccion, TipoAcceso::LECTURA, Geometria{}); }
+    // igual que acceder, pero informa del bloque expulsado en caso de fallo
+    bool acceder(uint64_t direccion, Desalojo& desalojo) {
+        return accederGeometria(direccion, TipoAcceso::LECTURA, desalojo, Geometria{});
+    }
+    // acceso de lectura o escritura
+    bool acceder(uint64_t direccion, TipoAcceso tipo) { return accederDemanda(direccion, tipo, Geometria{}); }
+    // acceso de lectura o escritura informando del bloque expulsado
+    bool acceder(uint64_t direccion, TipoAcceso tipo, Desalojo& desalojo) {
+        return accederGeometria(direccion, tipo, desalojo, Geometria{});
+    }
+    // lote con el tipo de cada acceso (tipos nulo = todo lecturas)
+    std::size_t accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad,
+                            uint8_t* resultados = nullptr) {
+        return accederLoteGeometria(direcciones, tipos, nullptr, cantidad, resultados, Geometria{});
+    }
+    // lote con el tipo y el pc de cada acceso (los pc solo los usa el prefetcher de strides)
+    std::size_t accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, const uint64_t* pcs,
+                            std::size_t cantidad, uint8_t* resultados = nullptr) {
+        return accederLoteGeometria(direcciones, tipos, pcs, cantidad, resultados, Geometria{});
+    }
+    // lote de lecturas
+    std::size_t accederLote(const uint64_t* direcciones, std::size_t cantidad, uint8_t* resultados = nullptr) {
+        return accederLote(direcciones, nullptr, cantidad, resultados);
+    }
+    // version del lote para una traza completa en memoria
+    std::size_t accederLote(const std::vector<uint64_t>& direcciones) {
+        return accederLote(direcciones.data(), direcciones.size());
+    }
+};
+
+// fabrica: construye la cache mas rapida para la geometria y llama a f con ella
+// las geometrias habituales (L1 de 32K/48K, L2 de 256K-2M) usan CacheFija; el resto,
+// o con especializada=false, una Cache
+// f recibe la cache por referencia y debe devolver el mismo tipo en todos los casos
+// lanza std::invalid_argument, como Cache, si la geometria no es valida
+template <typename Funcion>
+decltype(auto) conCacheEspecializada(int tamano, int bloque, int vias, PoliticaReemplazo politica,
+                                     Funcion&& f, bool especializada = true) {
+    if (especializada && bloque == 64) {
+        if (tamano == 32768 && vias == 8) { CacheFija<32768, 64, 8> cache(politica); return f(cache); }
+        if (tamano == 49152 && vias == 12) { CacheFija<49152, 64, 12> cache(politica); return f(cache); }
+        if (tamano == 262144 && vias == 8) { CacheFija<262144, 64, 8> cache(politica); return f(cache); }
+        if (tamano == 262144 && vias == 16) { CacheFija<262144, 64, 16> cache(politica); return f(cache); }
+        if (tamano == 524288 && vias == 8) { CacheFija<524288, 64, 8> cache(politica); return f(cache); }
+        if (tamano == 1048576 && vias == 16) { CacheFija<1048576, 64, 16> cache(politica); return f(cache); }
+        if (tamano == 2097152 && vias == 16) { CacheFija<2097152, 64, 16> cache(politica); return f(cache); }
+    }
+    Cache cache(tamano, bloque, vias, politica);
+    return f(cache);
+}
+
+// fin de la directiva de preprocesador ifndef
+#endif // CACHEFIJA_HPP
@@ -0,0 +1,142 @@
+// incluye la definicion de la clase ClasificadorFallos
+#include "ClasificadorFallos.hpp"
+// para manejo de excepciones
+#include <stdexcept>
+
+// capacidad minima de las tablas hash
+constexpr std::size_t CAPACIDAD_MINIMA_TABLA = 16;
+
+// reserva la tabla vacia con carga maxima de un medio
+void ClasificadorFallos::TablaBloques::reiniciar(std::size_t elementos) {
+    std::size_t capacidad = CAPACIDAD_MINIMA_TABLA;
+    while (capacidad < 2 * elementos) capacidad *= 2;
+    entradas.assign(capacidad, Entrada{0, NINGUNO});
+    mascara = capacidad - 1;
+    ocupadas = 0;
+}
+
+// duplica la capacidad conservando las entradas
+void ClasificadorFallos::TablaBloques::crecer() {
+    std::vector<Entrada> antiguas;
+    antiguas.swap(entradas);
+    reiniciar(antiguas.size());
+    for (const Entrada& entrada : antiguas) {
+        if (entrada.valor != NINGUNO) insertar(entrada.clave, entrada.valor);
+    }
+}
+
+// sondeo lineal hasta la clave o el primer hueco
+uint32_t ClasificadorFallos::TablaBloques::buscar(uint64_t clave) const {
+    for (std::size_t i = inicio(clave); entradas[i].valor != NINGUNO; i = (i + 1) & mascara) {
+        if (entradas[i].clave == clave) return entradas[i].valor;
+    }
+    return NINGUNO;
+}
+
+// inserta en el primer hueco si la clave no estaba
+bool ClasificadorFallos::TablaBloques::insertar(uint64_t clave, uint32_t valor) {
+    std::size_t i = inicio(clave);
+    for (; entradas[i].valor != NINGUNO; i = (i + 1) & mascara) {
+        if (entradas[i].clave == clave) return false;
+    }
+    entradas[i] = Entrada{clave, valor};
+    // por encima de media carga el sondeo se alarga: duplica
+    if (++ocupadas * 2 > mascara + 1) crecer();
+    return true;
+}
+
+// borrado con desplazamiento hacia atras: las entradas que siguen al hueco y podrian
+// ocuparlo se mueven, asi ninguna busqueda se corta antes de tiempo
+void ClasificadorFallos::TablaBloques::borrar(uint64_t clave) {
+    std::size_t hueco = inicio(clave);
+    while (entradas[hueco].clave != clave || entradas[hueco].valor == NINGUNO) hueco = (hueco + 1) & mascara;
+
+    for (std::size_t i = (hueco + 1) & mascara; entradas[i].valor != NINGUNO; i = (i + 1) & mascara) {
+        // la entrada i puede ir al hueco si su posicion inicial no esta entre el hueco e i
+        const std::size_t deseada = inicio(entradas[i].clave);
+        if (((i - deseada) & mascara) >= ((i - hueco) & mascara)) {
+            entradas[hueco] = entradas[i];
+            hueco = i;
+        }
+    }
+    entradas[hueco].valor = NINGUNO;
+    --ocupadas;
+}
+
+// clasificador inactivo: no reserva memoria
+ClasificadorFallos::ClasificadorFallos() :
+    activa(false), cabeza(NINGUNO), cola(NINGUNO), lineasOcupadas(0) {}
+
+// clasificador con una cache en sombra de numLineas lineas
+ClasificadorFallos::ClasificadorFallos(int numLineas) :
+    activa(true), cabeza(NINGUNO), cola(NINGUNO), lineasOcupadas(0) {
+
+    if (numLineas <= 0) {
+        throw std::invalid_argument("Número de líneas debe ser positivo");
+    }
+    vistos.reiniciar(static_cast<std::size_t>(numLineas));
+    lineaDeBloque.reiniciar(static_cast<std::size_t>(numLineas));
+    lineas.assign(numLineas, LineaSombra{0, NINGUNO, NINGUNO});
+}
+
+// quita la linea de la lista
+void ClasificadorFallos::desenlazar(uint32_t linea) {
+    const LineaSombra& l = lineas[linea];
+    if (l.anterior != NINGUNO) lineas[l.anterior].siguiente = l.siguiente;
+    else cabeza = l.siguiente;
+    if (l.siguiente != NINGUNO) lineas[l.siguiente].anterior = l.anterior;
+    else cola = l.anterior;
+}
+
+// coloca la linea como la mas reciente
+void ClasificadorFallos::enlazarEnCabeza(uint32_t linea) {
+    lineas[linea].anterior = NINGUNO;
+    lineas[linea].siguiente = cabeza;
+    if (cabeza != NINGUNO) lineas[cabeza].anterior = linea;
+    cabeza = linea;
+    if (cola == NINGUNO) cola = linea;
+}
+
+// acceso LRU totalmente asociativo en O(1)
+bool ClasificadorFallos::accederSombra(uint64_t bloque, bool asignar) {
+    const uint32_t presente = lineaDeBloque.buscar(bloque);
+    if (presente != NINGUNO) {
+        // acierto: pasa a ser la mas reciente
+        if (presente != cabeza) {
+            desenlazar(presente);
+            enlazarEnCabeza(presente);
+        }
+        return true;
+    }
+    if (!asignar) return false;
+
+    // fallo: una linea libre o la menos reciente
+    uint32_t linea;
+    if (lineasOcupadas < lineas.size()) {
+        linea = lineasOcupadas++;
+    } else {
+        linea = cola;
+        lineaDeBloque.borrar(lineas[linea].bloque);
+        desenlazar(linea);
+    }
+    lineas[linea].bloque = bloque;
+    lineaDeBloque.insertar(bloque, linea);
+    enlazarEnCabeza(linea);
+    return false;
+}
+// clasifica el acceso si la cache real fallo
+void ClasificadorFallos::observar(uint64_t bloque, bool acierto, bool asignar) {
+    const bool aciertoSombra = accederSombra(bloque, asignar);
+    // un bloque presente en la sombra ya se habia visto: solo se consulta el
+    // conjunto de vistos cuando la sombra falla
+    const bool primerUso = !aciertoSombra && vistos.insertar(bloque, 0);
+    if (acierto) return;
+
+    if (primerUso) {
+        clasificacion.obligatorios++;
+    } else if (!aciertoSombra) {
+        clasificacion.capacidad++;
+    } else {
+        clasificacion.conflicto++;
+    }
+}
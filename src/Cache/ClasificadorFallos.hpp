@@ -0,0 +1,117 @@
+// directiva para evitar inclusiones multiples
+#ifndef CLASIFICADORFALLOS_HPP
+#define CLASIFICADORFALLOS_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+
+// fallos de demanda separados por causa (las 3C de Hill)
+struct ClasificacionFallos {
+    // primer uso del bloque: fallan en cualquier cache
+    uint64_t obligatorios = 0;
+    // tambien fallan en una cache totalmente asociativa LRU de la misma capacidad
+    uint64_t capacidad = 0;
+    // solo fallan por el reparto en conjuntos: la cache totalmente asociativa acierta
+    uint64_t conflicto = 0;
+
+    // total de fallos clasificados
+    uint64_t total() const { return obligatorios + capacidad + conflicto; }
+};
+
+// clasifica los fallos de una cache en obligatorios, de capacidad y de conflicto
+// guarda los bloques ya vistos en un conjunto hash compacto y simula en sombra una
+// cache totalmente asociativa LRU con tantas lineas como la cache real; el coste por
+// acceso es O(1): una busqueda en la tabla hash y un movimiento en una lista enlazada
+class ClasificadorFallos {
+private:
+    // indice sin valor (hueco libre en la tabla, fin de la lista)
+    static constexpr uint32_t NINGUNO = UINT32_MAX;
+
+    // tabla hash abierta de numero de bloque -> valor de 32 bits, con sondeo lineal
+    // el borrado desplaza hacia atras las entradas siguientes, sin marcas de borrado
+    class TablaBloques {
+    private:
+        // clave y valor juntos: cada sondeo toca una sola linea del anfitrion
+        struct Entrada {
+            uint64_t clave;
+            // NINGUNO marca hueco libre
+            uint32_t valor;
+        };
+        std::vector<Entrada> entradas;
+        // capacidad - 1 (la capacidad es potencia de dos)
+        std::size_t mascara = 0;
+        std::size_t ocupadas = 0;
+
+        // posicion inicial de la clave
+        std::size_t inicio(uint64_t clave) const {
+            return static_cast<std::size_t>((clave * 0x9E3779B97F4A7C15ull) >> 32) & mascara;
+        }
+        // duplica la capacidad y recoloca las entradas
+        void crecer();
+
+    public:
+        // reserva espacio para al menos elementos entradas con la tabla a medio llenar
+        void reiniciar(std::size_t elementos);
+        // valor de la clave o NINGUNO si no esta
+        uint32_t buscar(uint64_t clave) const;
+        // inserta la clave si no estaba; devuelve true si era nueva
+        bool insertar(uint64_t clave, uint32_t valor);
+        // borra una clave presente
+        void borrar(uint64_t clave);
+        std::size_t size() const { return ocupadas; }
+    };
+
+    // true si la cache clasifica sus fallos
+    bool activa;
+    // bloques usados alguna vez por la demanda
+    TablaBloques vistos;
+
+    // linea de la cache en sombra con sus enlaces de la lista LRU
+    struct LineaSombra {
+        uint64_t bloque;
+        uint32_t anterior;
+        uint32_t siguiente;
+    };
+
+    // cache en sombra: lineas en un arreglo enlazado por indices, de la mas
+    // reciente (cabeza) a la menos reciente (cola)
+    TablaBloques lineaDeBloque;
+    std::vector<LineaSombra> lineas;
+    uint32_t cabeza;
+    uint32_t cola;
+    // lineas ocupadas (hasta llenarse se usan en orden)
+    uint32_t lineasOcupadas;
+
+    ClasificacionFallos clasificacion;
+
+    // saca una linea de la lista
+    void desenlazar(uint32_t linea);
+    // pone una linea en la cabeza de la lista
+    void enlazarEnCabeza(uint32_t linea);
+    // acceso a la cache en sombra; asignar=false no trae el bloque si falla
+    bool accederSombra(uint64_t bloque, bool asignar);
+
+public:
+    // clasificador inactivo
+    ClasificadorFallos();
+    // clasificador activo para una cache de numLineas lineas
+    // lanza std::invalid_argument si numLineas no es positivo
+    explicit ClasificadorFallos(int numLineas);
+
+    // observa un acceso de demanda ya resuelto por la cache real
+    // asignar=false para los fallos que no traen el bloque (escritura sin asignacion)
+    void observar(uint64_t bloque, bool acierto, bool asignar = true);
+
+    // metodos de consulta
+    bool activo() const { return activa; }
+    const ClasificacionFallos& getClasificacion() const { return clasificacion; }
+    // bloques distintos usados por la demanda
+    uint64_t getBloquesDistintos() const { return vistos.size(); }
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // CLASIFICADORFALLOS_HPP
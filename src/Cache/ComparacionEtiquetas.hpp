@@ -0,0 +1,62 @@
+#ifndef COMPARACIONETIQUETAS_HPP
+#define COMPARACIONETIQUETAS_HPP
+
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+
+// intrinsecos x86 cuando el compilador los habilita (-march=native)
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// comparacion de una etiqueta contra todas las vias de un conjunto
+// el resultado es un mapa de bits (bit v = la via v coincide); el llamador
+// lo combina con el mapa de validez, que tambien descarta los bits >= vias
+
+// elementos extra que deben existir tras el ultimo conjunto, porque las
+// versiones vectoriales leen grupos completos aunque el conjunto sea mas corto
+constexpr int RELLENO_ETIQUETAS = 8;
+
+// version escalar, referencia para las vectoriales
+inline uint64_t coincidenciasEscalar(const uint64_t* etiquetas, uint64_t etiqueta, int vias) {
+    uint64_t coincidencias = 0;
+    for (int via = 0; via < vias; ++via) {
+        coincidencias |= static_cast<uint64_t>(etiquetas[via] == etiqueta) << via;
+    }
+    return coincidencias;
+}
+
+#if defined(__AVX2__)
+// version avx2: 4 vias de 64 bits por comparacion y movemask
+inline uint64_t coincidenciasSIMD(const uint64_t* etiquetas, uint64_t etiqueta, int vias) {
+    const __m256i buscada = _mm256_set1_epi64x(static_cast<long long>(etiqueta));
+    uint64_t coincidencias = 0;
+    for (int via = 0; via < vias; via += 4) {
+        const __m256i grupo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(etiquetas + via));
+        const __m256d iguales = _mm256_castsi256_pd(_mm256_cmpeq_epi64(grupo, buscada));
+        coincidencias |= static_cast<uint64_t>(_mm256_movemask_pd(iguales)) << via;
+    }
+    return coincidencias;
+}
+#elif defined(__SSE2__)
+// version sse2: 2 vias de 64 bits por comparacion y movemask
+// sse2 solo compara en 32 bits: una via coincide si coinciden sus dos mitades
+inline uint64_t coincidenciasSIMD(const uint64_t* etiquetas, uint64_t etiqueta, int vias) {
+    const __m128i buscada = _mm_set1_epi64x(static_cast<long long>(etiqueta));
+    uint64_t coincidencias = 0;
+    for (int via = 0; via < vias; via += 2) {
+        const __m128i grupo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(etiquetas + via));
+        const __m128i mitades = _mm_cmpeq_epi32(grupo, buscada);
+        const __m128i iguales = _mm_and_si128(mitades, _mm_shuffle_epi32(mitades, _MM_SHUFFLE(2, 3, 0, 1)));
+        coincidencias |= static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(iguales))) << via;
+    }
+    return coincidencias;
+}
+#else
+// sin extensiones vectoriales se usa la version escalar
+inline uint64_t coincidenciasSIMD(const uint64_t* etiquetas, uint64_t etiqueta, int vias) {
+    return coincidenciasEscalar(etiquetas, etiqueta, vias);
+}
+#endif
+
+#endif // COMPARACIONETIQUETAS_HPP
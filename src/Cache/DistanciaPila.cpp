@@ -0,0 +1,184 @@
+// incluye la definicion de la clase DistanciaPila
+#include "DistanciaPila.hpp"
+// para entrada/salida por consola
+#include <iostream>
+// para manejo de excepciones
+#include <stdexcept>
+// para std::max
+#include <algorithm>
+// para los nombres de las geometrias
+#include <string>
+
+// posiciones minimas de la pila de un conjunto
+constexpr uint32_t CAPACIDAD_MINIMA_PILA = 16;
+
+// comprueba si un valor positivo es potencia de dos
+static bool esPotenciaDeDos(int valor) {
+    return valor > 0 && (valor & (valor - 1)) == 0;
+}
+
+// constructor: valida y prepara una pila por conjunto de cada geometria
+DistanciaPila::DistanciaPila(int tamanoBloque, const std::vector<int>& numConjuntos) :
+    desplazamientoBloque(0), tamanoBloque(tamanoBloque), accesos(0) {
+
+    if (!esPotenciaDeDos(tamanoBloque)) {
+        throw std::invalid_argument("Tamaño de bloque debe ser potencia de dos");
+    }
+    if (numConjuntos.empty()) {
+        throw std::invalid_argument("Se necesita al menos un número de conjuntos");
+    }
+    while ((1 << desplazamientoBloque) < tamanoBloque) ++desplazamientoBloque;
+
+    for (int conjuntos : numConjuntos) {
+        if (!esPotenciaDeDos(conjuntos)) {
+            throw std::invalid_argument("Número de conjuntos debe ser potencia de dos");
+        }
+        Geometria geometria;
+        geometria.numConjuntos = conjuntos;
+        geometria.mascaraConjunto = static_cast<uint32_t>(conjuntos - 1);
+        geometria.conjuntos.resize(conjuntos);
+        geometrias.push_back(std::move(geometria));
+    }
+}
+
+// renumera en orden las posiciones vivas y reconstruye el arbol
+// la nueva capacidad deja al menos tantas posiciones libres como vivas,
+// de modo que el coste se amortiza entre los accesos siguientes
+void DistanciaPila::compactar(Geometria& geometria, PilaConjunto& pila) {
+    const uint32_t capacidad = std::max(CAPACIDAD_MINIMA_PILA, 2 * (pila.vivos + 1));
+    std::vector<uint32_t> ocupante(capacidad + 1, SIN_BLOQUE);
+
+    // las posiciones vivas conservan su orden relativo (el orden LRU)
+    uint32_t siguiente = 0;
+    for (uint32_t posicion = 1; posicion <= pila.instante; ++posicion) {
+        const uint32_t bloque = pila.ocupante[posicion];
+        if (bloque == SIN_BLOQUE) continue;
+        ocupante[++siguiente] = bloque;
+        geometria.ultimaPosicion[bloque] = siguiente;
+    }
+
+    // construccion lineal del arbol con todas las posiciones 1..vivos marcadas
+    pila.arbol.assign(capacidad + 1, 0);
+    // el recorrido llega hasta la capacidad para que las sumas suban hasta la raiz
+    for (uint32_t posicion = 1; posicion <= capacidad; ++posicion) {
+        if (posicion <= siguiente) pila.arbol[posicion] += 1;
+        const uint32_t padre = posicion + (posicion & (~posicion + 1));
+        if (padre <= capacidad) pila.arbol[padre] += pila.arbol[posicion];
+    }
+    pila.ocupante = std::move(ocupante);
+    pila.instante = siguiente;
+}
+
+// distancia de pila y actualizacion de la pila del conjunto
+int64_t DistanciaPila::moverACima(Geometria& geometria, uint32_t conjunto, uint32_t identificador) {
+    PilaConjunto& pila = geometria.conjuntos[conjunto];
+    const uint32_t anterior = geometria.ultimaPosicion[identificador];
+    int64_t distancia = -1;
+
+    if (anterior != 0) {
+        // bloques distintos usados despues = posiciones vivas por encima de la anterior
+        uint32_t hastaAnterior = 0;
+        for (uint32_t i = anterior; i > 0; i &= i - 1) hastaAnterior += pila.arbol[i];
+        distancia = pila.vivos - hastaAnterior;
+        // el bloque deja su posicion antigua
+        const uint32_t capacidad = static_cast<uint32_t>(pila.arbol.size() - 1);
+        for (uint32_t i = anterior; i <= capacidad; i += i & (~i + 1)) pila.arbol[i] -= 1;
+        pila.ocupante[anterior] = SIN_BLOQUE;
+        pila.vivos--;
+    }
+
+    // ocupa una posicion nueva en la cima
+    if (pila.instante + 1 >= pila.arbol.size()) compactar(geometria, pila);
+    const uint32_t posicion = ++pila.instante;
+    const uint32_t capacidad = static_cast<uint32_t>(pila.arbol.size() - 1);
+    for (uint32_t i = posicion; i <= capacidad; i += i & (~i + 1)) pila.arbol[i] += 1;
+    pila.ocupante[posicion] = identificador;
+    pila.vivos++;
+    geometria.ultimaPosicion[identificador] = posicion;
+    return distancia;
+}
+
+// analiza un acceso en todas las geometrias
+void DistanciaPila::acceder(uint64_t direccion) {
+    const uint64_t bloque = direccion >> desplazamientoBloque;
+    ++accesos;
+
+    // identificador denso del bloque; los nuevos se añaden a todas las geometrias
+    const auto insercion = identificadores.emplace(bloque, static_cast<uint32_t>(identificadores.size()));
+    const uint32_t identificador = insercion.first->second;
+    if (insercion.second) {
+        for (Geometria& geometria : geometrias) geometria.ultimaPosicion.push_back(0);
+    }
+
+    for (Geometria& geometria : geometrias) {
+        const uint32_t conjunto = static_cast<uint32_t>(bloque) & geometria.mascaraConjunto;
+        const int64_t distancia = moverACima(geometria, conjunto, identificador);
+        // los accesos frios fallan en cualquier cache y no entran al histograma
+        if (distancia < 0) continue;
+        if (static_cast<std::size_t>(distancia) >= geometria.histograma.size()) {
+            geometria.histograma.resize(static_cast<std::size_t>(distancia) + 1, 0);
+        }
+        geometria.histograma[distancia]++;
+    }
+}
+
+// analiza una secuencia de accesos
+void DistanciaPila::accederLote(const uint64_t* direcciones, std::size_t cantidad) {
+    identificadores.reserve(identificadores.size() + cantidad / 4);
+    for (std::size_t i = 0; i < cantidad; ++i) {
+        acceder(direcciones[i]);
+    }
+}
+
+// fallos de una cache: frios mas los accesos con distancia >= vias
+uint64_t DistanciaPila::fallos(std::size_t geometria, int vias) const {
+    const std::vector<uint64_t>& histograma = geometrias.at(geometria).histograma;
+    uint64_t resultado = getFallosFrios();
+    for (std::size_t distancia = static_cast<std::size_t>(std::max(vias, 0)); distancia < histograma.size();
+         ++distancia) {
+        resultado += histograma[distancia];
+    }
+    return resultado;
+}
+
+// curva completa a partir de sumas acumuladas del histograma
+std::vector<PuntoCurvaFallos> DistanciaPila::curvaFallos(int viasMaximas) const {
+    std::vector<PuntoCurvaFallos> curva;
+    for (const Geometria& geometria : geometrias) {
+        // fallos con 0 vias: todos los accesos
+        uint64_t fallosVias = accesos;
+        for (int vias = 1; vias <= viasMaximas; ++vias) {
+            // con una via mas aciertan tambien los accesos de distancia vias-1
+            if (static_cast<std::size_t>(vias - 1) < geometria.histograma.size()) {
+                fallosVias -= geometria.histograma[vias - 1];
+            }
+            PuntoCurvaFallos punto;
+            punto.numConjuntos = geometria.numConjuntos;
+            punto.vias = vias;
+            punto.tamano = static_cast<uint64_t>(geometria.numConjuntos) * vias * tamanoBloque;
+            punto.fallos = fallosVias;
+            punto.tasaFallos = accesos > 0 ? static_cast<double>(fallosVias) / accesos : 0.0;
+            curva.push_back(punto);
+        }
+    }
+    return curva;
+}
+
+// muestra la curva de fallos
+void DistanciaPila::imprimirCurva(int viasMaximas) const {
+    std::cout << "\n=== Curva de fallos LRU (bloque de " << tamanoBloque << " bytes) ===\n";
+    std::cout << "Accesos: " << accesos << "  Bloques distintos: " << getFallosFrios() << "\n";
+    for (std::size_t g = 0; g < geometrias.size(); ++g) {
+        std::cout << (geometrias[g].numConjuntos == 1 ? std::string("Totalmente asociativa")
+                                                      : std::to_string(geometrias[g].numConjuntos) + " conjuntos")
+                  << ":\n";
+        for (int vias = 1; vias <= viasMaximas; vias *= 2) {
+            const uint64_t fallosVias = fallos(g, vias);
+            std::cout << "  " << vias << " vias, "
+                      << static_cast<uint64_t>(geometrias[g].numConjuntos) * vias * tamanoBloque << " bytes: "
+                      << (accesos > 0 ? fallosVias * 100.0 / accesos : 0.0) << "% fallos\n";
+            // con mas vias la tasa ya no baja de los fallos frios
+            if (static_cast<std::size_t>(vias) >= geometrias[g].histograma.size()) break;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+// directiva para evitar inclusiones multiples
+#ifndef DISTANCIAPILA_HPP
+#define DISTANCIAPILA_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion para la tabla de bloques vistos
+#include <unordered_map>
+
+// un punto de la curva de fallos: una cache LRU concreta
+struct PuntoCurvaFallos {
+    // numero de conjuntos (1 = totalmente asociativa)
+    int numConjuntos;
+    // vias por conjunto
+    int vias;
+    // capacidad en bytes
+    uint64_t tamano;
+    // fallos de demanda, incluidos los frios
+    uint64_t fallos;
+    // fallos / accesos
+    double tasaFallos;
+};
+
+// distancias de pila de Mattson: en una sola pasada por la traza obtiene los
+// fallos de todas las caches LRU con el mismo tamaño de bloque y numero de
+// conjuntos, sea cual sea su asociatividad. Un acceso acierta en una cache de
+// W vias si desde el uso anterior de su bloque se han usado menos de W bloques
+// distintos del mismo conjunto (su distancia de pila)
+//
+// cada conjunto cuenta esos bloques con un arbol de Fenwick indexado por el
+// instante de su ultimo uso, asi cada acceso cuesta O(log n) y no O(n)
+class DistanciaPila {
+private:
+    // marca sin ocupante en la pila de un conjunto
+    static constexpr uint32_t SIN_BLOQUE = UINT32_MAX;
+
+    // pila LRU de un conjunto en forma de arbol de Fenwick
+    // la posicion p vale 1 si el bloque que se uso en el instante local p no se ha vuelto a usar
+    struct PilaConjunto {
+        // sumas parciales del arbol (indices desde 1)
+        std::vector<uint32_t> arbol;
+        // bloque cuyo ultimo uso ocupa cada posicion, para compactar
+        std::vector<uint32_t> ocupante;
+        // ultima posicion usada
+        uint32_t instante = 0;
+        // posiciones marcadas (bloques distintos vistos en el conjunto)
+        uint32_t vivos = 0;
+    };
+
+    // analisis de un numero de conjuntos
+    struct Geometria {
+        int numConjuntos;
+        uint32_t mascaraConjunto;
+        std::vector<PilaConjunto> conjuntos;
+        // posicion del ultimo uso de cada bloque en la pila de su conjunto (0 = nunca usado)
+        std::vector<uint32_t> ultimaPosicion;
+        // histograma[d] = accesos con distancia de pila d
+        std::vector<uint64_t> histograma;
+    };
+
+    // log2 del tamaño de bloque
+    uint32_t desplazamientoBloque;
+    int tamanoBloque;
+    // numero de bloque -> identificador denso, compartido por todas las geometrias
+    std::unordered_map<uint64_t, uint32_t> identificadores;
+    std::vector<Geometria> geometrias;
+    // accesos analizados
+    uint64_t accesos;
+
+    // distancia de pila del bloque en su conjunto, y lo pasa a la cima
+    // devuelve -1 si el bloque no se habia usado nunca
+    static int64_t moverACima(Geometria& geometria, uint32_t conjunto, uint32_t identificador);
+    // renumera las posiciones vivas de un conjunto cuando su arbol se llena
+    static void compactar(Geometria& geometria, PilaConjunto& pila);
+
+public:
+    // tamaño de bloque y cada numero de conjuntos deben ser potencias de dos
+    // numConjuntos = {1} analiza solo caches totalmente asociativas
+    // lanza std::invalid_argument si algun parametro no es valido
+    DistanciaPila(int tamanoBloque, const std::vector<int>& numConjuntos = {1});
+
+    // analiza un acceso
+    void acceder(uint64_t direccion);
+    // analiza una secuencia de accesos
+    void accederLote(const uint64_t* direcciones, std::size_t cantidad);
+    // version del lote para una traza completa en memoria
+    void accederLote(const std::vector<uint64_t>& direcciones) {
+        accederLote(direcciones.data(), direcciones.size());
+    }
+
+    // fallos de la cache LRU con los conjuntos de la geometria indicada y vias vias
+    // coincide con los de Cache(conjuntos * vias * bloque, bloque, vias, LRU) sobre la misma traza
+    uint64_t fallos(std::size_t geometria, int vias) const;
+    // puntos de 1 a viasMaximas vias de cada geometria, en orden de geometria y vias
+    std::vector<PuntoCurvaFallos> curvaFallos(int viasMaximas) const;
+    // muestra la curva en potencias de dos de vias hasta viasMaximas
+    void imprimirCurva(int viasMaximas) const;
+
+    // metodos de consulta
+    uint64_t getAccesos() const { return accesos; }
+    // bloques distintos vistos: fallos frios de cualquier cache
+    uint64_t getFallosFrios() const { return identificadores.size(); }
+    std::size_t getNumGeometrias() const { return geometrias.size(); }
+    int getNumConjuntos(std::size_t geometria) const { return geometrias[geometria].numConjuntos; }
+    // histograma de distancias de pila de una geometria (sin los accesos frios)
+    const std::vector<uint64_t>& getHistograma(std::size_t geometria) const {
+        return geometrias[geometria].histograma;
+    }
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // DISTANCIAPILA_HPP
@@ -0,0 +1,77 @@
+// directiva para evitar inclusiones multiples
+#ifndef INDICECONJUNTO_HPP
+#define INDICECONJUNTO_HPP
+
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+
+// funcion que reparte los numeros de bloque entre los conjuntos, se elige al construir la Cache
+enum class FuncionIndice {
+    MASCARA,  // bits bajos del numero de bloque (requiere conjuntos potencia de dos)
+    MODULO,   // numero de bloque modulo el numero de conjuntos (cualquier numero de conjuntos)
+    XOR,      // pliega con xor los bits altos sobre los bajos (requiere conjuntos potencia de dos)
+    PRIMO,    // modulo el mayor primo que no supera los conjuntos (los restantes no se usan)
+    SESGADA   // asociativa sesgada: un hash distinto por via (solo con LRU)
+};
+
+// devuelve el nombre legible de una funcion de indice
+inline const char* nombreFuncionIndice(FuncionIndice indice) {
+    switch (indice) {
+        case FuncionIndice::MASCARA: return "mascara";
+        case FuncionIndice::MODULO:  return "modulo";
+        case FuncionIndice::XOR:     return "xor";
+        case FuncionIndice::PRIMO:   return "primo";
+        case FuncionIndice::SESGADA: return "sesgada";
+    }
+    return "desconocida";
+}
+
+// resto de la division por un divisor fijo sin instruccion de division (fastmod de Lemire):
+// con M = ceil(2^128 / d), el resto de a entre d son los 64 bits altos de (M * a mod 2^128) * d
+class ModuloRapido {
+    unsigned __int128 constante;
+    uint32_t divisor;
+
+public:
+    // divisor 1 (todo resto es cero)
+    ModuloRapido() : constante(0), divisor(1) {}
+    explicit ModuloRapido(uint32_t divisor) :
+        constante(~static_cast<unsigned __int128>(0) / divisor + 1), divisor(divisor) {}
+
+    // resto de valor entre el divisor
+    uint32_t operator()(uint64_t valor) const {
+        const unsigned __int128 fraccion = constante * valor;
+        // (fraccion * divisor) >> 128 en dos productos de 64x64 bits
+        const unsigned __int128 bajo = static_cast<unsigned __int128>(static_cast<uint64_t>(fraccion)) * divisor;
+        const unsigned __int128 alto = static_cast<unsigned __int128>(static_cast<uint64_t>(fraccion >> 64)) * divisor;
+        return static_cast<uint32_t>((alto + (bajo >> 64)) >> 64);
+    }
+    uint32_t getDivisor() const { return divisor; }
+};
+
+// mayor primo que no supera valor (1 si valor < 2)
+inline uint32_t primoMenorOIgual(uint32_t valor) {
+    for (uint32_t candidato = valor; candidato >= 2; --candidato) {
+        bool primo = true;
+        for (uint32_t divisor = 2; divisor <= candidato / divisor; ++divisor) {
+            if (candidato % divisor == 0) {
+                primo = false;
+                break;
+            }
+        }
+        if (primo) return candidato;
+    }
+    return 1;
+}
+
+// conjunto del bloque en la via dada de una cache asociativa sesgada: mezcla el numero
+// de bloque con un multiplicador impar propio de la via y lleva los 32 bits altos a
+// [0, conjuntos) con un producto y un desplazamiento (valido para cualquier numero de conjuntos)
+inline uint32_t conjuntoSesgado(uint64_t bloque, uint32_t via, uint32_t conjuntos) {
+    const uint64_t multiplicador = (0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull * via) | 1;
+    const uint64_t mezcla = (bloque ^ (bloque >> 31)) * multiplicador;
+    return static_cast<uint32_t>(((mezcla >> 32) * conjuntos) >> 32);
+}
+
+// fin de la directiva de preprocesador ifndef
+#endif // INDICECONJUNTO_HPP
@@ -0,0 +1,98 @@
+// incluye la definicion del informe
+#include "InformeCache.hpp"
+// para contenedor vector
+#include <vector>
+// para la precision de los numeros reales
+#include <limits>
+// para convertir reales a texto
+#include <sstream>
+
+// campo del informe ya convertido a texto
+struct CampoInforme {
+    const char* nombre;
+    std::string valor;
+    // true si el valor es texto y va entre comillas en JSON
+    bool texto;
+};
+
+// escapa comillas y barras invertidas (y comillas dobles en CSV)
+static std::string escapar(const std::string& valor, FormatoInforme formato) {
+    std::string resultado;
+    for (char c : valor) {
+        if (c == '"') resultado += formato == FormatoInforme::CSV ? '"' : '\\';
+        else if (c == '\\' && formato == FormatoInforme::JSON) resultado += '\\';
+        resultado += c;
+    }
+    return resultado;
+}
+
+// convierte un real sin perder precision
+static std::string real(double valor) {
+    std::ostringstream texto;
+    texto.precision(std::numeric_limits<double>::max_digits10);
+    texto << valor;
+    return texto.str();
+}
+
+// escribe el informe de la cache en JSON o CSV
+void escribirInforme(std::ostream& salida, const ResumenCache& cache, const EjecucionSimulacion& ejecucion,
+                     FormatoInforme formato, bool cabeceraCsv) {
+    const ClasificacionFallos& clases = cache.clases;
+    const EstadisticasPrefetch& prefetch = cache.prefetch;
+
+    // mismo orden de campos en los dos formatos
+    const std::vector<CampoInforme> campos = {
+        {"traza", ejecucion.traza, true},
+        {"tamano", std::to_string(cache.tamano), false},
+        {"bloque", std::to_string(cache.bloque), false},
+        {"vias", std::to_string(cache.vias), false},
+        {"conjuntos", std::to_string(cache.conjuntos), false},
+        {"politica", nombrePoliticaReemplazo(cache.politica), true},
+        {"indice", nombreFuncionIndice(cache.indice), true},
+        {"escritura", cache.escritura == PoliticaEscritura::WRITE_BACK ? "write-back" : "write-through", true},
+        {"asignar_en_escritura", cache.asignarEnEscritura ? "true" : "false", false},
+        {"prefetch", nombreTipoPrefetcher(cache.prefetcher), true},
+        {"accesos", std::to_string(cache.aciertos + cache.fallos), false},
+        {"aciertos", std::to_string(cache.aciertos), false},
+        {"fallos", std::to_string(cache.fallos), false},
+        {"tasa_aciertos", real(cache.tasaAciertos), false},
+        {"fallos_obligatorios", std::to_string(clases.obligatorios), false},
+        {"fallos_capacidad", std::to_string(clases.capacidad), false},
+        {"fallos_conflicto", std::to_string(clases.conflicto), false},
+        {"escrituras", std::to_string(cache.trafico.escrituras), false},
+        {"bytes_leidos", std::to_string(cache.bytesLeidos), false},
+        {"bytes_escritos", std::to_string(cache.bytesEscritos), false},
+        {"prefetch_emitidos", std::to_string(prefetch.emitidos), false},
+        {"prefetch_utiles", std::to_string(prefetch.utiles), false},
+        {"prefetch_tardios", std::to_string(prefetch.tardios), false},
+        {"muestreo", std::to_string(cache.factorMuestreo), false},
+        {"accesos_estimados", std::to_string(cache.estimacion.accesosTotales), false},
+        {"tasa_aciertos_estimada", real(cache.estimacion.tasaAciertos), false},
+        {"margen_ic95", real(cache.estimacion.margen), false},
+        {"tiempo_ms", real(ejecucion.milisegundos), false}
+    };
+
+    if (formato == FormatoInforme::CSV) {
+        if (cabeceraCsv) {
+            for (std::size_t i = 0; i < campos.size(); ++i) {
+                salida << (i > 0 ? "," : "") << campos[i].nombre;
+            }
+            salida << '\n';
+        }
+        for (std::size_t i = 0; i < campos.size(); ++i) {
+            salida << (i > 0 ? "," : "");
+            if (campos[i].texto) salida << '"' << escapar(campos[i].valor, formato) << '"';
+            else salida << campos[i].valor;
+        }
+        salida << '\n';
+        return;
+    }
+
+    salida << "{";
+    for (std::size_t i = 0; i < campos.size(); ++i) {
+        salida << (i > 0 ? ", " : "") << '"' << campos[i].nombre << "\": ";
+        if (campos[i].texto) salida << '"' << escapar(campos[i].valor, formato) << '"';
+        else salida << campos[i].valor;
+    }
+    salida << "}\n";
+}
@@ -0,0 +1,90 @@
+// directiva para evitar inclusiones multiples
+#ifndef INFORMECACHE_HPP
+#define INFORMECACHE_HPP
+
+// inclusion para el flujo de salida
+#include <ostream>
+// inclusion para el nombre de la traza
+#include <string>
+// inclusion de la cache cuyos contadores se escriben
+#include "Cache.hpp"
+
+// formato del informe de una simulacion
+enum class FormatoInforme {
+    JSON,  // un objeto por simulacion
+    CSV    // una fila por simulacion, con cabecera opcional para acumular barridos
+};
+
+// datos de la ejecucion que no guarda la cache
+struct EjecucionSimulacion {
+    // ruta de la traza simulada
+    std::string traza;
+    // tiempo de simulacion en milisegundos
+    double milisegundos = 0.0;
+};
+
+// geometria, politicas y contadores de una cache ya simulada
+// (de una Cache o de una CacheFija, que es una Cache con la geometria fija)
+struct ResumenCache {
+    int tamano = 0;
+    int bloque = 0;
+    int vias = 0;
+    int conjuntos = 0;
+    PoliticaReemplazo politica = PoliticaReemplazo::LRU;
+    FuncionIndice indice = FuncionIndice::MASCARA;
+    PoliticaEscritura escritura = PoliticaEscritura::WRITE_BACK;
+    bool asignarEnEscritura = true;
+    TipoPrefetcher prefetcher = TipoPrefetcher::NINGUNO;
+    uint64_t aciertos = 0;
+    uint64_t fallos = 0;
+    double tasaAciertos = 0.0;
+    ClasificacionFallos clases;
+    TraficoCache trafico;
+    uint64_t bytesLeidos = 0;
+    uint64_t bytesEscritos = 0;
+    EstadisticasPrefetch prefetch;
+    int factorMuestreo = 1;
+    EstimacionMuestreo estimacion;
+};
+
+// copia los datos del informe desde cualquier cache con la interfaz de Cache
+template <typename TipoCache>
+ResumenCache resumirCache(const TipoCache& cache) {
+    ResumenCache resumen;
+    resumen.tamano = cache.getTamano();
+    resumen.bloque = cache.getTamanoBloque();
+    resumen.vias = cache.getAsociatividad();
+    resumen.conjuntos = cache.calcularNumConjuntos();
+    resumen.politica = cache.getPolitica();
+    resumen.indice = cache.getFuncionIndice();
+    resumen.escritura = cache.getPoliticaEscritura();
+    resumen.asignarEnEscritura = cache.getAsignarEnEscritura();
+    resumen.prefetcher = cache.getConfiguracionPrefetch().tipo;
+    resumen.aciertos = cache.getAciertos();
+    resumen.fallos = cache.getFallos();
+    resumen.tasaAciertos = cache.getTasaAciertos();
+    resumen.clases = cache.getClasificacionFallos();
+    resumen.trafico = cache.getTrafico();
+    resumen.bytesLeidos = cache.getBytesLeidos();
+    resumen.bytesEscritos = cache.getBytesEscritos();
+    resumen.prefetch = cache.getEstadisticasPrefetch();
+    resumen.factorMuestreo = cache.getFactorMuestreo();
+    resumen.estimacion = cache.estimarMuestreo();
+    return resumen;
+}
+
+// escribe la geometria, las politicas y los contadores de la cache
+// (aciertos, fallos por causa si hay clasificacion, trafico, prefetch y, con
+// muestreo, la tasa extrapolada con su intervalo de confianza del 95%)
+void escribirInforme(std::ostream& salida, const ResumenCache& cache, const EjecucionSimulacion& ejecucion,
+                     FormatoInforme formato, bool cabeceraCsv = true);
+
+// version para Cache, CacheFija o cualquier cache con la misma interfaz
+template <typename TipoCache>
+void escribirInforme(std::ostream& salida, const TipoCache& cache, const EjecucionSimulacion& ejecucion,
+                     FormatoInforme formato, bool cabeceraCsv = true) {
+    escribirInforme(salida, resumirCache(cache), ejecucion, formato, cabeceraCsv);
+}
+
+// fin de la directiva de preprocesador ifndef
+#endif // INFORMECACHE_HPP
@@ -0,0 +1,165 @@
+// incluye la definicion de la clase JerarquiaCache
+#include "JerarquiaCache.hpp"
+// para entrada/salida por consola
+#include <iostream>
+// para manejo de excepciones
+#include <stdexcept>
+
+// devuelve el nombre legible de una politica de inclusion
+const char* nombrePoliticaInclusion(PoliticaInclusion inclusion) {
+    switch (inclusion) {
+        case PoliticaInclusion::INCLUSIVA: return "inclusiva";
+        case PoliticaInclusion::EXCLUSIVA: return "exclusiva";
+        case PoliticaInclusion::NINE:      return "NINE";
+    }
+    return "desconocida";
+}
+
+// constructor de la jerarquia
+JerarquiaCache::JerarquiaCache(const std::vector<ConfiguracionNivel>& configuracion,
+                               PoliticaInclusion inclusion) :
+    inclusion(inclusion), tamanoBloque(0), lecturasMemoria(0), escriturasMemoria(0) {
+
+    // verifica que haya al menos un nivel
+    if (configuracion.empty()) {
+        throw std::invalid_argument("La jerarquía necesita al menos un nivel");
+    }
+    // los bloques se mueven enteros entre niveles
+    tamanoBloque = configuracion.front().tamanoBloque;
+    for (const auto& nivel : configuracion) {
+        if (nivel.tamanoBloque != tamanoBloque) {
+            throw std::invalid_argument("Todos los niveles deben usar el mismo tamaño de bloque");
+        }
+    }
+
+    // construye cada nivel (la Cache valida su propia geometria)
+    niveles.reserve(configuracion.size());
+    for (const auto& nivel : configuracion) {
+        niveles.emplace_back(nivel.tamano, nivel.tamanoBloque, nivel.asociatividad, nivel.politica);
+        niveles.back().configurarEscritura(nivel.escritura, nivel.asignarEnEscritura);
+    }
+    trafico.resize(niveles.size());
+}
+
+// registra un desalojo y, en modo inclusivo, lo retira de los niveles superiores
+bool JerarquiaCache::propagarDesalojo(std::size_t nivel, const Desalojo& desalojo) {
+    if (!desalojo.valido) return false;
+    trafico[nivel].desalojos++;
+
+    bool modificado = desalojo.modificado;
+    if (inclusion != PoliticaInclusion::INCLUSIVA) return modificado;
+    const uint64_t bloque = desalojo.direccionBloque;
+    for (std::size_t superior = 0; superior < nivel; ++superior) {
+        // una copia superior modificada tiene los datos mas recientes: salen con este desalojo
+        bool copiaModificada = false;
+        if (niveles[superior].invalidar(bloque, &copiaModificada)) {
+            trafico[superior].retroInvalidaciones++;
+            modificado = modificado || copiaModificada;
+        }
+    }
+    return modificado;
+}
+
+// escribe un bloque modificado hacia abajo hasta que un nivel write-back lo retiene
+void JerarquiaCache::escribirDevuelto(std::size_t nivel, uint64_t direccionBloque) {
+    while (nivel < niveles.size()) {
+        trafico[nivel].escriturasRecibidas++;
+        Desalojo desalojo;
+        niveles[nivel].insertar(direccionBloque, desalojo, true);
+        // hacer sitio pudo expulsar otro bloque modificado, que baja a su vez
+        if (propagarDesalojo(nivel, desalojo)) escribirDevuelto(nivel + 1, desalojo.direccionBloque);
+        // un nivel write-through deja pasar la escritura al siguiente
+        if (niveles[nivel].getPoliticaEscritura() == PoliticaEscritura::WRITE_BACK) return;
+        ++nivel;
+    }
+    // por debajo del ultimo nivel esta la memoria
+    escriturasMemoria++;
+}
+
+// recorre los niveles inferiores tras un fallo en L1 (que ya relleno el bloque)
+std::size_t JerarquiaCache::resolverFallo(uint64_t direccion, const Desalojo& desalojoL1) {
+    trafico[0].rellenos++;
+
+    bool servido = false;
+    std::size_t nivelServidor = niveles.size();
+    if (inclusion == PoliticaInclusion::EXCLUSIVA) {
+        propagarDesalojo(0, desalojoL1);
+        // 1. busca el bloque hacia abajo y lo retira del nivel que lo tenga
+        //    si estaba modificado, sube modificado a L1
+        bool modificado = false;
+        for (std::size_t nivel = 1; nivel < niveles.size() && !servido; ++nivel) {
+            servido = niveles[nivel].extraer(direccion, &modificado);
+            if (servido) nivelServidor = nivel;
+        }
+        if (modificado) {
+            if (niveles.front().getPoliticaEscritura() == PoliticaEscritura::WRITE_BACK) {
+                Desalojo ninguno;
+                niveles.front().insertar(direccion, ninguno, true);
+            } else {
+                // L1 write-through no guarda lineas modificadas: los datos se escriben abajo
+                escribirDevuelto(1, direccion);
+            }
+        }
+
+        // 2. la victima de L1 baja al siguiente nivel (con sus datos modificados)
+        //    y desplaza a su vez otra victima
+        Desalojo victima = desalojoL1;
+        for (std::size_t nivel = 1; nivel < niveles.size() && victima.valido; ++nivel) {
+            Desalojo siguiente;
+            niveles[nivel].insertar(victima.direccionBloque, siguiente, victima.modificado);
+            trafico[nivel].victimasRecibidas++;
+            if (siguiente.valido) trafico[nivel].desalojos++;
+            // un nivel write-through deja pasar los datos modificados de la victima
+            if (victima.modificado && niveles[nivel].getPoliticaEscritura() == PoliticaEscritura::WRITE_THROUGH) {
+                escribirDevuelto(nivel + 1, victima.direccionBloque);
+            }
+            victima = siguiente;
+        }
+        // la victima del ultimo nivel sale a memoria
+        if (victima.valido && victima.modificado) escriturasMemoria++;
+    } else {
+        // la victima modificada de L1 se escribe en el nivel siguiente
+        if (propagarDesalojo(0, desalojoL1)) escribirDevuelto(1, desalojoL1.direccionBloque);
+        // inclusiva y nine: cada nivel que falla se rellena con el bloque
+        for (std::size_t nivel = 1; nivel < niveles.size() && !servido; ++nivel) {
+            Desalojo desalojo;
+            servido = niveles[nivel].acceder(direccion, desalojo);
+            if (servido) nivelServidor = nivel;
+            if (!servido) {
+                trafico[nivel].rellenos++;
+                if (propagarDesalojo(nivel, desalojo)) escribirDevuelto(nivel + 1, desalojo.direccionBloque);
+            }
+        }
+    }
+
+    // ningun nivel tenia el bloque
+    if (!servido) lecturasMemoria++;
+    return nivelServidor;
+}
+
+// muestra aciertos y trafico de cada nivel
+void JerarquiaCache::imprimirEstadisticas() const {
+    std::cout << "\n=== Jerarquía de Caché (" << nombrePoliticaInclusion(inclusion) << ") ===\n";
+    for (std::size_t nivel = 0; nivel < niveles.size(); ++nivel) {
+        const Cache& cache = niveles[nivel];
+        const TraficoNivel& t = trafico[nivel];
+        std::cout << "L" << (nivel + 1) << " (" << cache.getTamano() << "B, "
+                  << cache.getTamanoBloque() << "B/bloque, " << cache.getAsociatividad() << " vías, "
+                  << nombrePoliticaReemplazo(cache.getPolitica()) << ")\n";
+        std::cout << "  Accesos: " << (cache.getAciertos() + cache.getFallos())
+                  << "  Aciertos: " << cache.getAciertos()
+                  << " (" << cache.getTasaAciertos() << "%)\n";
+        std::cout << "  Bytes recibidos: "
+                  << (t.rellenos + t.victimasRecibidas + t.escriturasRecibidas) * tamanoBloque
+                  << "  Desalojos: " << t.desalojos
+                  << "  Víctimas recibidas: " << t.victimasRecibidas
+                  << "  Retro-invalidaciones: " << t.retroInvalidaciones << "\n";
+        std::cout << "  Escrituras: " << cache.getTrafico().escrituras
+                  << "  Modificados recibidos: " << t.escriturasRecibidas
+                  << "  Bloques devueltos: " << cache.getTrafico().bloquesDevueltos
+                  << "  Escrituras directas: " << cache.getTrafico().escriturasDirectas << "\n";
+    }
+    std::cout << "Memoria: " << lecturasMemoria << " lecturas ("
+              << lecturasMemoria * tamanoBloque << " bytes), " << escriturasMemoria << " escrituras ("
+              << escriturasMemoria * tamanoBloque << " bytes)\n";
+}
@@ -0,0 +1,119 @@
+// directiva para evitar inclusiones multiples
+#ifndef JERARQUIACACHE_HPP
+#define JERARQUIACACHE_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion de la cache de un nivel
+#include "Cache.hpp"
+
+// relacion de contenido entre niveles de la jerarquia
+enum class PoliticaInclusion {
+    INCLUSIVA,  // todo bloque de un nivel esta tambien en los inferiores
+    EXCLUSIVA,  // un bloque vive en un solo nivel, las victimas bajan
+    NINE        // ni inclusiva ni exclusiva, sin retro-invalidaciones
+};
+
+// geometria y politica de un nivel de la jerarquia
+struct ConfiguracionNivel {
+    int tamano;
+    int tamanoBloque;
+    int asociatividad;
+    PoliticaReemplazo politica = PoliticaReemplazo::LRU;
+    PoliticaEscritura escritura = PoliticaEscritura::WRITE_BACK;
+    bool asignarEnEscritura = true;
+};
+
+// trafico de un nivel que la Cache no registra por si misma
+struct TraficoNivel {
+    // bloques traidos desde el nivel inferior o memoria
+    uint64_t rellenos = 0;
+    // lineas validas expulsadas por falta de espacio
+    uint64_t desalojos = 0;
+    // victimas recibidas del nivel superior (solo exclusiva)
+    uint64_t victimasRecibidas = 0;
+    // bloques invalidados por un desalojo en un nivel inferior (solo inclusiva)
+    uint64_t retroInvalidaciones = 0;
+    // bloques modificados que el nivel superior escribe en este
+    uint64_t escriturasRecibidas = 0;
+};
+
+// cadena de caches L1 -> L2 -> ... -> memoria
+class JerarquiaCache {
+private:
+    // niveles, el 0 es el mas cercano al procesador
+    std::vector<Cache> niveles;
+    // trafico de cada nivel
+    std::vector<TraficoNivel> trafico;
+    // relacion de inclusion entre niveles
+    PoliticaInclusion inclusion;
+    // tamaño de bloque comun a todos los niveles
+    int tamanoBloque;
+    // bloques leidos de memoria principal
+    uint64_t lecturasMemoria;
+    // bloques modificados escritos en memoria principal
+    uint64_t escriturasMemoria;
+
+    // atiende un fallo de L1 en los niveles inferiores
+    // devuelve el nivel que tenia el bloque (getNumNiveles() = memoria)
+    std::size_t resolverFallo(uint64_t direccion, const Desalojo& desalojoL1);
+    // registra un desalojo del nivel y aplica la politica de inclusion
+    // devuelve true si los datos expulsados estaban modificados (en el nivel o en una copia superior)
+    bool propagarDesalojo(std::size_t nivel, const Desalojo& desalojo);
+    // escribe un bloque modificado en el nivel indicado (o en memoria tras el ultimo)
+    void escribirDevuelto(std::size_t nivel, uint64_t direccionBloque);
+
+public:
+    // construye la jerarquia; todos los niveles deben compartir tamaño de bloque
+    JerarquiaCache(const std::vector<ConfiguracionNivel>& configuracion,
+                   PoliticaInclusion inclusion = PoliticaInclusion::NINE);
+
+    // simula un acceso, devuelve true si acerto en L1
+    // el acierto en L1 cuesta lo mismo que un acceso a una cache aislada
+    // las escrituras directas (write-through o sin asignacion) se cuentan en el
+    // trafico del nivel que las emite, pero no se simulan en los niveles inferiores
+    bool acceder(uint64_t direccion, TipoAcceso tipo = TipoAcceso::LECTURA) {
+        Desalojo desalojo;
+        Cache& l1 = niveles.front();
+        if (l1.acceder(direccion, tipo, desalojo)) return true;
+        // un fallo de escritura sin asignacion no trae el bloque
+        if (tipo == TipoAcceso::ESCRITURA && !l1.getAsignarEnEscritura()) return false;
+        resolverFallo(direccion, desalojo);
+        return false;
+    }
+    // igual que acceder, pero devuelve el nivel que sirvio el bloque
+    // (0 = acierto en L1, getNumNiveles() = memoria); una escritura sin asignacion
+    // que falla no espera datos y devuelve 0
+    std::size_t accederNivel(uint64_t direccion, TipoAcceso tipo = TipoAcceso::LECTURA) {
+        Desalojo desalojo;
+        Cache& l1 = niveles.front();
+        if (l1.acceder(direccion, tipo, desalojo)) return 0;
+        if (tipo == TipoAcceso::ESCRITURA && !l1.getAsignarEnEscritura()) return 0;
+        return resolverFallo(direccion, desalojo);
+    }
+
+    // muestra aciertos y trafico de cada nivel
+    void imprimirEstadisticas() const;
+
+    // metodos de consulta
+    // numero de niveles
+    std::size_t getNumNiveles() const { return niveles.size(); }
+    // cache de un nivel (0 = L1)
+    const Cache& getNivel(std::size_t nivel) const { return niveles[nivel]; }
+    // trafico registrado en un nivel
+    const TraficoNivel& getTrafico(std::size_t nivel) const { return trafico[nivel]; }
+    // politica de inclusion
+    PoliticaInclusion getInclusion() const { return inclusion; }
+    // bloques leidos de memoria principal
+    uint64_t getLecturasMemoria() const { return lecturasMemoria; }
+    // bloques modificados escritos en memoria principal
+    uint64_t getEscriturasMemoria() const { return escriturasMemoria; }
+};
+
+// devuelve el nombre legible de una politica de inclusion
+const char* nombrePoliticaInclusion(PoliticaInclusion inclusion);
+
+// fin de la directiva de preprocesador ifndef
+#endif // JERARQUIACACHE_HPP
@@ -2,12 +2,12 @@
 #define LINEACACHE_HPP
 
 // inclusion para tipos de enteros de tamaño fijo
-#include <cstdint>  // para uint32_t
+#include <cstdint>  // para uint32_t y uint64_t
 
 // estructura que representa una linea de cache
 struct LineaCache {
     // campo que almacena la etiqueta de direccion de memoria
-    uint32_t etiqueta;
+    uint64_t etiqueta;
     
     // flag que indica si la linea contiene datos validos
     bool valido;
@@ -15,11 +15,11 @@ struct LineaCache {
     // flag que indica si la linea ha sido modificada (politica write-back)
     bool modificado;
     
-    // contador para politicas de reemplazo lru
-    int contadorAccesos;
+    // estado de la politica de reemplazo (marca lru, rrpv, orden fifo...)
+    uint64_t contadorAccesos;
     
     // metodo para inicializar los valores de la linea
-    void inicializar(uint32_t etiq, bool val, bool mod) {
+    void inicializar(uint64_t etiq, bool val, bool mod) {
         // asigna la etiqueta de direccion
         etiqueta = etiq;
         
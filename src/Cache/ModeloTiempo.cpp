@@ -0,0 +1,130 @@
+// incluye la definicion de la clase ModeloTiempo
+#include "ModeloTiempo.hpp"
+// para entrada/salida por consola
+#include <iostream>
+// para manejo de excepciones
+#include <stdexcept>
+// para std::max y std::min_element
+#include <algorithm>
+
+// latencias por defecto de L1, L2 y L3; cada nivel mas triplica la anterior
+constexpr int LATENCIAS_POR_DEFECTO[] = {4, 12, 40};
+
+// constructor: valida las latencias y precalcula la de cada nivel servidor
+ModeloTiempo::ModeloTiempo(const std::vector<ConfiguracionNivel>& niveles, PoliticaInclusion inclusion,
+                           const ConfiguracionTiempo& configuracion) :
+    jerarquia(niveles, inclusion), configuracion(configuracion), desplazamientoBloque(0), ciclo(0), finFallos(0) {
+
+    std::vector<int>& latencias = this->configuracion.latenciaNiveles;
+    if (latencias.empty()) {
+        for (std::size_t nivel = 0; nivel < niveles.size(); ++nivel) {
+            latencias.push_back(nivel < 3 ? LATENCIAS_POR_DEFECTO[nivel] : latencias.back() * 3);
+        }
+    }
+    if (latencias.size() != niveles.size()) {
+        throw std::invalid_argument("Se necesita una latencia por nivel");
+    }
+    for (int latencia : latencias) {
+        if (latencia <= 0) throw std::invalid_argument("Las latencias deben ser positivas");
+    }
+    if (configuracion.latenciaMemoria <= 0 || configuracion.numMSHR <= 0 || configuracion.ciclosEntreAccesos <= 0) {
+        throw std::invalid_argument("Latencia de memoria, MSHR y ciclos entre accesos deben ser positivos");
+    }
+
+    // un acceso servido por el nivel n consulta los niveles 0..n
+    uint64_t acumulada = 0;
+    for (int latencia : latencias) {
+        acumulada += static_cast<uint64_t>(latencia);
+        latenciaServicio.push_back(acumulada);
+    }
+    latenciaServicio.push_back(acumulada + static_cast<uint64_t>(configuracion.latenciaMemoria));
+
+    while ((1 << desplazamientoBloque) < niveles.front().tamanoBloque) ++desplazamientoBloque;
+    enVuelo.reserve(configuracion.numMSHR);
+    fallosNivel.assign(niveles.size(), 0);
+    latenciaFallosNivel.assign(niveles.size(), 0);
+}
+
+// emite un acceso: MSHR, paradas y latencia
+uint64_t ModeloTiempo::acceder(uint64_t direccion, TipoAcceso tipo) {
+    const uint64_t bloque = direccion >> desplazamientoBloque;
+    const uint64_t emision = ciclo;
+    uint64_t inicio = emision;
+
+    // libera los MSHR cuyo bloque ya llego
+    enVuelo.erase(std::remove_if(enVuelo.begin(), enVuelo.end(),
+                                 [&](const MSHR& mshr) { return mshr.fin <= inicio; }),
+                  enVuelo.end());
+
+    // la jerarquia coloca el bloque al instante; el modelo decide cuando llega
+    const std::size_t nivel = jerarquia.accederNivel(direccion, tipo);
+    uint64_t fin = inicio + latenciaServicio[0];
+
+    // 1. el bloque ya tiene un fallo en vuelo: espera a ese mismo MSHR
+    auto pendiente = std::find_if(enVuelo.begin(), enVuelo.end(),
+                                  [&](const MSHR& mshr) { return mshr.bloque == bloque; });
+    if (pendiente != enVuelo.end()) {
+        estadisticas.fallosFusionados++;
+        fin = std::max(fin, pendiente->fin);
+    } else if (nivel > 0) {
+        // 2. fallo primario: sin MSHR libre la traza espera al primero que termine
+        if (enVuelo.size() >= static_cast<std::size_t>(configuracion.numMSHR)) {
+            auto primero = std::min_element(enVuelo.begin(), enVuelo.end(),
+                                            [](const MSHR& a, const MSHR& b) { return a.fin < b.fin; });
+            inicio = primero->fin;
+            estadisticas.ciclosParada += inicio - emision;
+            enVuelo.erase(std::remove_if(enVuelo.begin(), enVuelo.end(),
+                                         [&](const MSHR& mshr) { return mshr.fin <= inicio; }),
+                          enVuelo.end());
+        }
+        const uint64_t latencia = latenciaServicio[nivel];
+        fin = inicio + latencia;
+        enVuelo.push_back(MSHR{bloque, fin});
+        estadisticas.fallosPrimarios++;
+        estadisticas.ciclosFallos += latencia;
+        // los inicios no decrecen: la union de intervalos crece por el final
+        estadisticas.ciclosConFallos += fin - std::max(inicio, std::min(finFallos, fin));
+        finFallos = std::max(finFallos, fin);
+
+        // cada nivel que fallo espera desde su propia consulta hasta el bloque
+        for (std::size_t k = 0; k < nivel && k < fallosNivel.size(); ++k) {
+            fallosNivel[k]++;
+            latenciaFallosNivel[k] += latencia - (k > 0 ? latenciaServicio[k - 1] : 0);
+        }
+    }
+
+    // el siguiente acceso sale tras este (o tras la parada)
+    ciclo = inicio + static_cast<uint64_t>(configuracion.ciclosEntreAccesos);
+    // la espera por MSHR se cuenta aparte, en ciclosParada
+    const uint64_t latenciaVista = fin - inicio;
+    estadisticas.accesos++;
+    estadisticas.sumaLatencias += latenciaVista;
+    estadisticas.ciclos = std::max(estadisticas.ciclos, fin);
+    return latenciaVista;
+}
+
+// emite una secuencia de accesos
+void ModeloTiempo::accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad) {
+    for (std::size_t i = 0; i < cantidad; ++i) {
+        acceder(direcciones[i], tipos != nullptr ? tipos[i] : TipoAcceso::LECTURA);
+    }
+}
+
+// muestra las estadisticas de tiempo
+void ModeloTiempo::imprimirEstadisticas() const {
+    const EstadisticasTiempo& e = estadisticas;
+    std::cout << "\n=== Modelo de tiempo (" << configuracion.numMSHR << " MSHR, memoria "
+              << configuracion.latenciaMemoria << " ciclos) ===\n";
+    std::cout << "Accesos: " << e.accesos << "  Ciclos: " << e.ciclos
+              << "  Accesos por ciclo: " << (e.ciclos > 0 ? static_cast<double>(e.accesos) / e.ciclos : 0.0) << "\n";
+    std::cout << "AMAT: " << e.amat() << " ciclos\n";
+    std::cout << "Fallos primarios: " << e.fallosPrimarios << "  Fusionados: " << e.fallosFusionados
+              << "  Ciclos de parada (MSHR llenos): " << e.ciclosParada << "\n";
+    std::cout << "MLP: " << e.mlp() << " fallos en vuelo de media (" << e.ciclosConFallos
+              << " ciclos con fallos)\n";
+    for (std::size_t nivel = 0; nivel < fallosNivel.size(); ++nivel) {
+        std::cout << "L" << (nivel + 1) << ": acierto " << latenciaServicio[nivel]
+                  << " ciclos, fallo " << getLatenciaFallo(nivel) << " ciclos de media ("
+                  << fallosNivel[nivel] << " fallos)\n";
+    }
+}
@@ -0,0 +1,111 @@
+// directiva para evitar inclusiones multiples
+#ifndef MODELOTIEMPO_HPP
+#define MODELOTIEMPO_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion de la jerarquia que decide quien sirve cada acceso
+#include "JerarquiaCache.hpp"
+
+// latencias y recursos de la maquina simulada, en ciclos
+struct ConfiguracionTiempo {
+    // ciclos de consulta de cada nivel; un fallo paga la consulta de cada nivel que
+    // falla mas la del nivel que sirve el bloque (vacio = 4, 12, 40... por nivel)
+    std::vector<int> latenciaNiveles;
+    // ciclos de la memoria principal tras fallar en el ultimo nivel
+    int latenciaMemoria = 200;
+    // fallos de L1 en vuelo como maximo (1 = cache bloqueante)
+    int numMSHR = 8;
+    // ciclos entre accesos consecutivos de la traza cuando nada los detiene
+    int ciclosEntreAccesos = 1;
+};
+
+// contadores del modelo de tiempo
+struct EstadisticasTiempo {
+    uint64_t accesos = 0;
+    // ciclo en que termina el ultimo acceso
+    uint64_t ciclos = 0;
+    // suma de las latencias de cada acceso desde que sale (sin la espera por MSHR)
+    uint64_t sumaLatencias = 0;
+    // fallos de L1 que reservaron un MSHR
+    uint64_t fallosPrimarios = 0;
+    // accesos a un bloque con un fallo ya en vuelo, unidos a su MSHR
+    uint64_t fallosFusionados = 0;
+    // ciclos que la traza estuvo detenida con todos los MSHR ocupados
+    uint64_t ciclosParada = 0;
+    // suma de la duracion de todos los fallos primarios
+    uint64_t ciclosFallos = 0;
+    // ciclos con al menos un fallo en vuelo
+    uint64_t ciclosConFallos = 0;
+
+    // tiempo medio de acceso a memoria
+    double amat() const { return accesos > 0 ? static_cast<double>(sumaLatencias) / accesos : 0.0; }
+    // paralelismo de memoria: fallos en vuelo de media mientras hay alguno
+    double mlp() const { return ciclosConFallos > 0 ? static_cast<double>(ciclosFallos) / ciclosConFallos : 0.0; }
+};
+
+// modelo de tiempo de una jerarquia con fallos no bloqueantes
+// la jerarquia decide en que nivel esta cada bloque; el modelo calcula cuando
+// termina cada acceso. Los fallos de L1 ocupan un MSHR hasta que llega el bloque,
+// los accesos posteriores al mismo bloque se unen a ese MSHR y, si no queda
+// ninguno libre, la traza se detiene hasta que se libera el primero
+class ModeloTiempo {
+private:
+    // fallo en vuelo
+    struct MSHR {
+        uint64_t bloque;
+        // ciclo en que llega el bloque
+        uint64_t fin;
+    };
+
+    JerarquiaCache jerarquia;
+    ConfiguracionTiempo configuracion;
+    // latencia total de un acceso servido por cada nivel (la ultima es memoria)
+    std::vector<uint64_t> latenciaServicio;
+    // fallos en vuelo (como mucho numMSHR)
+    std::vector<MSHR> enVuelo;
+    // log2 del tamaño de bloque
+    uint32_t desplazamientoBloque;
+    // ciclo en que se emite el siguiente acceso
+    uint64_t ciclo;
+    // fin del ultimo intervalo con fallos en vuelo (para medir su union)
+    uint64_t finFallos;
+    // fallos de cada nivel y suma de sus latencias
+    std::vector<uint64_t> fallosNivel;
+    std::vector<uint64_t> latenciaFallosNivel;
+    EstadisticasTiempo estadisticas;
+
+public:
+    // lanza std::invalid_argument si las latencias no cuadran con los niveles
+    // o algun parametro no es positivo
+    ModeloTiempo(const std::vector<ConfiguracionNivel>& niveles, PoliticaInclusion inclusion,
+                 const ConfiguracionTiempo& configuracion);
+
+    // emite un acceso y devuelve los ciclos desde que sale hasta que tiene sus datos
+    uint64_t acceder(uint64_t direccion, TipoAcceso tipo = TipoAcceso::LECTURA);
+    // emite una secuencia de accesos (tipos nulo = todo lecturas)
+    void accederLote(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad);
+    // version del lote para una traza completa de lecturas
+    void accederLote(const std::vector<uint64_t>& direcciones) {
+        accederLote(direcciones.data(), nullptr, direcciones.size());
+    }
+
+    // muestra AMAT, MLP, paradas y latencias de fallo por nivel
+    void imprimirEstadisticas() const;
+
+    // metodos de consulta
+    const JerarquiaCache& getJerarquia() const { return jerarquia; }
+    const ConfiguracionTiempo& getConfiguracion() const { return configuracion; }
+    const EstadisticasTiempo& getEstadisticas() const { return estadisticas; }
+    // latencia media de los fallos del nivel (0 = L1)
+    double getLatenciaFallo(std::size_t nivel) const {
+        return fallosNivel[nivel] > 0 ? static_cast<double>(latenciaFallosNivel[nivel]) / fallosNivel[nivel] : 0.0;
+    }
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // MODELOTIEMPO_HPP
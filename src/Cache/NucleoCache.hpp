@@ -0,0 +1,252 @@
+// directiva para evitar inclusiones multiples
+#ifndef NUCLEOCACHE_HPP
+#define NUCLEOCACHE_HPP
+
+// nucleo del acceso de Cache como plantillas sobre la politica y la geometria
+// lo incluyen Cache.cpp (GeometriaVariable) y CacheFija.hpp (GeometriaFija), asi
+// que las dos caches ejecutan el mismo algoritmo de acceso y de reemplazo
+
+// inclusion para std::min
+#include <algorithm>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// definicion de la clase Cache
+#include "Cache.hpp"
+
+// traduce la politica elegida en la construccion a un tipo de politicas::
+template <typename Funcion>
+decltype(auto) Cache::conPolitica(Funcion&& f) {
+    switch (politica) {
+        case PoliticaReemplazo::PLRU_ARBOL: return f(politicas::PLRUArbol{});
+        case PoliticaReemplazo::SRRIP:      return f(politicas::SRRIP{});
+        case PoliticaReemplazo::BRRIP:      return f(politicas::BRRIP{});
+        case PoliticaReemplazo::FIFO:       return f(politicas::FIFO{});
+        case PoliticaReemplazo::ALEATORIA:  return f(politicas::Aleatoria{});
+        case PoliticaReemplazo::LRU:        break;
+    }
+    return f(politicas::LRU{});
+}
+
+// compara la etiqueta con todas las vias con una comparacion vectorial
+// y arma un mapa de coincidencias (un solo salto por acceso en lugar de uno por via)
+template <typename Geometria>
+uint64_t Cache::buscarCoincidencias(uint32_t conjunto, uint64_t etiqueta, const Geometria& g) const {
+    const uint64_t* etiquetasConjunto = &etiquetas[static_cast<std::size_t>(conjunto) * g.vias];
+    return coincidenciasSIMD(etiquetasConjunto, etiqueta, static_cast<int>(g.vias)) & validos[conjunto];
+}
+
+// nucleo del acceso una vez conocidos conjunto y etiqueta
+template <typename Politica, bool ContarEstadisticas, typename Geometria>
+bool Cache::accederConjunto(uint32_t conjunto, uint64_t etiqueta, Desalojo& desalojo, const Geometria& g) {
+    // estado de reemplazo del conjunto
+    EstadoReemplazo estado = estadoDe(conjunto, g);
+    const uint64_t coincidencias = buscarCoincidencias(conjunto, etiqueta, g);
+
+    if (coincidencias != 0) {
+        // informa del acierto a la politica
+        Politica::alAcertar(estado, __builtin_ctzll(coincidencias));
+        // incrementa contadores
+        if (ContarEstadisticas) {
+            aciertos++;
+            aciertosPorConjunto[conjunto]++;
+            if (clasificador.activo()) clasificador.observar(bloqueDe(conjunto, etiqueta, g), true);
+        }
+        // primer uso por la demanda de una linea traida por prefetch
+        if (ContarEstadisticas && (prefetchados[conjunto] & coincidencias) != 0) {
+            prefetchados[conjunto] &= ~coincidencias;
+            const std::size_t indice = static_cast<std::size_t>(conjunto) * g.vias +
+                                       __builtin_ctzll(coincidencias);
+            estadisticasPrefetch.utiles++;
+            estadisticasPrefetch.sumaAntelacion += instante - llegadaPrefetch[indice];
+            aciertoEnPrefetch = true;
+        }
+        return true;
+    }
+    
+    // si no encontro, es fallo - usa la primera via libre o pide victima a la politica
+    const uint64_t validosConjunto = validos[conjunto];
+    const uint64_t libres = ~validosConjunto & g.mascaraVias;
+    const uint32_t viaVictima = libres != 0 ? static_cast<uint32_t>(__builtin_ctzll(libres))
+                                            : Politica::elegirVictima(estado);
+    
+    // informa del bloque expulsado (solo si el conjunto estaba lleno)
+    const std::size_t indice = static_cast<std::size_t>(conjunto) * g.vias + viaVictima;
+    desalojo.valido = libres == 0;
+    desalojo.direccionBloque = bloqueDe(conjunto, etiquetas[indice], g) << g.desplazamientoBloque;
+    // una linea modificada que sale debe escribirse abajo (las vias libres nunca lo estan)
+    const uint64_t bitVictima = uint64_t(1) << viaVictima;
+    desalojo.modificado = (modificados[conjunto] & bitVictima) != 0;
+    modificados[conjunto] &= ~bitVictima;
+    // una linea traida por prefetch que sale sin haberse usado fue inutil
+    if ((prefetchados[conjunto] & bitVictima) != 0) {
+        prefetchados[conjunto] &= ~bitVictima;
+        estadisticasPrefetch.inutiles++;
+    }
+
+    // reemplaza la linea victima
+    etiquetas[indice] = etiqueta;
+    validos[conjunto] = validosConjunto | (uint64_t(1) << viaVictima);
+    Politica::alInsertar(estado, viaVictima);
+    // incrementa contadores de fallos y de trafico
+    // (sin contar, quien llama decide si el relleno y el desalojo son trafico)
+    if (ContarEstadisticas) {
+        fallos++;
+        fallosPorConjunto[conjunto]++;
+        trafico.bloquesLeidos++;
+        trafico.bloquesDevueltos += desalojo.modificado;
+        if (clasificador.activo()) clasificador.observar(bloqueDe(conjunto, etiqueta, g), false);
+    }
+    return false;
+}
+
+// escritura: acierto o fallo como una lectura, mas la politica de escritura
+template <typename Politica, typename Geometria>
+bool Cache::escribirConjunto(uint32_t conjunto, uint64_t etiqueta, Desalojo& desalojo, const Geometria& g) {
+    trafico.escrituras++;
+
+    // fallo sin asignacion: la escritura pasa directa al nivel inferior
+    if (!asignarEnEscritura && buscarCoincidencias(conjunto, etiqueta, g) == 0) {
+        desalojo.valido = false;
+        desalojo.modificado = false;
+        fallos++;
+        fallosPorConjunto[conjunto]++;
+        trafico.fallosEscritura++;
+        trafico.escriturasDirectas++;
+        // el bloque no entra tampoco en la cache en sombra
+        if (clasificador.activo()) clasificador.observar(bloqueDe(conjunto, etiqueta, g), false, false);
+        return false;
+    }
+
+    // con asignacion el fallo trae el bloque como una lectura
+    const bool acierto = accederConjunto<Politica, true>(conjunto, etiqueta, desalojo, g);
+    if (!acierto) trafico.fallosEscritura++;
+    if (escritura == PoliticaEscritura::WRITE_THROUGH) {
+        trafico.escriturasDirectas++;
+    } else {
+        modificados[conjunto] |= buscarCoincidencias(conjunto, etiqueta, g);
+    }
+    return acierto;
+}
+
+// acceso de lectura o escritura informando del bloque expulsado
+template <typename Geometria>
+bool Cache::accederGeometria(uint64_t direccion, TipoAcceso tipo, Desalojo& desalojo, const Geometria& g) {
+    const bool esEscritura = tipo == TipoAcceso::ESCRITURA;
+    // cache sesgada: sin politica que despachar (una geometria fija siempre usa MASCARA)
+    if constexpr (!Geometria::FIJA) {
+        if (funcionIndice == FuncionIndice::SESGADA) {
+            if (esEscritura) {
+                desalojo = Desalojo();
+                return escribirSesgado(direccion >> desplazamientoBloque, desalojo);
+            }
+            uint32_t conjunto, via;
+            return accederSesgado<true>(direccion >> desplazamientoBloque, desalojo, conjunto, via);
+        }
+    }
+    const uint32_t conjunto = conjuntoDe(direccion, g);
+    // conjunto fuera de la muestra: ni acierto ni fallo
+    if (mascaraMuestreo != 0 && !conjuntoMuestreado(conjunto)) {
+        desalojo = Desalojo();
+        accesosDescartados++;
+        return false;
+    }
+    const uint64_t etiqueta = direccion >> g.desplazamientoEtiqueta;
+    // un unico salto predecible por acceso elige la version especializada
+    return conPolitica([&](auto p) {
+        if (esEscritura) {
+            desalojo = Desalojo();
+            return escribirConjunto<decltype(p)>(conjunto, etiqueta, desalojo, g);
+        }
+        return accederConjunto<decltype(p), true>(conjunto, etiqueta, desalojo, g);
+    });
+}
+
+// acceso de demanda: con prefetcher cada acceso lo entrena
+template <typename Geometria>
+bool Cache::accederDemanda(uint64_t direccion, TipoAcceso tipo, const Geometria& g) {
+    if (prefetcher.activo()) return accederConPrefetch(direccion, 0, tipo);
+    Desalojo desalojo;
+    return accederGeometria(direccion, tipo, desalojo, g);
+}
+
+// direcciones que se preparan juntas en cada tramo del lote (caben en L1 del anfitrion)
+constexpr std::size_t TAMANO_TRAMO_LOTE = 256;
+// accesos de antelacion con los que se precarga el conjunto en el anfitrion
+constexpr std::size_t DISTANCIA_PRECARGA_LOTE = 8;
+
+// recorre el lote por tramos: primero calcula conjuntos y etiquetas de todo el
+// tramo en un bucle sin dependencias (vectorizable) y despues los aplica en orden
+template <typename Politica, typename Geometria>
+std::size_t Cache::accederLoteCon(const uint64_t* direcciones, const TipoAcceso* tipos, std::size_t cantidad,
+                                  uint8_t* resultados, const Geometria& g) {
+    uint32_t conjuntos[TAMANO_TRAMO_LOTE];
+    uint64_t etiquetasTramo[TAMANO_TRAMO_LOTE];
+    std::size_t aciertosLote = 0;
+    Desalojo desalojo;
+
+    for (std::size_t inicio = 0; inicio < cantidad; inicio += TAMANO_TRAMO_LOTE) {
+        const std::size_t n = std::min(TAMANO_TRAMO_LOTE, cantidad - inicio);
+        const uint64_t* tramo = direcciones + inicio;
+
+        // 1. geometria de todo el tramo (la funcion de indice se elige fuera del bucle)
+        if (Geometria::FIJA || funcionIndice == FuncionIndice::MASCARA) {
+            for (std::size_t i = 0; i < n; ++i) {
+                conjuntos[i] = static_cast<uint32_t>(tramo[i] >> g.desplazamientoBloque) & g.mascaraConjunto;
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                conjuntos[i] = conjuntoDe(tramo[i]);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            etiquetasTramo[i] = tramo[i] >> g.desplazamientoEtiqueta;
+        }
+
+        // 2. accesos en orden de programa, precargando conjuntos futuros
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i + DISTANCIA_PRECARGA_LOTE < n) {
+                const uint32_t futuro = conjuntos[i + DISTANCIA_PRECARGA_LOTE];
+                __builtin_prefetch(&etiquetas[static_cast<std::size_t>(futuro) * g.vias]);
+            }
+            // conjunto fuera de la muestra: se descarta sin tocar la cache
+            if (mascaraMuestreo != 0 && !conjuntoMuestreado(conjuntos[i])) {
+                accesosDescartados++;
+                if (resultados != nullptr) resultados[inicio + i] = 0;
+                continue;
+            }
+            const bool esEscritura = tipos != nullptr && tipos[inicio + i] == TipoAcceso::ESCRITURA;
+            const bool acierto = esEscritura
+                ? escribirConjunto<Politica>(conjuntos[i], etiquetasTramo[i], desalojo, g)
+                : accederConjunto<Politica, true>(conjuntos[i], etiquetasTramo[i], desalojo, g);
+            aciertosLote += acierto;
+            if (resultados != nullptr) resultados[inicio + i] = acierto;
+        }
+    }
+    return aciertosLote;
+}
+
+// lote de lecturas y escrituras con un solo despacho de politica
+template <typename Geometria>
+std::size_t Cache::accederLoteGeometria(const uint64_t* direcciones, const TipoAcceso* tipos, const uint64_t* pcs,
+                                        std::size_t cantidad, uint8_t* resultados, const Geometria& g) {
+    // el prefetcher necesita ver cada acceso antes del siguiente; la cache sesgada
+    // no tiene un conjunto por acceso que preparar
+    if (prefetcher.activo() || funcionIndice == FuncionIndice::SESGADA) {
+        std::size_t aciertosLote = 0;
+        for (std::size_t i = 0; i < cantidad; ++i) {
+            const TipoAcceso tipo = tipos != nullptr ? tipos[i] : TipoAcceso::LECTURA;
+            const bool acierto = accederConPrefetch(direcciones[i], pcs != nullptr ? pcs[i] : 0, tipo);
+            aciertosLote += acierto;
+            if (resultados != nullptr) resultados[i] = acierto;
+        }
+        return aciertosLote;
+    }
+    return conPolitica([&](auto p) {
+        return accederLoteCon<decltype(p)>(direcciones, tipos, cantidad, resultados, g);
+    });
+}
+
+// fin de la directiva de preprocesador ifndef
+#endif // NUCLEOCACHE_HPP
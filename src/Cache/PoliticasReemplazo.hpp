@@ -0,0 +1,182 @@
+#ifndef POLITICASREEMPLAZO_HPP
+#define POLITICASREEMPLAZO_HPP
+
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+
+// politicas de reemplazo disponibles, se eligen al construir la Cache
+enum class PoliticaReemplazo {
+    LRU,         // lru exacto por marcas de tiempo
+    PLRU_ARBOL,  // pseudo-lru de arbol binario (requiere vias potencia de dos)
+    SRRIP,       // re-reference interval prediction estatico (rrpv de 2 bits)
+    BRRIP,       // rrip bimodal, inserta casi siempre con rrpv distante
+    FIFO,        // primero en entrar, primero en salir
+    ALEATORIA    // victima pseudoaleatoria
+};
+
+// devuelve el nombre legible de una politica
+inline const char* nombrePoliticaReemplazo(PoliticaReemplazo politica) {
+    switch (politica) {
+        case PoliticaReemplazo::LRU:        return "LRU";
+        case PoliticaReemplazo::PLRU_ARBOL: return "PLRU-arbol";
+        case PoliticaReemplazo::SRRIP:      return "SRRIP";
+        case PoliticaReemplazo::BRRIP:      return "BRRIP";
+        case PoliticaReemplazo::FIFO:       return "FIFO";
+        case PoliticaReemplazo::ALEATORIA:  return "Aleatoria";
+    }
+    return "Desconocida";
+}
+
+// vista sobre el estado de reemplazo de un conjunto dentro del almacenamiento plano
+// cada politica interpreta a su manera un valor por via y un valor por conjunto
+struct EstadoReemplazo {
+    // un valor por via (marca de tiempo, rrpv, ...)
+    uint64_t* vias;
+    // un valor por conjunto (reloj, bits del arbol, semilla, ...)
+    uint64_t& conjunto;
+    // numero de vias del conjunto
+    uint32_t numVias;
+};
+
+// cada politica es un tipo con funciones estaticas en linea para que el
+// compilador las inserte en el camino de acierto sin despacho virtual:
+//   inicializarConjunto(estado, indice)  estado inicial de un conjunto
+//   alAcertar(estado, via)               acierto en la via
+//   alInsertar(estado, via)              bloque nuevo colocado en la via
+//   elegirVictima(estado)                via a reemplazar (conjunto lleno)
+
+namespace politicas {
+
+// paso del generador splitmix64, usado para sembrar y avanzar estados aleatorios
+inline uint64_t mezclarSplitMix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// semilla xorshift distinta de cero y propia de cada conjunto
+inline uint64_t semillaConjunto(uint32_t indice) {
+    return mezclarSplitMix(indice) | 1;
+}
+
+// avanza un estado xorshift64 y devuelve 32 bits pseudoaleatorios
+inline uint32_t siguienteAleatorio(uint64_t& estado) {
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return static_cast<uint32_t>(estado >> 32);
+}
+
+// devuelve la via con el menor valor de estado (la primera en caso de empate)
+inline uint32_t viaConMinimo(const uint64_t* valores, uint32_t numVias) {
+    uint32_t viaMin = 0;
+    uint64_t minimo = valores[0];
+    // seleccion sin saltos
+    for (uint32_t via = 1; via < numVias; ++via) {
+        const bool menor = valores[via] < minimo;
+        minimo = menor ? valores[via] : minimo;
+        viaMin = menor ? via : viaMin;
+    }
+    return viaMin;
+}
+
+// lru exacto: cada via guarda la marca del reloj del conjunto en su ultimo uso
+// acierto o insercion O(1), la victima es la marca mas antigua
+struct LRU {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t) { e.conjunto = 0; }
+    static void alAcertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = ++e.conjunto; }
+    static void alInsertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = ++e.conjunto; }
+    static uint32_t elegirVictima(EstadoReemplazo& e) { return viaConMinimo(e.vias, e.numVias); }
+};
+
+// pseudo-lru de arbol: numVias-1 bits en el valor del conjunto, nodo raiz en el bit 1
+// cada bit apunta al subarbol que contiene la victima (0 izquierda, 1 derecha)
+struct PLRUArbol {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t) { e.conjunto = 0; }
+
+    // recorre el camino de la via y orienta cada nodo hacia el lado contrario
+    static void alAcertar(EstadoReemplazo& e, uint32_t via) {
+        uint32_t nodo = 1;
+        for (uint32_t mitad = e.numVias >> 1; mitad > 0; mitad >>= 1) {
+            const uint32_t derecha = (via & mitad) ? 1u : 0u;
+            const uint64_t bit = uint64_t(1) << nodo;
+            e.conjunto = derecha ? (e.conjunto & ~bit) : (e.conjunto | bit);
+            nodo = 2 * nodo + derecha;
+        }
+    }
+    static void alInsertar(EstadoReemplazo& e, uint32_t via) { alAcertar(e, via); }
+
+    // sigue los bits desde la raiz hasta una hoja
+    static uint32_t elegirVictima(EstadoReemplazo& e) {
+        uint32_t nodo = 1;
+        uint32_t via = 0;
+        for (uint32_t mitad = e.numVias >> 1; mitad > 0; mitad >>= 1) {
+            const uint32_t derecha = static_cast<uint32_t>((e.conjunto >> nodo) & 1);
+            via |= derecha ? mitad : 0u;
+            nodo = 2 * nodo + derecha;
+        }
+        return via;
+    }
+};
+
+// valor rrpv maximo con 2 bits (re-referencia en un futuro lejano)
+constexpr uint64_t RRPV_MAXIMO = 3;
+
+// srrip: rrpv por via, acierto -> 0, insercion -> maximo-1
+struct SRRIP {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t) { e.conjunto = 0; }
+    static void alAcertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = 0; }
+    static void alInsertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = RRPV_MAXIMO - 1; }
+
+    // envejece todo el conjunto de una vez hasta que alguna via llegue al maximo
+    // equivale a repetir "incrementar todas" hasta encontrar una victima
+    static uint32_t elegirVictima(EstadoReemplazo& e) {
+        uint64_t maximo = 0;
+        for (uint32_t via = 0; via < e.numVias; ++via) {
+            maximo = e.vias[via] > maximo ? e.vias[via] : maximo;
+        }
+        const uint64_t incremento = RRPV_MAXIMO - maximo;
+        uint32_t victima = e.numVias;
+        for (uint32_t via = e.numVias; via-- > 0;) {
+            e.vias[via] += incremento;
+            victima = e.vias[via] == RRPV_MAXIMO ? via : victima;
+        }
+        return victima;
+    }
+};
+
+// brrip: como srrip pero inserta con rrpv maximo salvo 1 de cada 32 veces
+// el valor del conjunto guarda la semilla para que cada conjunto sea determinista
+struct BRRIP {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t indice) { e.conjunto = semillaConjunto(indice); }
+    static void alAcertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = 0; }
+    static void alInsertar(EstadoReemplazo& e, uint32_t via) {
+        const bool cercana = (siguienteAleatorio(e.conjunto) & 31) == 0;
+        e.vias[via] = cercana ? RRPV_MAXIMO - 1 : RRPV_MAXIMO;
+    }
+    static uint32_t elegirVictima(EstadoReemplazo& e) { return SRRIP::elegirVictima(e); }
+};
+
+// fifo: cada via guarda la marca de insercion, los aciertos no cambian el orden
+struct FIFO {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t) { e.conjunto = 0; }
+    static void alAcertar(EstadoReemplazo&, uint32_t) {}
+    static void alInsertar(EstadoReemplazo& e, uint32_t via) { e.vias[via] = ++e.conjunto; }
+    static uint32_t elegirVictima(EstadoReemplazo& e) { return viaConMinimo(e.vias, e.numVias); }
+};
+
+// aleatoria: victima uniforme con un generador xorshift por conjunto
+struct Aleatoria {
+    static void inicializarConjunto(EstadoReemplazo& e, uint32_t indice) { e.conjunto = semillaConjunto(indice); }
+    static void alAcertar(EstadoReemplazo&, uint32_t) {}
+    static void alInsertar(EstadoReemplazo&, uint32_t) {}
+    static uint32_t elegirVictima(EstadoReemplazo& e) {
+        // reduccion multiplicativa al rango [0, numVias) sin division
+        return static_cast<uint32_t>((uint64_t(siguienteAleatorio(e.conjunto)) * e.numVias) >> 32);
+    }
+};
+
+} // namespace politicas
+
+#endif // POLITICASREEMPLAZO_HPP
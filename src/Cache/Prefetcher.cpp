@@ -0,0 +1,154 @@
+// incluye la definicion de la clase Prefetcher
+#include "Prefetcher.hpp"
+// para manejo de excepciones
+#include <stdexcept>
+// limites de los enteros para el salto del prefetch de strides
+#include <limits>
+
+// distancia maxima, en bloques, entre un disparo y el ultimo bloque de un flujo para continuarlo
+constexpr uint64_t VENTANA_FLUJO = 16;
+
+// devuelve el nombre legible de un tipo de prefetcher
+const char* nombreTipoPrefetcher(TipoPrefetcher tipo) {
+    switch (tipo) {
+        case TipoPrefetcher::NINGUNO:         return "ninguno";
+        case TipoPrefetcher::LINEA_SIGUIENTE: return "linea siguiente";
+        case TipoPrefetcher::STRIDE_PC:       return "stride por PC";
+        case TipoPrefetcher::FLUJO:           return "flujo";
+    }
+    return "desconocido";
+}
+
+// prefetcher inactivo
+Prefetcher::Prefetcher() : desplazamientoBloque(0), reloj(0) {}
+
+// constructor con configuracion
+Prefetcher::Prefetcher(const ConfiguracionPrefetch& configuracion, int tamanoBloque) :
+    configuracion(configuracion), desplazamientoBloque(0), reloj(0) {
+
+    // valida los parametros
+    if (configuracion.grado <= 0 || configuracion.distancia <= 0 ||
+        configuracion.entradasTabla <= 0 || configuracion.numFlujos <= 0 ||
+        configuracion.maxEnVuelo <= 0 || configuracion.latencia < 0) {
+        throw std::invalid_argument("Parámetros de prefetch deben ser positivos");
+    }
+    // la cache ya garantiza que el bloque es potencia de dos
+    while ((1 << desplazamientoBloque) < tamanoBloque) ++desplazamientoBloque;
+
+    // reserva solo las tablas del algoritmo elegido
+    if (configuracion.tipo == TipoPrefetcher::STRIDE_PC) tabla.resize(configuracion.entradasTabla);
+    if (configuracion.tipo == TipoPrefetcher::FLUJO) flujos.resize(configuracion.numFlujos);
+}
+
+// observa un acceso de demanda y propone bloques
+void Prefetcher::observar(uint64_t direccion, uint64_t pc, bool disparo, std::vector<uint64_t>& bloques) {
+    const uint64_t bloque = direccion >> desplazamientoBloque;
+    // ultimo numero de bloque del espacio de direcciones
+    const uint64_t ultimoBloque = UINT64_MAX >> desplazamientoBloque;
+    switch (configuracion.tipo) {
+        case TipoPrefetcher::NINGUNO:
+            break;
+        case TipoPrefetcher::LINEA_SIGUIENTE:
+            // prefetch etiquetado: solo tras un fallo o el primer uso de un bloque traido por prefetch
+            if (!disparo) break;
+            for (int i = 0; i < configuracion.grado; ++i) {
+                const uint64_t avance = static_cast<uint64_t>(configuracion.distancia + i);
+                if (avance > ultimoBloque - bloque) break;
+                bloques.push_back(bloque + avance);
+            }
+            break;
+        case TipoPrefetcher::STRIDE_PC:
+            // la tabla aprende de todos los accesos, no solo de los fallos
+            observarStride(direccion, pc, bloques);
+            break;
+        case TipoPrefetcher::FLUJO:
+            if (disparo) observarFlujo(bloque, bloques);
+            break;
+    }
+}
+
+// tabla de prediccion por referencia: un stride y una confianza por instruccion
+void Prefetcher::observarStride(uint64_t direccion, uint64_t pc, std::vector<uint64_t>& bloques) {
+    // hash multiplicativo: los pc de instrucciones cercanas no comparten entrada
+    // (la entrada sale de los bits altos del hash; con el resto modulo el tamaño, pc
+    // separados por multiplos de 0x80 caian en la misma)
+    const uint64_t hash = (pc * 0x9E3779B97F4A7C15ull) >> 32;
+    EntradaStride& entrada = tabla[(hash * tabla.size()) >> 32];
+    // instruccion nueva: ocupa la entrada y empieza a aprender
+    if (!entrada.valida || entrada.pc != pc) {
+        entrada = EntradaStride{pc, direccion, 0, 0, true};
+        return;
+    }
+
+    // confirma o corrige el stride aprendido (la resta modular da el stride con signo)
+    const int64_t nuevoStride = static_cast<int64_t>(direccion - entrada.ultimaDireccion);
+    entrada.ultimaDireccion = direccion;
+    if (nuevoStride == entrada.stride) {
+        if (entrada.confianza < 3) ++entrada.confianza;
+    } else {
+        if (entrada.confianza > 0) --entrada.confianza;
+        if (entrada.confianza == 0) entrada.stride = nuevoStride;
+    }
+    if (entrada.confianza < 2 || entrada.stride == 0) return;
+
+    // pide los bloques que tocaran los accesos distancia, distancia+1... strides por delante
+    const uint64_t bloqueActual = direccion >> desplazamientoBloque;
+    uint64_t anterior = bloqueActual;
+    // magnitud del stride sin signo (tambien vale para INT64_MIN); el producto se comprueba
+    // antes de hacerlo para no desbordar con saltos grandes entre regiones lejanas
+    const bool haciaArriba = entrada.stride > 0;
+    const uint64_t magnitud = haciaArriba ? static_cast<uint64_t>(entrada.stride)
+                                          : 0 - static_cast<uint64_t>(entrada.stride);
+    for (int i = 0; i < configuracion.grado; ++i) {
+        const uint64_t pasos = static_cast<uint64_t>(configuracion.distancia) + static_cast<uint64_t>(i);
+        // el destino se saldria del espacio de direcciones
+        if (magnitud > std::numeric_limits<uint64_t>::max() / pasos) break;
+        const uint64_t salto = magnitud * pasos;
+        if (haciaArriba ? salto > std::numeric_limits<uint64_t>::max() - direccion : salto > direccion) break;
+        const uint64_t destino = haciaArriba ? direccion + salto : direccion - salto;
+        const uint64_t bloqueDestino = destino >> desplazamientoBloque;
+        // strides menores que un bloque repiten bloque: solo cuenta el primero distinto
+        if (bloqueDestino != bloqueActual && bloqueDestino != anterior) {
+            bloques.push_back(bloqueDestino);
+            anterior = bloqueDestino;
+        }
+    }
+}
+
+// buffers de flujo: cada disparo cercano al final de un flujo lo hace avanzar
+void Prefetcher::observarFlujo(uint64_t bloque, std::vector<uint64_t>& bloques) {
+    ++reloj;
+    Flujo* elegido = nullptr;
+    Flujo* masAntiguo = &flujos.front();
+    for (Flujo& flujo : flujos) {
+        if (flujo.valido && flujo.ultimoBloque != bloque &&
+            (bloque - flujo.ultimoBloque <= VENTANA_FLUJO || flujo.ultimoBloque - bloque <= VENTANA_FLUJO)) {
+            elegido = &flujo;
+            break;
+        }
+        // un flujo libre (ultimoUso 0) gana siempre a uno ocupado
+        if (!flujo.valido || flujo.ultimoUso < masAntiguo->ultimoUso) masAntiguo = &flujo;
+    }
+
+    // sin flujo cercano: empieza uno nuevo en lugar del menos reciente
+    if (elegido == nullptr) {
+        *masAntiguo = Flujo{bloque, 0, reloj, true};
+        return;
+    }
+
+    // el segundo disparo fija el sentido y empieza a pedir; un cambio de sentido
+    // espera a que otro disparo lo confirme
+    const int sentido = bloque > elegido->ultimoBloque ? 1 : -1;
+    const bool confirmado = elegido->sentido == sentido || elegido->sentido == 0;
+    elegido->sentido = sentido;
+    elegido->ultimoBloque = bloque;
+    elegido->ultimoUso = reloj;
+    if (!confirmado) return;
+
+    const uint64_t ultimoBloque = UINT64_MAX >> desplazamientoBloque;
+    for (int i = 0; i < configuracion.grado; ++i) {
+        const uint64_t avance = static_cast<uint64_t>(configuracion.distancia + i);
+        if (sentido > 0 ? avance > ultimoBloque - bloque : avance > bloque) break;
+        bloques.push_back(sentido > 0 ? bloque + avance : bloque - avance);
+    }
+}
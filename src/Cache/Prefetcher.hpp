@@ -0,0 +1,125 @@
+// directiva para evitar inclusiones multiples
+#ifndef PREFETCHER_HPP
+#define PREFETCHER_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+
+// algoritmos de prefetch disponibles
+enum class TipoPrefetcher {
+    NINGUNO,          // sin prefetch
+    LINEA_SIGUIENTE,  // bloques consecutivos tras un fallo o el primer uso de un prefetch
+    STRIDE_PC,        // tabla de strides indexada por el pc de la instruccion
+    FLUJO             // buffers de flujo que siguen secuencias ascendentes o descendentes
+};
+
+// parametros del prefetcher de una cache
+struct ConfiguracionPrefetch {
+    TipoPrefetcher tipo = TipoPrefetcher::NINGUNO;
+    // bloques pedidos en cada disparo
+    int grado = 1;
+    // antelacion: bloques por delante (linea siguiente, flujo) o strides por delante (stride)
+    int distancia = 1;
+    // entradas de la tabla de strides
+    int entradasTabla = 64;
+    // flujos seguidos a la vez
+    int numFlujos = 8;
+    // accesos de demanda que tarda en llegar un bloque pedido (0 = llega al instante)
+    int latencia = 0;
+    // peticiones en vuelo como maximo; las que no caben se descartan
+    int maxEnVuelo = 16;
+};
+
+// contadores del prefetch, separados de los accesos de demanda
+struct EstadisticasPrefetch {
+    // peticiones enviadas al nivel inferior
+    uint64_t emitidos = 0;
+    // candidatos que ya estaban en la cache o en vuelo
+    uint64_t redundantes = 0;
+    // candidatos sin hueco en la cola de peticiones en vuelo
+    uint64_t descartados = 0;
+    // lineas traidas por prefetch usadas por la demanda antes de salir
+    uint64_t utiles = 0;
+    // demandas que alcanzaron a un prefetch todavia en vuelo
+    uint64_t tardios = 0;
+    // lineas traidas por prefetch expulsadas sin usar
+    uint64_t inutiles = 0;
+    // suma de accesos entre la llegada de cada prefetch util y su primer uso
+    uint64_t sumaAntelacion = 0;
+
+    // fraccion de prefetches emitidos que pidio despues la demanda
+    double precision() const {
+        return emitidos > 0 ? static_cast<double>(utiles + tardios) / emitidos : 0.0;
+    }
+    // fraccion de los fallos sin prefetch que el prefetch elimino
+    double cobertura(uint64_t fallosDemanda) const {
+        return (utiles + fallosDemanda) > 0 ? static_cast<double>(utiles) / (utiles + fallosDemanda) : 0.0;
+    }
+    // fraccion de prefetches usados que llegaron a tiempo
+    double puntualidad() const {
+        return (utiles + tardios) > 0 ? static_cast<double>(utiles) / (utiles + tardios) : 0.0;
+    }
+    // accesos de media entre la llegada de un prefetch util y su uso
+    double antelacionMedia() const {
+        return utiles > 0 ? static_cast<double>(sumaAntelacion) / utiles : 0.0;
+    }
+};
+
+// generador de candidatos de prefetch a partir de los accesos de demanda
+// no conoce el contenido de la cache: la Cache filtra los bloques ya presentes
+class Prefetcher {
+private:
+    // entrada de la tabla de strides
+    struct EntradaStride {
+        uint64_t pc = 0;
+        uint64_t ultimaDireccion = 0;
+        int64_t stride = 0;
+        // contador saturado de 2 bits; se emite con confianza >= 2
+        int confianza = 0;
+        bool valida = false;
+    };
+    // flujo seguido por el prefetcher de flujos
+    struct Flujo {
+        uint64_t ultimoBloque = 0;
+        // +1 ascendente, -1 descendente, 0 aun sin direccion
+        int sentido = 0;
+        // instante del ultimo uso, para reemplazar el menos reciente
+        uint64_t ultimoUso = 0;
+        bool valido = false;
+    };
+
+    ConfiguracionPrefetch configuracion;
+    // log2 del tamaño de bloque de la cache
+    uint32_t desplazamientoBloque;
+    std::vector<EntradaStride> tabla;
+    std::vector<Flujo> flujos;
+    // disparos observados, reloj del reemplazo de flujos
+    uint64_t reloj;
+
+    // candidatos de cada algoritmo
+    void observarStride(uint64_t direccion, uint64_t pc, std::vector<uint64_t>& bloques);
+    void observarFlujo(uint64_t bloque, std::vector<uint64_t>& bloques);
+
+public:
+    // prefetcher inactivo
+    Prefetcher();
+    // valida la configuracion; lanza std::invalid_argument si algun parametro no es positivo
+    Prefetcher(const ConfiguracionPrefetch& configuracion, int tamanoBloque);
+
+    // observa un acceso de demanda y añade a bloques los numeros de bloque a pedir
+    // disparo = fallo o primer uso de una linea traida por prefetch
+    // nunca propone bloques que den la vuelta al espacio de direcciones
+    void observar(uint64_t direccion, uint64_t pc, bool disparo, std::vector<uint64_t>& bloques);
+
+    // metodos de consulta
+    bool activo() const { return configuracion.tipo != TipoPrefetcher::NINGUNO; }
+    const ConfiguracionPrefetch& getConfiguracion() const { return configuracion; }
+};
+
+// devuelve el nombre legible de un tipo de prefetcher
+const char* nombreTipoPrefetcher(TipoPrefetcher tipo);
+
+// fin de la directiva de preprocesador ifndef
+#endif // PREFETCHER_HPP
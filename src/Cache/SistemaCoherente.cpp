@@ -0,0 +1,389 @@
+// incluye la definicion de la clase SistemaCoherente
+#include "SistemaCoherente.hpp"
+// para entrada/salida por consola
+#include <iostream>
+// para manejo de excepciones
+#include <stdexcept>
+// para std::min, std::max y std::sort
+#include <algorithm>
+// para los hilos de la simulacion
+#include <thread>
+// punto de encuentro de los hilos entre fases
+#include "Common/BarreraHilos.hpp"
+
+// accesos locales que un nucleo aplica como maximo en cada ronda; mantiene a los
+// nucleos avanzando a la par aunque uno de ellos no use el bus (un nucleo se adelanta
+// como mucho un cuanto a los demas)
+constexpr std::size_t CUANTO_RONDA = 4096;
+// aciertos locales por hilo y ronda por debajo de los cuales la ronda sale mas barata
+// en serie que con dos barreras: con muchos fallos las rondas son muy cortas
+constexpr double LOCALES_PARALELO = 1024.0;
+
+// log2 de un entero potencia de dos
+static uint32_t log2Entero(uint32_t valor) {
+    uint32_t resultado = 0;
+    while ((uint32_t(1) << resultado) < valor) ++resultado;
+    return resultado;
+}
+
+// constructor: valida la configuracion y crea una cache privada por nucleo
+SistemaCoherente::SistemaCoherente(int numNucleos, const ConfiguracionNivel& privada,
+                                   const ConfiguracionNivel& ultimoNivel, ProtocoloCoherencia protocolo) :
+    protocolo(protocolo),
+    llc(ultimoNivel.tamano, ultimoNivel.tamanoBloque, ultimoNivel.asociatividad, ultimoNivel.politica) {
+
+    if (numNucleos <= 0 || numNucleos > MAX_NUCLEOS) {
+        throw std::invalid_argument("Número de núcleos debe estar entre 1 y 64");
+    }
+    if (privada.tamanoBloque != ultimoNivel.tamanoBloque) {
+        throw std::invalid_argument("Las cachés privadas y la LLC deben compartir tamaño de bloque");
+    }
+
+    // la llc guarda los bloques modificados que le devuelven las caches privadas
+    llc.configurarEscritura(PoliticaEscritura::WRITE_BACK, true);
+    privadas.reserve(numNucleos);
+    for (int nucleo = 0; nucleo < numNucleos; ++nucleo) {
+        privadas.emplace_back(privada.tamano, privada.tamanoBloque, privada.asociatividad, privada.politica);
+    }
+    lineas.resize(numNucleos);
+    progreso.resize(numNucleos);
+
+    // palabras de 4 bytes mientras quepan 64 por bloque
+    desplazamientoBloque = log2Entero(static_cast<uint32_t>(privada.tamanoBloque));
+    desplazamientoPalabra = desplazamientoBloque > 8 ? desplazamientoBloque - 6
+                                                     : std::min<uint32_t>(2, desplazamientoBloque);
+}
+
+// acierto local: no cambia el estado de ningun otro nucleo
+bool SistemaCoherente::intentarLocal(int nucleo, uint64_t direccion, bool escritura) {
+    auto linea = lineas[nucleo].find(direccion >> desplazamientoBloque);
+    if (linea == lineas[nucleo].end()) return false;
+    // escribir sobre una copia compartida necesita invalidar las demas
+    if (escritura) {
+        if (linea->second.estado == EstadoCoherencia::COMPARTIDO ||
+            linea->second.estado == EstadoCoherencia::PROPIETARIO) {
+            return false;
+        }
+        // E pasa a M sin avisar a nadie
+        linea->second.estado = EstadoCoherencia::MODIFICADO;
+    }
+    linea->second.palabras |= bitPalabra(direccion);
+    // actualiza el reemplazo y los aciertos de la cache privada
+    privadas[nucleo].acceder(direccion);
+    return true;
+}
+
+// aciertos locales de una ronda
+void SistemaCoherente::avanzarLocal(int nucleo, const TrazaNucleo& traza) {
+    ProgresoNucleo& avance = progreso[nucleo];
+    const std::size_t fin = std::min(traza.direcciones.size(), avance.posicion + CUANTO_RONDA);
+    while (avance.posicion < fin) {
+        const bool escritura = !traza.tipos.empty() && traza.tipos[avance.posicion] == TipoAcceso::ESCRITURA;
+        if (!intentarLocal(nucleo, traza.direcciones[avance.posicion], escritura)) {
+            avance.pendiente = true;
+            return;
+        }
+        if (escritura) avance.estadisticas.escrituras++;
+        else avance.estadisticas.lecturas++;
+        ++avance.posicion;
+    }
+}
+
+// fallo o peticion de exclusividad: transacciones de bus y cambios de estado
+void SistemaCoherente::resolverPendiente(int nucleo, uint64_t direccion, bool escritura) {
+    const uint64_t bloque = direccion >> desplazamientoBloque;
+    const uint64_t palabra = bitPalabra(direccion);
+    const uint64_t bitNucleo = uint64_t(1) << nucleo;
+    auto& propias = lineas[nucleo];
+
+    // 1. escritura sobre una copia propia compartida (S u O): BusUpgr
+    auto propia = propias.find(bloque);
+    if (propia != propias.end()) {
+        privadas[nucleo].acceder(direccion);
+        estadisticas.actualizacionesBus++;
+        progreso[nucleo].estadisticas.actualizaciones++;
+        // la copia propia esta al dia: los demas solo se invalidan
+        invalidarOtros(nucleo, bloque, palabra);
+        propia->second.estado = EstadoCoherencia::MODIFICADO;
+        propia->second.palabras |= palabra;
+        return;
+    }
+
+    // 2. fallo en la cache privada: primero sale la victima
+    Desalojo desalojo;
+    privadas[nucleo].acceder(direccion, desalojo);
+    if (desalojo.valido) retirarDeNucleo(nucleo, desalojo.direccionBloque >> desplazamientoBloque);
+
+    // otros nucleos con copia y, si lo hay, el que responde con los datos (M, O o E)
+    auto entrada = compartidores.find(bloque);
+    const uint64_t otros = entrada != compartidores.end() ? entrada->second & ~bitNucleo : 0;
+    int dueno = -1;
+    for (uint64_t resto = otros; resto != 0 && dueno < 0; resto &= resto - 1) {
+        const int otro = __builtin_ctzll(resto);
+        if (lineas[otro].at(bloque).estado != EstadoCoherencia::COMPARTIDO) dueno = otro;
+    }
+
+    EstadoCoherencia nuevo;
+    if (escritura) {
+        // BusRdX: el dueño entrega el bloque y todas las copias se invalidan
+        estadisticas.lecturasExclusivasBus++;
+        if (dueno >= 0) estadisticas.transferencias++;
+        else llc.acceder(direccion);
+        invalidarOtros(nucleo, bloque, palabra);
+        nuevo = EstadoCoherencia::MODIFICADO;
+    } else {
+        // BusRd: el dueño entrega el bloque y deja de ser exclusivo
+        estadisticas.lecturasBus++;
+        if (dueno >= 0) {
+            estadisticas.transferencias++;
+            LineaNucleo& suya = lineas[dueno].at(bloque);
+            if (suya.estado == EstadoCoherencia::MODIFICADO && protocolo == ProtocoloCoherencia::MOESI) {
+                // MOESI: sigue siendo responsable de los datos modificados
+                suya.estado = EstadoCoherencia::PROPIETARIO;
+            } else if (suya.estado == EstadoCoherencia::MODIFICADO) {
+                // MESI: los datos modificados se escriben en la LLC al compartirse
+                escribirEnLlc(bloque);
+                estadisticas.volcados++;
+                suya.estado = EstadoCoherencia::COMPARTIDO;
+            } else if (suya.estado == EstadoCoherencia::EXCLUSIVO) {
+                suya.estado = EstadoCoherencia::COMPARTIDO;
+            }
+        } else {
+            llc.acceder(direccion);
+        }
+        nuevo = otros != 0 ? EstadoCoherencia::COMPARTIDO : EstadoCoherencia::EXCLUSIVO;
+    }
+    propias[bloque] = LineaNucleo{nuevo, palabra};
+    compartidores[bloque] |= bitNucleo;
+}
+
+// invalida las demas copias y registra si la comparticion era falsa
+void SistemaCoherente::invalidarOtros(int nucleo, uint64_t bloque, uint64_t palabra) {
+    auto entrada = compartidores.find(bloque);
+    if (entrada == compartidores.end()) return;
+    const uint64_t bitNucleo = uint64_t(1) << nucleo;
+
+    ComparticionBloque* registro = nullptr;
+    for (uint64_t otros = entrada->second & ~bitNucleo; otros != 0; otros &= otros - 1) {
+        const int otro = __builtin_ctzll(otros);
+        auto linea = lineas[otro].find(bloque);
+        // el otro nucleo nunca uso la palabra que se escribe: solo comparten el bloque
+        const bool falsa = (linea->second.palabras & palabra) == 0;
+        if (registro == nullptr) {
+            registro = &comparticion[bloque];
+            registro->direccionBloque = bloque << desplazamientoBloque;
+        }
+        registro->invalidaciones++;
+        registro->invalidacionesFalsas += falsa;
+        estadisticas.invalidaciones++;
+        estadisticas.invalidacionesFalsas += falsa;
+        progreso[otro].estadisticas.invalidacionesRecibidas++;
+
+        privadas[otro].invalidar(bloque << desplazamientoBloque);
+        lineas[otro].erase(linea);
+    }
+    entrada->second &= bitNucleo;
+}
+
+// una victima de la cache privada deja el directorio; si estaba modificada baja a la LLC
+void SistemaCoherente::retirarDeNucleo(int nucleo, uint64_t bloque) {
+    auto linea = lineas[nucleo].find(bloque);
+    if (linea->second.estado == EstadoCoherencia::MODIFICADO ||
+        linea->second.estado == EstadoCoherencia::PROPIETARIO) {
+        escribirEnLlc(bloque);
+        estadisticas.devoluciones++;
+    }
+    lineas[nucleo].erase(linea);
+
+    auto entrada = compartidores.find(bloque);
+    entrada->second &= ~(uint64_t(1) << nucleo);
+    if (entrada->second == 0) compartidores.erase(entrada);
+}
+
+// la LLC recibe un bloque modificado sin contarlo como acceso
+void SistemaCoherente::escribirEnLlc(uint64_t bloque) {
+    Desalojo desalojo;
+    llc.insertar(bloque << desplazamientoBloque, desalojo, true);
+}
+
+// acceso inmediato de un nucleo
+bool SistemaCoherente::acceder(int nucleo, uint64_t direccion, TipoAcceso tipo) {
+    if (nucleo < 0 || nucleo >= getNumNucleos()) {
+        throw std::invalid_argument("Núcleo fuera de rango");
+    }
+    const bool escritura = tipo == TipoAcceso::ESCRITURA;
+    if (escritura) progreso[nucleo].estadisticas.escrituras++;
+    else progreso[nucleo].estadisticas.lecturas++;
+
+    if (intentarLocal(nucleo, direccion, escritura)) return true;
+    resolverPendiente(nucleo, direccion, escritura);
+    return false;
+}
+
+// rondas de aciertos locales en paralelo y resolucion ordenada de los accesos al bus
+void SistemaCoherente::simular(const std::vector<TrazaNucleo>& trazas, unsigned hilos) {
+    const int numNucleos = getNumNucleos();
+    if (trazas.size() != static_cast<std::size_t>(numNucleos)) {
+        throw std::invalid_argument("Se necesita una traza por núcleo");
+    }
+    for (const TrazaNucleo& traza : trazas) {
+        if (!traza.tipos.empty() && traza.tipos.size() != traza.direcciones.size()) {
+            throw std::invalid_argument("Cada acceso de la traza necesita su tipo");
+        }
+    }
+    for (ProgresoNucleo& avance : progreso) {
+        avance.posicion = 0;
+        avance.pendiente = false;
+    }
+
+    // por defecto un hilo por nucleo del anfitrion, nunca mas que nucleos simulados
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = std::min(hilos, static_cast<unsigned>(numNucleos));
+    BarreraHilos barrera(hilos);
+    bool terminado = false;
+
+    // accesos aplicados por todos los nucleos al cerrar la ronda anterior
+    std::size_t aplicados = 0;
+    // media movil de los aciertos locales por ronda; empieza suponiendo rondas largas
+    double localesPorRonda = LOCALES_PARALELO * hilos;
+
+    // accesos al bus en orden de nucleo; solo el hilo 0
+    auto resolverRonda = [&] {
+        std::size_t total = 0;
+        for (const ProgresoNucleo& avance : progreso) total += avance.posicion;
+        localesPorRonda = (localesPorRonda * 7.0 + static_cast<double>(total - aplicados)) / 8.0;
+
+        terminado = true;
+        for (int nucleo = 0; nucleo < numNucleos; ++nucleo) {
+            ProgresoNucleo& avance = progreso[nucleo];
+            const TrazaNucleo& traza = trazas[nucleo];
+            if (avance.pendiente) {
+                const bool escritura = !traza.tipos.empty() &&
+                                       traza.tipos[avance.posicion] == TipoAcceso::ESCRITURA;
+                resolverPendiente(nucleo, traza.direcciones[avance.posicion], escritura);
+                if (escritura) avance.estadisticas.escrituras++;
+                else avance.estadisticas.lecturas++;
+                ++avance.posicion;
+                ++total;
+                avance.pendiente = false;
+            }
+            terminado = terminado && avance.posicion >= traza.direcciones.size();
+        }
+        aplicados = total;
+    };
+
+    // cuerpo de cada hilo; el hilo llamador hace de hilo 0 y de arbitro del bus
+    auto trabajar = [&](unsigned hilo) {
+        while (true) {
+            // 1. aciertos locales: cada hilo solo toca el estado de sus nucleos
+            for (int nucleo = static_cast<int>(hilo); nucleo < numNucleos; nucleo += static_cast<int>(hilos)) {
+                if (!progreso[nucleo].pendiente) avanzarLocal(nucleo, trazas[nucleo]);
+            }
+            barrera.esperar();
+
+            // 2. accesos al bus; mientras las rondas sean cortas el hilo 0 sigue solo con las
+            // siguientes (las mismas rondas, asi que el resultado no cambia) y los demas
+            // esperan en la barrera
+            if (hilo == 0) {
+                resolverRonda();
+                while (!terminado && localesPorRonda < LOCALES_PARALELO * hilos) {
+                    for (int nucleo = 0; nucleo < numNucleos; ++nucleo) {
+                        if (!progreso[nucleo].pendiente) avanzarLocal(nucleo, trazas[nucleo]);
+                    }
+                    resolverRonda();
+                }
+            }
+            barrera.esperar();
+            if (terminado) return;
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(hilos - 1);
+    for (unsigned hilo = 1; hilo < hilos; ++hilo) {
+        trabajadores.emplace_back(trabajar, hilo);
+    }
+    trabajar(0);
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+// estado de coherencia de un bloque en un nucleo
+EstadoCoherencia SistemaCoherente::getEstado(int nucleo, uint64_t direccion) const {
+    auto linea = lineas.at(nucleo).find(direccion >> desplazamientoBloque);
+    return linea != lineas[nucleo].end() ? linea->second.estado : EstadoCoherencia::INVALIDO;
+}
+
+// bloques con comparticion falsa ordenados por invalidaciones falsas
+std::vector<ComparticionBloque> SistemaCoherente::getComparticionFalsa() const {
+    std::vector<ComparticionBloque> bloques;
+    for (const auto& entrada : comparticion) {
+        if (entrada.second.invalidacionesFalsas > 0) bloques.push_back(entrada.second);
+    }
+    std::sort(bloques.begin(), bloques.end(), [](const ComparticionBloque& a, const ComparticionBloque& b) {
+        if (a.invalidacionesFalsas != b.invalidacionesFalsas) return a.invalidacionesFalsas > b.invalidacionesFalsas;
+        return a.direccionBloque < b.direccionBloque;
+    });
+    return bloques;
+}
+
+// bloques con comparticion falsa que se muestran
+constexpr std::size_t BLOQUES_FALSOS_MOSTRADOS = 10;
+
+// muestra las estadisticas del sistema
+void SistemaCoherente::imprimirEstadisticas() const {
+    std::cout << "\n=== Sistema coherente " << nombreProtocoloCoherencia(protocolo) << " ("
+              << getNumNucleos() << " núcleos) ===\n";
+    for (int nucleo = 0; nucleo < getNumNucleos(); ++nucleo) {
+        const Cache& cache = privadas[nucleo];
+        const EstadisticasNucleo& e = progreso[nucleo].estadisticas;
+        std::cout << "Núcleo " << nucleo << ": " << (e.lecturas + e.escrituras) << " accesos ("
+                  << e.escrituras << " escrituras), " << cache.getTasaAciertos() << "% aciertos, "
+                  << e.actualizaciones << " actualizaciones, "
+                  << e.invalidacionesRecibidas << " invalidaciones recibidas\n";
+    }
+
+    const EstadisticasCoherencia& e = estadisticas;
+    std::cout << "Bus: " << e.lecturasBus << " BusRd, " << e.lecturasExclusivasBus << " BusRdX, "
+              << e.actualizacionesBus << " BusUpgr\n";
+    std::cout << "Invalidaciones: " << e.invalidaciones << " (falsas: " << e.invalidacionesFalsas << ", "
+              << (e.invalidaciones > 0 ? e.invalidacionesFalsas * 100.0 / e.invalidaciones : 0.0) << "%)\n";
+    std::cout << "Datos de coherencia: " << e.transferencias << " transferencias entre cachés, "
+              << e.volcados << " volcados, " << e.devoluciones << " devoluciones ("
+              << getBytesCoherencia() << " bytes)\n";
+    std::cout << "LLC: " << (llc.getAciertos() + llc.getFallos()) << " accesos, " << llc.getTasaAciertos()
+              << "% aciertos, " << llc.getBytesLeidos() << " bytes leídos de memoria, "
+              << llc.getBytesEscritos() << " bytes escritos\n";
+
+    const std::vector<ComparticionBloque> falsos = getComparticionFalsa();
+    if (!falsos.empty()) {
+        std::cout << "Bloques con compartición falsa (" << falsos.size() << "):\n";
+        for (std::size_t i = 0; i < falsos.size() && i < BLOQUES_FALSOS_MOSTRADOS; ++i) {
+            std::cout << "  0x" << std::hex << falsos[i].direccionBloque << std::dec << ": "
+                      << falsos[i].invalidacionesFalsas << " de " << falsos[i].invalidaciones
+                      << " invalidaciones\n";
+        }
+    }
+}
+
+// nombre legible de un protocolo
+const char* nombreProtocoloCoherencia(ProtocoloCoherencia protocolo) {
+    switch (protocolo) {
+        case ProtocoloCoherencia::MESI: return "MESI";
+        case ProtocoloCoherencia::MOESI: return "MOESI";
+    }
+    return "desconocido";
+}
+
+// letra de un estado
+const char* nombreEstadoCoherencia(EstadoCoherencia estado) {
+    switch (estado) {
+        case EstadoCoherencia::INVALIDO: return "I";
+        case EstadoCoherencia::COMPARTIDO: return "S";
+        case EstadoCoherencia::EXCLUSIVO: return "E";
+        case EstadoCoherencia::MODIFICADO: return "M";
+        case EstadoCoherencia::PROPIETARIO: return "O";
+    }
+    return "?";
+}
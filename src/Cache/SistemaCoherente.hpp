@@ -0,0 +1,187 @@
+// directiva para evitar inclusiones multiples
+#ifndef SISTEMACOHERENTE_HPP
+#define SISTEMACOHERENTE_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion para los directorios de bloques
+#include <unordered_map>
+// inclusion de la cache de un nivel
+#include "Cache.hpp"
+// inclusion de la configuracion de nivel (geometria y politicas)
+#include "JerarquiaCache.hpp"
+
+// protocolo de coherencia entre las caches privadas
+enum class ProtocoloCoherencia {
+    MESI,   // un bloque modificado que se comparte se escribe antes en la LLC
+    MOESI   // el dueño de un bloque modificado lo comparte sin escribirlo (estado O)
+};
+
+// estado de un bloque en la cache privada de un nucleo
+enum class EstadoCoherencia : uint8_t {
+    INVALIDO,
+    COMPARTIDO,
+    EXCLUSIVO,
+    MODIFICADO,
+    PROPIETARIO  // solo MOESI: modificado y compartido, el dueño responde por el
+};
+
+// accesos de un nucleo en orden de programa
+struct TrazaNucleo {
+    std::vector<uint64_t> direcciones;
+    // tipo de cada acceso; vacio = todo lecturas
+    std::vector<TipoAcceso> tipos;
+};
+
+// contadores de un nucleo
+struct EstadisticasNucleo {
+    uint64_t lecturas = 0;
+    uint64_t escrituras = 0;
+    // escrituras sobre una copia compartida que piden la exclusividad (BusUpgr)
+    uint64_t actualizaciones = 0;
+    // copias propias invalidadas por escrituras de otros nucleos
+    uint64_t invalidacionesRecibidas = 0;
+};
+
+// mensajes y datos que cruzan el bus de coherencia
+struct EstadisticasCoherencia {
+    // lecturas de bloque por fallo de lectura (BusRd)
+    uint64_t lecturasBus = 0;
+    // lecturas con intencion de escribir por fallo de escritura (BusRdX)
+    uint64_t lecturasExclusivasBus = 0;
+    // peticiones de exclusividad sin datos (BusUpgr)
+    uint64_t actualizacionesBus = 0;
+    // copias invalidadas en otros nucleos
+    uint64_t invalidaciones = 0;
+    // invalidaciones en las que el nucleo invalidado no usaba la palabra escrita
+    uint64_t invalidacionesFalsas = 0;
+    // bloques servidos por otra cache privada en lugar de la LLC
+    uint64_t transferencias = 0;
+    // bloques modificados escritos en la LLC al pasar a compartidos (solo MESI)
+    uint64_t volcados = 0;
+    // bloques modificados escritos en la LLC al salir de una cache privada
+    uint64_t devoluciones = 0;
+};
+
+// comparticion de un bloque concreto
+struct ComparticionBloque {
+    uint64_t direccionBloque = 0;
+    uint64_t invalidaciones = 0;
+    uint64_t invalidacionesFalsas = 0;
+};
+
+// N nucleos con caches privadas coherentes que comparten una LLC
+//
+// la simulacion avanza por rondas: en cada ronda cada nucleo aplica en paralelo
+// sus aciertos locales (lecturas de bloques presentes, escrituras en E o M) hasta
+// encontrar un acceso que necesita el bus o agotar el cuanto; despues los accesos
+// pendientes se resuelven uno por nucleo en orden de nucleo. El orden global que
+// resulta no depende del numero de hilos, asi que los resultados son deterministas.
+// Cada ronda acaba en el primer fallo de cada nucleo: con muchos fallos las rondas
+// son cortas y no compensan las barreras, y el hilo 0 las hace solo hasta que
+// vuelven a alargarse
+class SistemaCoherente {
+private:
+    // linea presente en la cache privada de un nucleo
+    struct LineaNucleo {
+        EstadoCoherencia estado;
+        // palabras del bloque usadas por el nucleo desde que tiene la copia
+        uint64_t palabras;
+    };
+    // avance y contadores de un nucleo, en lineas del anfitrion distintas
+    struct alignas(TAMANO_LINEA_ANFITRION) ProgresoNucleo {
+        // siguiente acceso de la traza
+        std::size_t posicion = 0;
+        // true si el acceso en posicion necesita el bus
+        bool pendiente = false;
+        EstadisticasNucleo estadisticas;
+    };
+
+    ProtocoloCoherencia protocolo;
+    // caches privadas, una por nucleo
+    std::vector<Cache> privadas;
+    // cache de ultimo nivel compartida
+    Cache llc;
+    // estado de coherencia de las lineas de cada nucleo (solo las validas)
+    std::vector<std::unordered_map<uint64_t, LineaNucleo>> lineas;
+    // directorio: nucleos con copia de cada bloque (un bit por nucleo)
+    std::unordered_map<uint64_t, uint64_t> compartidores;
+    // invalidaciones por bloque
+    std::unordered_map<uint64_t, ComparticionBloque> comparticion;
+    std::vector<ProgresoNucleo> progreso;
+    EstadisticasCoherencia estadisticas;
+
+    // geometria comun
+    uint32_t desplazamientoBloque;
+    // log2 de los bytes que representa cada bit de LineaNucleo::palabras
+    uint32_t desplazamientoPalabra;
+
+    // bit de la palabra accedida dentro de su bloque
+    uint64_t bitPalabra(uint64_t direccion) const {
+        const uint64_t desplazamiento = direccion & ((uint64_t(1) << desplazamientoBloque) - 1);
+        return uint64_t(1) << (desplazamiento >> desplazamientoPalabra);
+    }
+    // aplica el acceso si no necesita el bus (bloque presente y, si escribe, en E o M)
+    bool intentarLocal(int nucleo, uint64_t direccion, bool escritura);
+    // aplica los aciertos locales del nucleo hasta un acceso que necesita el bus
+    void avanzarLocal(int nucleo, const TrazaNucleo& traza);
+    // resuelve un acceso que necesita el bus (fallo o escritura sobre copia compartida)
+    void resolverPendiente(int nucleo, uint64_t direccion, bool escritura);
+    // invalida las copias de los demas nucleos por una escritura de nucleo
+    void invalidarOtros(int nucleo, uint64_t bloque, uint64_t palabra);
+    // retira un bloque desalojado de la cache privada del nucleo
+    void retirarDeNucleo(int nucleo, uint64_t bloque);
+    // escribe un bloque modificado en la LLC
+    void escribirEnLlc(uint64_t bloque);
+
+public:
+    // numero maximo de nucleos (el directorio usa un bit por nucleo)
+    static constexpr int MAX_NUCLEOS = 64;
+
+    // todos los niveles deben compartir tamaño de bloque; las caches privadas y la
+    // LLC usan la geometria y la politica de reemplazo indicadas (la coherencia
+    // decide las escrituras, las politicas de escritura se ignoran)
+    // lanza std::invalid_argument si algun parametro no es valido
+    SistemaCoherente(int numNucleos, const ConfiguracionNivel& privada, const ConfiguracionNivel& ultimoNivel,
+                     ProtocoloCoherencia protocolo = ProtocoloCoherencia::MESI);
+
+    // simula un acceso de un nucleo de forma inmediata (sin rondas)
+    // devuelve true si acerto en su cache privada sin usar el bus
+    bool acceder(int nucleo, uint64_t direccion, TipoAcceso tipo = TipoAcceso::LECTURA);
+    // simula las trazas de todos los nucleos (una por nucleo) continuando el estado actual
+    // hilos=0 usa todos los nucleos del anfitrion; el resultado es el mismo con cualquier numero
+    // los hilos solo ganan cuando los nucleos encadenan miles de aciertos privados entre fallos
+    void simular(const std::vector<TrazaNucleo>& trazas, unsigned hilos = 0);
+
+    // muestra contadores por nucleo, trafico de coherencia y bloques con comparticion falsa
+    void imprimirEstadisticas() const;
+
+    // metodos de consulta
+    int getNumNucleos() const { return static_cast<int>(privadas.size()); }
+    ProtocoloCoherencia getProtocolo() const { return protocolo; }
+    const Cache& getPrivada(int nucleo) const { return privadas[nucleo]; }
+    const Cache& getLlc() const { return llc; }
+    const EstadisticasNucleo& getEstadisticasNucleo(int nucleo) const { return progreso[nucleo].estadisticas; }
+    const EstadisticasCoherencia& getEstadisticas() const { return estadisticas; }
+    // estado del bloque que contiene la direccion en la cache privada del nucleo
+    EstadoCoherencia getEstado(int nucleo, uint64_t direccion) const;
+    // bytes de datos movidos por coherencia: transferencias, volcados y devoluciones
+    uint64_t getBytesCoherencia() const {
+        return (estadisticas.transferencias + estadisticas.volcados + estadisticas.devoluciones) *
+               static_cast<uint64_t>(llc.getTamanoBloque());
+    }
+    // bloques con alguna invalidacion falsa, de mas a menos invalidaciones falsas
+    std::vector<ComparticionBloque> getComparticionFalsa() const;
+};
+
+// devuelve el nombre legible de un protocolo de coherencia
+const char* nombreProtocoloCoherencia(ProtocoloCoherencia protocolo);
+// devuelve la letra del estado (M, O, E, S, I)
+const char* nombreEstadoCoherencia(EstadoCoherencia estado);
+
+// fin de la directiva de preprocesador ifndef
+#endif // SISTEMACOHERENTE_HPP
@@ -0,0 +1,168 @@
+// incluye la definicion de la clase Tlb
+#include "Tlb.hpp"
+// para entrada/salida por consola
+#include <iostream>
+// para manejo de excepciones
+#include <stdexcept>
+
+// bits de direccion virtual que traduce la tabla de 4 niveles
+constexpr uint32_t BITS_VIRTUALES = 48;
+// bits de indice de cada nivel (512 entradas de 8 bytes por nodo de 4K)
+constexpr uint32_t BITS_NIVEL = 9;
+// bytes de una entrada de la tabla
+constexpr uint64_t BYTES_ENTRADA = 8;
+// bytes de un nodo de la tabla
+constexpr uint64_t BYTES_NODO = 4096;
+// primera direccion fisica reservada (la pagina cero queda sin usar)
+constexpr uint64_t INICIO_FISICO = 0x100000;
+
+// bytes de un tamaño de pagina
+uint64_t bytesPagina(TamanoPagina tamano) {
+    switch (tamano) {
+        case TamanoPagina::PAGINA_4K: return uint64_t(1) << 12;
+        case TamanoPagina::PAGINA_2M: return uint64_t(1) << 21;
+        case TamanoPagina::PAGINA_1G: return uint64_t(1) << 30;
+    }
+    return uint64_t(1) << 12;
+}
+
+// devuelve el nombre legible de un tamaño de pagina
+const char* nombreTamanoPagina(TamanoPagina tamano) {
+    switch (tamano) {
+        case TamanoPagina::PAGINA_4K: return "4K";
+        case TamanoPagina::PAGINA_2M: return "2M";
+        case TamanoPagina::PAGINA_1G: return "1G";
+    }
+    return "Desconocido";
+}
+
+// numero de niveles que recorre una pagina: 4 para 4K, 3 para 2M y 2 para 1G
+static uint32_t nivelesRecorrido(TamanoPagina tamano) {
+    return 4 - static_cast<uint32_t>(tamano);
+}
+
+// clave de una pagina: el tamaño en los bits altos y el numero de pagina debajo,
+// asi el indice de conjunto de la TLB sale de los bits bajos del numero de pagina
+static uint64_t clavePagina(uint64_t direccionVirtual, TamanoPagina tamano) {
+    const uint64_t pagina = (direccionVirtual & ((uint64_t(1) << BITS_VIRTUALES) - 1)) / bytesPagina(tamano);
+    return (static_cast<uint64_t>(tamano) << 62) | pagina;
+}
+
+// constructor: arreglos con bloques de un byte, una entrada de TLB por bloque
+Tlb::Tlb(const ConfiguracionTlb& configuracion) :
+    l1Pequenas(configuracion.entradasL1, 1, configuracion.viasL1),
+    l1Grandes(configuracion.entradasL1Grandes, 1, configuracion.viasL1Grandes),
+    l1Gigantes(configuracion.entradasL1Gigantes, 1, configuracion.viasL1Gigantes),
+    l2(configuracion.entradasL2, 1, configuracion.viasL2),
+    configuracion(configuracion), siguienteFisica(INICIO_FISICO) {
+
+    for (const RegionPaginas& region : configuracion.regiones) {
+        const uint64_t bytes = bytesPagina(region.tamano);
+        if (region.fin <= region.inicio || region.inicio % bytes != 0 || region.fin % bytes != 0) {
+            throw std::invalid_argument("Las regiones deben ser no vacias y alineadas a su tamaño de pagina");
+        }
+    }
+
+    // la raiz de la tabla existe desde el principio
+    nodos.emplace(0, reservarFisica(BYTES_NODO));
+}
+
+// reserva memoria fisica alineada a su tamaño
+uint64_t Tlb::reservarFisica(uint64_t bytes) {
+    const uint64_t base = (siguienteFisica + bytes - 1) & ~(bytes - 1);
+    siguienteFisica = base + bytes;
+    return base;
+}
+
+// arreglo L1 de un tamaño de pagina
+Cache& Tlb::l1De(TamanoPagina tamano) {
+    switch (tamano) {
+        case TamanoPagina::PAGINA_2M: return l1Grandes;
+        case TamanoPagina::PAGINA_1G: return l1Gigantes;
+        default: return l1Pequenas;
+    }
+}
+
+// tamaño de pagina de una direccion virtual
+TamanoPagina Tlb::tamanoPagina(uint64_t direccionVirtual) const {
+    for (const RegionPaginas& region : configuracion.regiones) {
+        if (direccionVirtual >= region.inicio && direccionVirtual < region.fin) return region.tamano;
+    }
+    return configuracion.paginaPorDefecto;
+}
+
+// recorre la tabla nivel a nivel leyendo cada entrada a traves de la cache
+uint64_t Tlb::recorrer(uint64_t direccionVirtual, TamanoPagina tamano, Cache& cache) {
+    const uint64_t virtual48 = direccionVirtual & ((uint64_t(1) << BITS_VIRTUALES) - 1);
+    const uint32_t niveles = nivelesRecorrido(tamano);
+    estadisticas.recorridos++;
+
+    uint64_t nodo = nodos.at(0);
+    for (uint32_t nivel = 0; nivel < niveles; ++nivel) {
+        // bits del indice de este nivel: 47-39, 38-30, 29-21 y 20-12
+        const uint32_t desplazamiento = BITS_VIRTUALES - BITS_NIVEL * (nivel + 1);
+        const uint64_t indice = (virtual48 >> desplazamiento) & ((uint64_t(1) << BITS_NIVEL) - 1);
+
+        // la lectura de la entrada es un acceso mas de la cache de datos
+        estadisticas.referenciasRecorrido++;
+        if (cache.acceder(nodo + indice * BYTES_ENTRADA)) estadisticas.aciertosRecorrido++;
+
+        // el siguiente nodo cubre el prefijo virtual que acaba de indexarse
+        if (nivel + 1 < niveles) {
+            const uint64_t clave = (static_cast<uint64_t>(nivel + 1) << 56) | (virtual48 >> desplazamiento);
+            auto hijo = nodos.find(clave);
+            if (hijo == nodos.end()) hijo = nodos.emplace(clave, reservarFisica(BYTES_NODO)).first;
+            nodo = hijo->second;
+        }
+    }
+
+    // la ultima entrada leida apunta al marco de la pagina
+    const uint64_t clave = clavePagina(direccionVirtual, tamano);
+    auto marco = marcos.find(clave);
+    if (marco == marcos.end()) {
+        marco = marcos.emplace(clave, reservarFisica(bytesPagina(tamano))).first;
+        estadisticas.paginas[static_cast<int>(tamano)]++;
+    }
+    return marco->second;
+}
+
+// traduce: L1 del tamaño de pagina, L2 unificada y, si ambas fallan, recorrido
+uint64_t Tlb::traducir(uint64_t direccionVirtual, Cache& cache) {
+    const TamanoPagina tamano = tamanoPagina(direccionVirtual);
+    const uint64_t clave = clavePagina(direccionVirtual, tamano);
+    const uint64_t desplazamiento = direccionVirtual & (bytesPagina(tamano) - 1);
+    estadisticas.accesos++;
+
+    // los fallos de L1 y L2 rellenan su entrada al consultarla
+    if (l1De(tamano).acceder(clave)) {
+        estadisticas.aciertosL1++;
+    } else if (l2.acceder(clave)) {
+        estadisticas.aciertosL2++;
+    } else {
+        return recorrer(direccionVirtual, tamano, cache) + desplazamiento;
+    }
+    // con acierto en TLB la pagina ya esta mapeada
+    return marcos.at(clave) + desplazamiento;
+}
+
+// muestra las estadisticas de traduccion
+void Tlb::imprimirEstadisticas(int tamanoBloqueCache) const {
+    const EstadisticasTlb& e = estadisticas;
+    const uint64_t fallosRecorrido = e.referenciasRecorrido - e.aciertosRecorrido;
+    std::cout << "\n=== TLB (L1 " << configuracion.entradasL1 << "/" << configuracion.entradasL1Grandes
+              << "/" << configuracion.entradasL1Gigantes << " entradas, L2 " << configuracion.entradasL2
+              << " entradas) ===\n";
+    std::cout << "Traducciones: " << e.accesos << "\n";
+    std::cout << "Tasa de fallos L1: " << (e.tasaFallosL1() * 100) << "%  L2: "
+              << (e.tasaFallosL2() * 100) << "%\n";
+    std::cout << "Recorridos: " << e.recorridos << "  Lecturas de tabla: " << e.referenciasRecorrido
+              << " (" << (e.recorridos > 0 ? static_cast<double>(e.referenciasRecorrido) / e.recorridos : 0.0)
+              << " por recorrido)\n";
+    std::cout << "Lecturas de tabla que fallan en cache: " << fallosRecorrido << " ("
+              << (e.referenciasRecorrido > 0 ? static_cast<double>(fallosRecorrido) / e.referenciasRecorrido * 100 : 0.0)
+              << "%)\n";
+    std::cout << "Trafico de recorridos: " << getBytesRecorrido() << " bytes leidos, "
+              << fallosRecorrido * static_cast<uint64_t>(tamanoBloqueCache) << " bytes traidos a cache\n";
+    std::cout << "Paginas tocadas: " << e.paginas[0] << " de 4K, " << e.paginas[1] << " de 2M, "
+              << e.paginas[2] << " de 1G\n";
+}
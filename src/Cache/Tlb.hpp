@@ -0,0 +1,131 @@
+// directiva para evitar inclusiones multiples
+#ifndef TLB_HPP
+#define TLB_HPP
+
+// inclusion para usar contenedor vector
+#include <vector>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion para las tablas de paginas
+#include <unordered_map>
+// inclusion de la cache (los arreglos de la TLB y la cache de datos)
+#include "Cache.hpp"
+
+// tamaños de pagina de x86-64
+enum class TamanoPagina {
+    PAGINA_4K,
+    PAGINA_2M,
+    PAGINA_1G
+};
+
+// rango de direcciones virtuales [inicio, fin) respaldado por un tamaño de pagina
+struct RegionPaginas {
+    uint64_t inicio;
+    uint64_t fin;
+    TamanoPagina tamano;
+};
+
+// geometria de las TLB y reparto de tamaños de pagina
+struct ConfiguracionTlb {
+    // L1: un arreglo por tamaño de pagina (entradas y vias)
+    int entradasL1 = 64;
+    int viasL1 = 4;
+    int entradasL1Grandes = 32;
+    int viasL1Grandes = 4;
+    int entradasL1Gigantes = 4;
+    int viasL1Gigantes = 4;
+    // L2 unificada para todos los tamaños
+    int entradasL2 = 1536;
+    int viasL2 = 12;
+    // tamaño de pagina fuera de las regiones
+    TamanoPagina paginaPorDefecto = TamanoPagina::PAGINA_4K;
+    // regiones con otro tamaño de pagina (la primera que contiene la direccion manda)
+    std::vector<RegionPaginas> regiones;
+};
+
+// contadores de traduccion
+struct EstadisticasTlb {
+    uint64_t accesos = 0;
+    uint64_t aciertosL1 = 0;
+    uint64_t aciertosL2 = 0;
+    // recorridos de la tabla de paginas (fallos en las dos TLB)
+    uint64_t recorridos = 0;
+    // lecturas de entradas de la tabla hechas por los recorridos
+    uint64_t referenciasRecorrido = 0;
+    // de esas lecturas, las que acertaron en la cache de datos
+    uint64_t aciertosRecorrido = 0;
+    // paginas de cada tamaño tocadas alguna vez
+    uint64_t paginas[3] = {0, 0, 0};
+
+    // fallos de L1 por acceso
+    double tasaFallosL1() const {
+        return accesos > 0 ? static_cast<double>(accesos - aciertosL1) / accesos : 0.0;
+    }
+    // fallos de L2 por consulta a L2
+    double tasaFallosL2() const {
+        return accesos > aciertosL1 ? static_cast<double>(recorridos) / (accesos - aciertosL1) : 0.0;
+    }
+};
+
+// TLB de dos niveles delante de la cache de datos y recorrido de la tabla de paginas
+// la tabla es la radix de 4 niveles de x86-64 (direcciones virtuales de 48 bits): una
+// pagina de 4K necesita 4 lecturas, una de 2M 3 y una de 1G 2. Las tablas y los marcos
+// se reservan al primer uso con direcciones fisicas consecutivas, y cada lectura del
+// recorrido pasa por la misma Cache que los datos
+class Tlb {
+private:
+    // arreglos de la TLB: caches de bloque de un byte indexadas por numero de pagina
+    Cache l1Pequenas;
+    Cache l1Grandes;
+    Cache l1Gigantes;
+    Cache l2;
+    ConfiguracionTlb configuracion;
+
+    // nodos de la tabla: (nivel, prefijo virtual) -> direccion fisica del nodo
+    std::unordered_map<uint64_t, uint64_t> nodos;
+    // paginas mapeadas: (tamaño, numero de pagina) -> direccion fisica del marco
+    std::unordered_map<uint64_t, uint64_t> marcos;
+    // siguiente direccion fisica libre
+    uint64_t siguienteFisica;
+    EstadisticasTlb estadisticas;
+
+    // reserva memoria fisica alineada a su tamaño
+    uint64_t reservarFisica(uint64_t bytes);
+    // arreglo L1 de un tamaño de pagina
+    Cache& l1De(TamanoPagina tamano);
+    // recorre la tabla por la cache de datos y devuelve el marco de la pagina
+    uint64_t recorrer(uint64_t direccionVirtual, TamanoPagina tamano, Cache& cache);
+
+public:
+    // valida la geometria de los arreglos (la Cache lanza std::invalid_argument)
+    // y que las regiones esten alineadas a su tamaño de pagina
+    explicit Tlb(const ConfiguracionTlb& configuracion = ConfiguracionTlb());
+
+    // tamaño de pagina de una direccion virtual
+    TamanoPagina tamanoPagina(uint64_t direccionVirtual) const;
+    // traduce una direccion virtual; los fallos de TLB recorren la tabla por cache
+    uint64_t traducir(uint64_t direccionVirtual, Cache& cache);
+    // traduce y accede a la cache de datos con la direccion fisica
+    bool acceder(uint64_t direccionVirtual, Cache& cache, TipoAcceso tipo = TipoAcceso::LECTURA) {
+        return cache.acceder(traducir(direccionVirtual, cache), tipo);
+    }
+
+    // muestra tasas de fallo de cada TLB y trafico de los recorridos
+    void imprimirEstadisticas(int tamanoBloqueCache) const;
+
+    // metodos de consulta
+    const EstadisticasTlb& getEstadisticas() const { return estadisticas; }
+    const ConfiguracionTlb& getConfiguracion() const { return configuracion; }
+    // bytes leidos por los recorridos (entradas de 8 bytes)
+    uint64_t getBytesRecorrido() const { return estadisticas.referenciasRecorrido * 8; }
+};
+
+// bytes de un tamaño de pagina
+uint64_t bytesPagina(TamanoPagina tamano);
+// devuelve el nombre legible de un tamaño de pagina
+const char* nombreTamanoPagina(TamanoPagina tamano);
+
+// fin de la directiva de preprocesador ifndef
+#endif // TLB_HPP
@@ -0,0 +1,43 @@
+#ifndef ASIGNADORALINEADO_HPP
+#define ASIGNADORALINEADO_HPP
+
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para operator new con alineacion
+#include <new>
+
+// tamaño de linea de cache del procesador anfitrion en bytes
+constexpr std::size_t TAMANO_LINEA_ANFITRION = 64;
+
+// asignador para std::vector que alinea el bloque reservado a una linea de cache
+// evita que un conjunto quede partido entre dos lineas del anfitrion
+template <typename T, std::size_t Alineacion = TAMANO_LINEA_ANFITRION>
+struct AsignadorAlineado {
+    using value_type = T;
+
+    // permite reasignar el asignador a otro tipo conservando la alineacion
+    template <typename U>
+    struct rebind { using other = AsignadorAlineado<U, Alineacion>; };
+
+    AsignadorAlineado() noexcept = default;
+    template <typename U>
+    AsignadorAlineado(const AsignadorAlineado<U, Alineacion>&) noexcept {}
+
+    // reserva memoria alineada para n elementos
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alineacion)));
+    }
+
+    // libera memoria reservada con allocate
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alineacion));
+    }
+};
+
+// dos asignadores con la misma alineacion son intercambiables
+template <typename T, typename U, std::size_t A>
+bool operator==(const AsignadorAlineado<T, A>&, const AsignadorAlineado<U, A>&) { return true; }
+template <typename T, typename U, std::size_t A>
+bool operator!=(const AsignadorAlineado<T, A>&, const AsignadorAlineado<U, A>&) { return false; }
+
+#endif // ASIGNADORALINEADO_HPP
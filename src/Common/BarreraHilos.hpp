@@ -0,0 +1,69 @@
+#ifndef BARRERAHILOS_HPP
+#define BARRERAHILOS_HPP
+
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para el contador y la ronda sin cerrojo
+#include <atomic>
+// inclusion para std::this_thread::yield
+#include <thread>
+// inclusion para exclusion mutua
+#include <mutex>
+// inclusion para esperar a los demas hilos
+#include <condition_variable>
+
+// punto de encuentro reutilizable para un numero fijo de hilos (C++17 no tiene std::barrier)
+// la llegada es un decremento atomico; quien espera primero da vueltas leyendo la ronda, que
+// basta cuando las fases son cortas, y si la espera se alarga se duerme en la variable de
+// condicion para no quitarle el procesador a los hilos que aun trabajan
+class BarreraHilos {
+private:
+    // vueltas leyendo la ronda y cesiones del procesador antes de dormirse
+    static constexpr int VUELTAS_ACTIVAS = 2048;
+    static constexpr int CESIONES = 64;
+
+    // hilos que deben llegar para abrir la barrera
+    const std::size_t participantes;
+    // hilos que faltan en la ronda actual
+    std::atomic<std::size_t> pendientes;
+    // ronda actual; distingue una apertura de la siguiente
+    std::atomic<std::size_t> ronda;
+    // hilos dormidos en la variable de condicion (el ultimo en llegar solo avisa si hay alguno)
+    std::atomic<std::size_t> dormidos;
+    std::mutex cerrojo;
+    std::condition_variable aviso;
+
+public:
+    explicit BarreraHilos(std::size_t participantes) :
+        participantes(participantes), pendientes(participantes), ronda(0), dormidos(0) {}
+
+    // bloquea hasta que todos los participantes hayan llegado
+    void esperar() {
+        const std::size_t rondaActual = ronda.load(std::memory_order_acquire);
+        if (pendientes.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // el ultimo en llegar prepara la siguiente ronda y abre la barrera; nadie vuelve a
+            // decrementar pendientes hasta ver la ronda nueva
+            pendientes.store(participantes, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> bloqueo(cerrojo);
+                ronda.store(rondaActual + 1, std::memory_order_release);
+            }
+            if (dormidos.load(std::memory_order_acquire) > 0) aviso.notify_all();
+            return;
+        }
+        for (int vuelta = 0; vuelta < VUELTAS_ACTIVAS; ++vuelta) {
+            if (ronda.load(std::memory_order_acquire) != rondaActual) return;
+        }
+        for (int cesion = 0; cesion < CESIONES; ++cesion) {
+            if (ronda.load(std::memory_order_acquire) != rondaActual) return;
+            std::this_thread::yield();
+        }
+        // la ronda se cambia con el cerrojo tomado: o se ve aqui o el aviso llega despues de esperar
+        std::unique_lock<std::mutex> bloqueo(cerrojo);
+        dormidos.fetch_add(1, std::memory_order_acq_rel);
+        aviso.wait(bloqueo, [&] { return ronda.load(std::memory_order_acquire) != rondaActual; });
+        dormidos.fetch_sub(1, std::memory_order_acq_rel);
+    }
+};
+
+#endif // BARRERAHILOS_HPP
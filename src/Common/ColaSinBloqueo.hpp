@@ -0,0 +1,79 @@
+// directiva para evitar inclusiones multiples
+#ifndef COLASINBLOQUEO_HPP
+#define COLASINBLOQUEO_HPP
+
+// inclusion para los indices atomicos
+#include <atomic>
+// inclusion para size_t
+#include <cstddef>
+// inclusion para el anillo de huecos
+#include <memory>
+// inclusion para std::move
+#include <utility>
+// inclusion para excepciones estandar
+#include <stdexcept>
+
+// cola acotada sin cerrojos para un productor y un consumidor: un anillo con un indice de
+// lectura y otro de escritura que solo escribe su dueño; el otro hilo lo lee con acquire,
+// asi el consumidor ve el elemento completo cuando ve avanzar la escritura y viceversa
+template <typename T>
+class ColaSinBloqueo {
+private:
+    // tamaño de una linea de cache; cada indice en su linea para no compartirla entre hilos
+    static constexpr std::size_t LINEA = 64;
+
+    // capacidad potencia de dos: la posicion en el anillo es indice & mascara
+    const std::size_t capacidad;
+    const std::size_t mascara;
+    std::unique_ptr<T[]> huecos;
+    // siguiente elemento a sacar (solo lo escribe el consumidor)
+    alignas(LINEA) std::atomic<std::size_t> lectura;
+    // siguiente hueco a llenar (solo lo escribe el productor)
+    alignas(LINEA) std::atomic<std::size_t> escritura;
+
+    // redondea a la siguiente potencia de dos
+    static std::size_t potenciaDeDos(std::size_t valor) {
+        std::size_t potencia = 1;
+        while (potencia < valor) potencia <<= 1;
+        return potencia;
+    }
+
+public:
+    // capacidadMinima > 0; se redondea a potencia de dos
+    explicit ColaSinBloqueo(std::size_t capacidadMinima) :
+        capacidad(potenciaDeDos(capacidadMinima)), mascara(capacidad - 1),
+        huecos(new T[capacidad]), lectura(0), escritura(0) {
+        if (capacidadMinima == 0) {
+            throw std::invalid_argument("La cola necesita al menos un hueco");
+        }
+    }
+    ColaSinBloqueo(const ColaSinBloqueo&) = delete;
+    ColaSinBloqueo& operator=(const ColaSinBloqueo&) = delete;
+
+    // solo el productor: mete el valor si hay hueco (si no, lo deja intacto y devuelve false)
+    bool intentarMeter(T&& valor) {
+        const std::size_t posicion = escritura.load(std::memory_order_relaxed);
+        if (posicion - lectura.load(std::memory_order_acquire) == capacidad) return false;
+        huecos[posicion & mascara] = std::move(valor);
+        escritura.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    // solo el consumidor: saca el elemento mas antiguo si lo hay
+    bool intentarSacar(T& valor) {
+        const std::size_t posicion = lectura.load(std::memory_order_relaxed);
+        if (escritura.load(std::memory_order_acquire) == posicion) return false;
+        valor = std::move(huecos[posicion & mascara]);
+        lectura.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    // metodos de consulta (el tamaño es aproximado si el otro hilo esta trabajando)
+    bool estaVacia() const {
+        return escritura.load(std::memory_order_acquire) == lectura.load(std::memory_order_acquire);
+    }
+    std::size_t getCapacidad() const { return capacidad; }
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // COLASINBLOQUEO_HPP
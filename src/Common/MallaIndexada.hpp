@@ -0,0 +1,35 @@
+#ifndef MALLAINDEXADA_HPP
+#define MALLAINDEXADA_HPP
+
+// inclusion para los vectores de la malla
+#include <vector>
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+// inclusion de la definicion de Vertice
+#include "Common/Vertice.hpp"
+
+// coordenada de textura de un OBJ (vt u v)
+struct CoordenadaTextura {
+    float u, v;
+};
+
+// malla indexada leida de un OBJ
+// cada triangulo son tres esquinas seguidas en indices (base 0); las caras de mas de tres
+// lados se abren en abanico desde su primer vertice
+struct MallaIndexada {
+    // indice de una esquina que no tiene textura o normal
+    static constexpr uint32_t SIN_INDICE = UINT32_MAX;
+
+    std::vector<Vertice> vertices;
+    std::vector<Vertice> normales;
+    std::vector<CoordenadaTextura> texturas;
+    // indice de vertice de cada esquina
+    std::vector<uint32_t> indices;
+    // indice de textura y de normal de cada esquina (vacios si ninguna cara los usa)
+    std::vector<uint32_t> indicesTextura;
+    std::vector<uint32_t> indicesNormales;
+
+    std::size_t numTriangulos() const { return indices.size() / 3; }
+};
+
+#endif // MALLAINDEXADA_HPP
@@ -0,0 +1,14 @@
+#ifndef TIPOACCESO_HPP
+#define TIPOACCESO_HPP
+
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+
+// clase de acceso a memoria registrada en una traza
+enum class TipoAcceso : uint8_t {
+    LECTURA = 0,     // carga de datos
+    ESCRITURA = 1,   // almacenamiento de datos
+    INSTRUCCION = 2  // busqueda de instruccion
+};
+
+#endif // TIPOACCESO_HPP
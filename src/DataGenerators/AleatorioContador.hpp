@@ -0,0 +1,71 @@
+// directiva para evitar inclusiones multiples
+#ifndef ALEATORIOCONTADOR_HPP
+#define ALEATORIOCONTADOR_HPP
+
+// inclusion para tipos de enteros de tamaño fijo
+#include <cstdint>
+
+// mezcla de 64 bits (finalizador de splitmix64): biyectiva y con buena avalancha
+inline uint64_t mezclar64(uint64_t valor) {
+    valor = (valor ^ (valor >> 30)) * 0xBF58476D1CE4E5B9ull;
+    valor = (valor ^ (valor >> 27)) * 0x94D049BB133111EBull;
+    return valor ^ (valor >> 31);
+}
+
+// generador aleatorio basado en contador (estilo SplitMix): el numero i de la secuencia
+// se calcula directamente a partir de la semilla y de i, sin estado, asi que cualquier
+// tramo de una secuencia se puede generar por separado (y en paralelo) con el mismo resultado
+class AleatorioContador {
+    uint64_t clave;
+
+public:
+    // flujo separa secuencias independientes con la misma semilla
+    explicit AleatorioContador(uint64_t semilla, uint64_t flujo = 0) :
+        clave(mezclar64(semilla ^ mezclar64(flujo + 0x9E3779B97F4A7C15ull))) {}
+
+    // numero de 64 bits en la posicion contador
+    uint64_t operator()(uint64_t contador) const {
+        return mezclar64(clave + (contador + 1) * 0x9E3779B97F4A7C15ull);
+    }
+    // numero en [0, limite) por producto y desplazamiento (limite 0 = los 64 bits completos)
+    uint64_t enRango(uint64_t contador, uint64_t limite) const {
+        const uint64_t valor = (*this)(contador);
+        if (limite == 0) return valor;
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(valor) * limite) >> 64);
+    }
+};
+
+// permutacion pseudoaleatoria de [0, n) sin tabla: una biyeccion de [0, 2^bits) (suma,
+// productos impares y xorshift modulo 2^bits) aplicada de nuevo mientras el resultado
+// caiga fuera de [0, n); como el generador, cada posicion se calcula por separado
+class PermutacionAleatoria {
+    uint64_t n;
+    uint32_t desplazamiento;
+    uint64_t mascara;
+    uint64_t sumando;
+
+public:
+    // n > 0
+    PermutacionAleatoria(uint64_t n, uint64_t semilla) : n(n), sumando(mezclar64(semilla + 0x632BE59BD9B4E019ull)) {
+        uint32_t bits = 1;
+        while (bits < 64 && (uint64_t(1) << bits) < n) ++bits;
+        desplazamiento = bits / 2 + 1;
+        mascara = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    }
+
+    // elemento en la posicion dada (posicion < n)
+    uint64_t operator()(uint64_t posicion) const {
+        uint64_t valor = posicion;
+        do {
+            valor = ((valor + sumando) * 0x9E3779B97F4A7C15ull) & mascara;
+            valor ^= valor >> desplazamiento;
+            valor = (valor * 0xBF58476D1CE4E5B9ull) & mascara;
+            valor ^= valor >> desplazamiento;
+        } while (valor >= n);
+        return valor;
+    }
+    uint64_t getTamano() const { return n; }
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // ALEATORIOCONTADOR_HPP
@@ -0,0 +1,227 @@
+// incluye la definicion de las cargas de trabajo
+#include "CargasTrabajo.hpp"
+// para manejo de excepciones
+#include <stdexcept>
+
+// genera el siguiente tramo
+bool CargaTrabajo::siguienteTramo() {
+    cantidadTramo = 0;
+    if (terminada) return false;
+    terminada = generar();
+    generados += cantidadTramo;
+    return cantidadTramo > 0;
+}
+
+// vuelve al primer acceso
+void CargaTrabajo::reiniciar() {
+    cantidadTramo = 0;
+    generados = 0;
+    terminada = false;
+    reiniciarKernel();
+}
+
+// reinicia la carga y se coloca en el primer tramo
+CargaTrabajo::Iterador CargaTrabajo::begin() {
+    reiniciar();
+    return siguienteTramo() ? Iterador(this, 0) : end();
+}
+
+// producto de matrices
+MultiplicacionMatrices::MultiplicacionMatrices(uint32_t n, uint32_t tesela, uint32_t elemento, uint64_t base) :
+    n(n), tesela(tesela == 0 || tesela > n ? n : tesela), elemento(elemento) {
+
+    if (n == 0 || elemento == 0) {
+        throw std::invalid_argument("El orden de la matriz y el tamaño de elemento deben ser mayores que cero");
+    }
+    const uint64_t bytesMatriz = static_cast<uint64_t>(n) * n * elemento;
+    baseA = base;
+    baseB = base + bytesMatriz;
+    baseC = base + 2 * bytesMatriz;
+    // dos lecturas por paso interno, y por cada tesela de k una escritura de C
+    // (mas una lectura de C si hay mas de una tesela de k)
+    const uint64_t teselasK = (n + this->tesela - 1) / this->tesela;
+    total = 2 * static_cast<uint64_t>(n) * n * n + static_cast<uint64_t>(n) * n * teselasK * (teselasK > 1 ? 2 : 1);
+    reiniciarKernel();
+}
+
+void MultiplicacionMatrices::reiniciarKernel() {
+    ii = jj = kk = i = j = k = 0;
+}
+
+// i, j y k son relativos a la tesela (ii, jj, kk), asi el incremento de cada bucle
+// puede reiniciar el indice interior a cero y el bucle se retoma donde se quedo
+bool MultiplicacionMatrices::generar() {
+    const uint64_t filaBytes = static_cast<uint64_t>(n) * elemento;
+    // con una sola tesela de k, C se escribe sin leerla antes
+    const bool acumular = tesela < n;
+    for (; ii < n; ii += tesela, jj = 0) {
+        for (; jj < n; jj += tesela, kk = 0) {
+            for (; kk < n; kk += tesela, i = 0) {
+                for (; i < tesela && ii + i < n; ++i, j = 0) {
+                    for (; j < tesela && jj + j < n; ++j, k = 0) {
+                        const uint64_t fila = ii + i;
+                        const uint64_t columna = jj + j;
+                        for (; k < tesela && kk + k < n; ++k) {
+                            if (libres() < 3) return false;
+                            if (k == 0 && acumular) emitir(baseC + fila * filaBytes + columna * elemento, TipoAcceso::LECTURA);
+                            emitir(baseA + fila * filaBytes + static_cast<uint64_t>(kk + k) * elemento, TipoAcceso::LECTURA);
+                            emitir(baseB + static_cast<uint64_t>(kk + k) * filaBytes + columna * elemento, TipoAcceso::LECTURA);
+                        }
+                        if (libres() == 0) return false;
+                        emitir(baseC + fila * filaBytes + columna * elemento, TipoAcceso::ESCRITURA);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// estencil de Jacobi
+Estencil::Estencil(uint32_t nx, uint32_t ny, uint32_t nz, uint32_t iteraciones, uint32_t elemento, uint64_t base) :
+    nx(nx), ny(ny), nz(nz), elemento(elemento), iteraciones(iteraciones) {
+
+    if (nx < 3 || ny < 3 || nz == 0 || nz == 2 || elemento == 0) {
+        throw std::invalid_argument("La malla del estencil necesita al menos 3 puntos por dimension (nz = 1 en 2D)");
+    }
+    baseEntrada = base;
+    baseSalida = base + static_cast<uint64_t>(nx) * ny * nz * elemento;
+    // puntos interiores por el numero de accesos de cada uno (vecinos, centro y escritura)
+    const uint64_t interiores = static_cast<uint64_t>(nx - 2) * (ny - 2) * (nz > 1 ? nz - 2 : 1);
+    total = static_cast<uint64_t>(iteraciones) * interiores * (nz > 1 ? 8 : 6);
+    reiniciarKernel();
+}
+
+void Estencil::reiniciarKernel() {
+    iteracion = 0;
+    z = nz > 1 ? 1 : 0;
+    y = 1;
+    x = 1;
+}
+
+bool Estencil::generar() {
+    const uint32_t primerZ = nz > 1 ? 1 : 0;
+    const uint32_t finZ = nz > 1 ? nz - 1 : 1;
+    const uint64_t fila = static_cast<uint64_t>(nx) * elemento;
+    const uint64_t plano = fila * ny;
+    for (; iteracion < iteraciones; ++iteracion, z = primerZ) {
+        // las mallas se intercambian en cada iteracion
+        const uint64_t entrada = iteracion % 2 == 0 ? baseEntrada : baseSalida;
+        const uint64_t salida = iteracion % 2 == 0 ? baseSalida : baseEntrada;
+        for (; z < finZ; ++z, y = 1) {
+            for (; y < ny - 1; ++y, x = 1) {
+                for (; x < nx - 1; ++x) {
+                    if (libres() < 8) return false;
+                    const uint64_t centro = z * plano + y * fila + static_cast<uint64_t>(x) * elemento;
+                    emitir(entrada + centro, TipoAcceso::LECTURA);
+                    emitir(entrada + centro - elemento, TipoAcceso::LECTURA);
+                    emitir(entrada + centro + elemento, TipoAcceso::LECTURA);
+                    emitir(entrada + centro - fila, TipoAcceso::LECTURA);
+                    emitir(entrada + centro + fila, TipoAcceso::LECTURA);
+                    if (nz > 1) {
+                        emitir(entrada + centro - plano, TipoAcceso::LECTURA);
+                        emitir(entrada + centro + plano, TipoAcceso::LECTURA);
+                    }
+                    emitir(salida + centro, TipoAcceso::ESCRITURA);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// persecucion de punteros
+PersecucionPunteros::PersecucionPunteros(uint64_t nodos, uint64_t pasos, uint32_t tamanoNodo,
+                                         uint64_t semilla, uint64_t base) :
+    nodos(nodos), tamanoNodo(tamanoNodo), base(base), pasos(pasos),
+    permutacion(nodos == 0 ? 1 : nodos, semilla) {
+
+    if (nodos == 0 || tamanoNodo == 0) {
+        throw std::invalid_argument("La persecucion de punteros necesita nodos de tamaño mayor que cero");
+    }
+    total = pasos;
+    reiniciarKernel();
+}
+
+void PersecucionPunteros::reiniciarKernel() {
+    paso = 0;
+    posicion = 0;
+}
+
+bool PersecucionPunteros::generar() {
+    while (paso < pasos) {
+        if (libres() == 0) return false;
+        emitir(base + permutacion(posicion) * tamanoNodo, TipoAcceso::LECTURA);
+        ++paso;
+        if (++posicion == nodos) posicion = 0;
+    }
+    return true;
+}
+
+// sondeo de una tabla hash
+SondeoHash::SondeoHash(uint64_t entradas, uint64_t busquedas, double carga, uint32_t tamanoEntrada,
+                       uint64_t semilla, uint64_t base) :
+    entradas(entradas), tamanoEntrada(tamanoEntrada), base(base), busquedas(busquedas),
+    claves(semilla), ocupacion(semilla, 1) {
+
+    if (entradas == 0 || tamanoEntrada == 0) {
+        throw std::invalid_argument("La tabla hash necesita entradas de tamaño mayor que cero");
+    }
+    if (!(carga >= 0.0 && carga < 1.0)) {
+        throw std::invalid_argument("La carga de la tabla hash debe estar en [0, 1)");
+    }
+    umbralOcupada = static_cast<uint64_t>(carga * 4294967296.0);
+    // el numero de sondeos depende de la semilla
+    total = 0;
+    reiniciarKernel();
+}
+
+void SondeoHash::reiniciarKernel() {
+    busqueda = 0;
+}
+
+bool SondeoHash::generar() {
+    while (busqueda < busquedas) {
+        if (libres() < MAX_SONDEOS) return false;
+        // la clave de cada busqueda sale de un contador, asi la secuencia se repite tras reiniciar
+        uint64_t entrada = claves.enRango(busqueda, entradas);
+        // se sigue sondeando mientras la entrada leida este ocupada por otra clave
+        for (uint32_t sondeo = 0; sondeo < MAX_SONDEOS; ++sondeo) {
+            emitir(base + entrada * tamanoEntrada, TipoAcceso::LECTURA);
+            if ((ocupacion(busqueda * MAX_SONDEOS + sondeo) >> 32) >= umbralOcupada) break;
+            if (++entrada == entradas) entrada = 0;
+        }
+        ++busqueda;
+    }
+    return true;
+}
+
+// copia en flujo
+CopiaFlujo::CopiaFlujo(uint64_t bytes, uint32_t repeticiones, uint32_t elemento, uint64_t base) :
+    elemento(elemento), repeticiones(repeticiones) {
+
+    if (elemento == 0) {
+        throw std::invalid_argument("El tamaño de elemento debe ser mayor que cero");
+    }
+    elementos = bytes / elemento;
+    baseOrigen = base;
+    baseDestino = base + elementos * elemento;
+    total = 2 * elementos * repeticiones;
+    reiniciarKernel();
+}
+
+void CopiaFlujo::reiniciarKernel() {
+    repeticion = 0;
+    indice = 0;
+}
+
+bool CopiaFlujo::generar() {
+    for (; repeticion < repeticiones; ++repeticion, indice = 0) {
+        for (; indice < elementos; ++indice) {
+            if (libres() < 2) return false;
+            emitir(baseOrigen + indice * elemento, TipoAcceso::LECTURA);
+            emitir(baseDestino + indice * elemento, TipoAcceso::ESCRITURA);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,204 @@
+// directiva para evitar inclusiones multiples
+#ifndef CARGASTRABAJO_HPP
+#define CARGASTRABAJO_HPP
+
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion del tipo de acceso (lectura o escritura)
+#include "Common/TipoAcceso.hpp"
+// inclusion del generador aleatorio basado en contador y de la permutacion sin tabla
+#include "DataGenerators/AleatorioContador.hpp"
+
+// carga de trabajo generada de forma perezosa: los accesos se producen por tramos
+// de TAMANO_TRAMO en un buffer interno que cabe en la L1 del anfitrion, sin guardar
+// la traza completa, asi que la memoria usada no depende del numero de accesos
+// uso por tramos:  while (carga.siguienteTramo()) cache.accederLote(carga.direcciones(), carga.tipos(), carga.cantidad());
+// uso como rango:  for (uint64_t direccion : carga) cache.acceder(direccion);
+class CargaTrabajo {
+public:
+    // accesos por tramo (16 KiB de direcciones y 2 KiB de tipos)
+    static constexpr std::size_t TAMANO_TRAMO = 2048;
+
+    virtual ~CargaTrabajo() = default;
+
+    // genera el siguiente tramo; devuelve false si la carga ya termino
+    bool siguienteTramo();
+    // vuelve al primer acceso (misma secuencia)
+    void reiniciar();
+
+    // tramo actual
+    const uint64_t* direcciones() const { return direccionesTramo; }
+    const TipoAcceso* tipos() const { return tiposTramo; }
+    std::size_t cantidad() const { return cantidadTramo; }
+
+    // metodos de consulta
+    // accesos de la carga completa (0 si depende de la semilla y no se sabe de antemano)
+    uint64_t getTotal() const { return total; }
+    // accesos generados desde el ultimo reinicio
+    uint64_t getGenerados() const { return generados; }
+
+    // iterador de entrada sobre las direcciones (recorre la carga una sola vez)
+    class Iterador {
+        CargaTrabajo* carga;
+        std::size_t posicion;
+
+    public:
+        Iterador(CargaTrabajo* carga, std::size_t posicion) : carga(carga), posicion(posicion) {}
+        uint64_t operator*() const { return carga->direccionesTramo[posicion]; }
+        TipoAcceso tipo() const { return carga->tiposTramo[posicion]; }
+        // avanza y pide un tramo nuevo al agotar el actual (nullptr marca el final)
+        Iterador& operator++() {
+            if (++posicion == carga->cantidadTramo) {
+                posicion = 0;
+                if (!carga->siguienteTramo()) carga = nullptr;
+            }
+            return *this;
+        }
+        bool operator!=(const Iterador& otro) const { return carga != otro.carga || posicion != otro.posicion; }
+        bool operator==(const Iterador& otro) const { return !(*this != otro); }
+    };
+    // empieza desde el principio de la carga
+    Iterador begin();
+    Iterador end() { return Iterador(nullptr, 0); }
+
+protected:
+    CargaTrabajo() : total(0), generados(0), cantidadTramo(0), terminada(false) {}
+
+    // el kernel continua donde lo dejo y llena el tramo con emitir(); devuelve true
+    // cuando ya no le quedan accesos (lo que haya emitido antes tambien se devuelve)
+    virtual bool generar() = 0;
+    // vuelve el estado del kernel al primer acceso
+    virtual void reiniciarKernel() = 0;
+
+    // huecos libres en el tramo (un kernel solo emite una iteracion si le cabe entera)
+    std::size_t libres() const { return TAMANO_TRAMO - cantidadTramo; }
+    void emitir(uint64_t direccion, TipoAcceso tipo) {
+        direccionesTramo[cantidadTramo] = direccion;
+        tiposTramo[cantidadTramo] = tipo;
+        ++cantidadTramo;
+    }
+
+    // lo fija cada kernel en su constructor
+    uint64_t total;
+
+private:
+    uint64_t generados;
+    std::size_t cantidadTramo;
+    bool terminada;
+    uint64_t direccionesTramo[TAMANO_TRAMO];
+    TipoAcceso tiposTramo[TAMANO_TRAMO];
+};
+
+// producto de matrices C = A * B de n x n elementos (orden i-j-k)
+// con tesela > 0 se recorre por teselas de tesela x tesela (ii, jj, kk y dentro i, j, k);
+// cada paso interno lee A[i][k] y B[k][j], y al cerrar k se escribe C[i][j]
+class MultiplicacionMatrices : public CargaTrabajo {
+    uint32_t n;
+    uint32_t tesela;
+    uint32_t elemento;
+    // direcciones base de las tres matrices (una detras de otra a partir de base)
+    uint64_t baseA;
+    uint64_t baseB;
+    uint64_t baseC;
+    // indices del bucle en curso
+    uint32_t ii, jj, kk, i, j, k;
+
+    bool generar() override;
+    void reiniciarKernel() override;
+
+public:
+    // tesela 0 = algoritmo ingenuo; lanza std::invalid_argument si n o elemento son cero
+    MultiplicacionMatrices(uint32_t n, uint32_t tesela = 0, uint32_t elemento = 8, uint64_t base = 0);
+};
+
+// estencil de Jacobi sobre una malla nx x ny x nz (nz = 1 es el estencil 2D de 5 puntos,
+// nz > 1 el 3D de 7 puntos); cada punto interior lee sus vecinos en la malla de entrada y
+// escribe la de salida, y en cada iteracion se intercambian las dos mallas
+class Estencil : public CargaTrabajo {
+    uint32_t nx, ny, nz;
+    uint32_t elemento;
+    uint32_t iteraciones;
+    uint64_t baseEntrada;
+    uint64_t baseSalida;
+    // indices del bucle en curso
+    uint32_t iteracion, z, y, x;
+
+    bool generar() override;
+    void reiniciarKernel() override;
+
+public:
+    // lanza std::invalid_argument si la malla no tiene puntos interiores
+    Estencil(uint32_t nx, uint32_t ny, uint32_t nz = 1, uint32_t iteraciones = 1,
+             uint32_t elemento = 8, uint64_t base = 0);
+};
+
+// persecucion de punteros: recorre nodos de tamanoNodo bytes en un orden aleatorio que
+// visita todos antes de repetir (una permutacion biyectiva calculada sin tabla)
+class PersecucionPunteros : public CargaTrabajo {
+    uint64_t nodos;
+    uint32_t tamanoNodo;
+    uint64_t base;
+    uint64_t pasos;
+    // orden de visita de los nodos
+    PermutacionAleatoria permutacion;
+    // paso en curso y posicion dentro de la vuelta actual
+    uint64_t paso;
+    uint64_t posicion;
+
+    bool generar() override;
+    void reiniciarKernel() override;
+
+public:
+    // lanza std::invalid_argument si no hay nodos o tamanoNodo es cero
+    PersecucionPunteros(uint64_t nodos, uint64_t pasos, uint32_t tamanoNodo = 64,
+                        uint64_t semilla = 1, uint64_t base = 0);
+};
+
+// busquedas en una tabla hash con direccionamiento abierto y sondeo lineal: cada busqueda
+// cae en una entrada aleatoria y lee entradas consecutivas; el numero de sondeos sigue una
+// geometrica con media 1 / (1 - carga), recortada a MAX_SONDEOS
+class SondeoHash : public CargaTrabajo {
+    uint64_t entradas;
+    uint32_t tamanoEntrada;
+    uint64_t base;
+    uint64_t busquedas;
+    // numeros aleatorios de las claves y de la ocupacion de cada entrada sondeada
+    AleatorioContador claves;
+    AleatorioContador ocupacion;
+    // probabilidad de que una entrada este ocupada, en 1/2^32
+    uint64_t umbralOcupada;
+    uint64_t busqueda;
+
+    bool generar() override;
+    void reiniciarKernel() override;
+
+public:
+    static constexpr uint32_t MAX_SONDEOS = 32;
+    // carga en [0, 1); lanza std::invalid_argument si no hay entradas o la carga no es valida
+    SondeoHash(uint64_t entradas, uint64_t busquedas, double carga = 0.5, uint32_t tamanoEntrada = 16,
+               uint64_t semilla = 1, uint64_t base = 0);
+};
+
+// copia en flujo (como la prueba copy de STREAM): lee origen[i] y escribe destino[i]
+class CopiaFlujo : public CargaTrabajo {
+    uint64_t elementos;
+    uint32_t elemento;
+    uint64_t baseOrigen;
+    uint64_t baseDestino;
+    uint32_t repeticiones;
+    // copia en curso y elemento dentro de ella
+    uint32_t repeticion;
+    uint64_t indice;
+
+    bool generar() override;
+    void reiniciarKernel() override;
+
+public:
+    // copia bytes bytes repeticiones veces; lanza std::invalid_argument si elemento es cero
+    CopiaFlujo(uint64_t bytes, uint32_t repeticiones = 1, uint32_t elemento = 8, uint64_t base = 0);
+};
+
+// fin de la directiva de preprocesador ifndef
+#endif // CARGASTRABAJO_HPP
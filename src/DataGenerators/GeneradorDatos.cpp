@@ -1,69 +1,140 @@
 // incluye el archivo de cabecera de la clase generadordatos
 #include "GeneradorDatos.hpp"
-// incluye libreria para generacion de numeros aleatorios
-#include <random>
-// incluye libreria con algoritmos como shuffle
+// incluye el generador aleatorio basado en contador y la permutacion sin tabla
+#include "AleatorioContador.hpp"
+// incluye libreria con algoritmos como max
 #include <algorithm>
 // incluye libreria matematica para operaciones avanzadas
 #include <cmath>
+// para repartir la generacion entre hilos
+#include <thread>
+
+// elementos minimos por hilo: lanzar un hilo cuesta mas que generar pocas direcciones
+static const std::size_t MINIMO_POR_HILO = std::size_t(1) << 16;
+
+// reparte [0, cantidad) en tramos contiguos, uno por hilo (el principal hace el primero);
+// cada hilo escribe solo su tramo, asi el resultado no depende del numero de hilos
+template <typename Funcion>
+static void repartir(std::size_t cantidad, unsigned hilos, Funcion funcion) {
+    // por defecto un hilo por nucleo del anfitrion
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    hilos = static_cast<unsigned>(std::min<std::size_t>(hilos, std::max<std::size_t>(1, cantidad / MINIMO_POR_HILO)));
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(hilos - 1);
+    for (unsigned hilo = 1; hilo < hilos; ++hilo) {
+        trabajadores.emplace_back(funcion, cantidad * hilo / hilos, cantidad * (hilo + 1) / hilos);
+    }
+    funcion(0, cantidad / hilos);
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+// implementacion del metodo para generar una secuencia lineal
+std::vector<uint64_t> GeneradorDatos::generarSecuenciaLineal(uint64_t inicio, uint64_t fin, uint64_t paso) {
+    std::vector<uint64_t> direcciones;
+    // un paso nulo nunca llegaria al final
+    if (paso == 0 || inicio >= fin) return direcciones;
+    direcciones.reserve(static_cast<std::size_t>((fin - inicio + paso - 1) / paso));
+    // la resta evita desbordar inicio + paso cerca del final del espacio
+    for (uint64_t direccion = inicio; ; direccion += paso) {
+        direcciones.push_back(direccion);
+        if (fin - direccion <= paso) break;
+    }
+    return direcciones;
+}
+
+// implementacion del metodo para generar una secuencia aleatoria uniforme
+std::vector<uint64_t> GeneradorDatos::generarSecuenciaAleatoria(std::size_t tamano, uint64_t rangoMin, uint64_t rangoMax,
+                                                                uint64_t semilla, unsigned hilos) {
+    std::vector<uint64_t> direcciones(tamano);
+    if (rangoMin > rangoMax) std::swap(rangoMin, rangoMax);
+    // numeros de 64 bits para cubrir rangos mayores de 4 GiB (amplitud 0 = el rango completo)
+    const uint64_t amplitud = rangoMax - rangoMin + 1;
+    const AleatorioContador aleatorio(semilla);
+    repartir(tamano, hilos, [&](std::size_t inicio, std::size_t fin) {
+        for (std::size_t i = inicio; i < fin; ++i) {
+            direcciones[i] = rangoMin + aleatorio.enRango(i, amplitud);
+        }
+    });
+    return direcciones;
+}
 
 // implementacion del metodo para generar secuencia optimizada para cache
-std::vector<int> GeneradorDatos::generarSecuenciaOptimizada(uint32_t tamanoCache, uint32_t tamanoBloque, uint32_t asociatividad) {
-    // vector que almacenara las direcciones generadas
-    std::vector<int> direcciones;
+// cada posicion de la secuencia se calcula por separado a partir de su indice, asi los
+// hilos pueden repartirse el vector: la mezcla es una permutacion sin tabla de la
+// secuencia ordenada por conjuntos, y todos los conjuntos siguen el mismo patron de accesos
+std::vector<uint64_t> GeneradorDatos::generarSecuenciaOptimizada(uint32_t tamanoCache, uint32_t tamanoBloque,
+                                                                 uint32_t asociatividad, uint64_t base,
+                                                                 uint64_t semilla, unsigned hilos) {
     // calcula el numero de conjuntos en la cache
     const uint32_t numConjuntos = tamanoCache / (tamanoBloque * asociatividad);
     // define cuantas repeticiones se haran por cada bloque
     const uint32_t repeticionesPorBloque = 20;
-    
-    // configura generador de numeros aleatorios de mejor calidad
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    // distribucion para offsets dentro de un bloque
-    std::uniform_int_distribution<> dist_offset(1, tamanoBloque-1);
-    
-    // 1. genera bloques base para cada conjunto
-    for (uint32_t conjunto = 0; conjunto < numConjuntos; ++conjunto) {
-        for (uint32_t via = 0; via < asociatividad; ++via) {
-            // calcula direccion base para este bloque
-            uint32_t direccionBase = (conjunto * asociatividad + via) * tamanoBloque;
-            
-            // 2. crea patrones de acceso con localidad espacial
-            for (uint32_t r = 0; r < repeticionesPorBloque; ++r) {
-                // accede a la direccion base
-                direcciones.push_back(direccionBase);
-                // accede a offset aleatorio dentro del mismo bloque
-                direcciones.push_back(direccionBase + dist_offset(gen));
-                
-                // accede a bloques adyacentes (si existen)
-                if (via > 0) direcciones.push_back(direccionBase - tamanoBloque);
-                if (via < asociatividad-1) direcciones.push_back(direccionBase + tamanoBloque);
-                
-                // repite acceso a la base cada 2 iteraciones
-                if (r % 2 == 0) direcciones.push_back(direccionBase);
-            }
+
+    // 1. patron de accesos de un conjunto: via, repeticion y clase de cada acceso
+    //    (0 la base del bloque, 1 un offset aleatorio dentro del bloque, 2 el bloque anterior, 3 el siguiente)
+    std::vector<uint32_t> patron;
+    for (uint32_t via = 0; via < asociatividad; ++via) {
+        // 2. crea patrones de acceso con localidad espacial
+        for (uint32_t r = 0; r < repeticionesPorBloque; ++r) {
+            const uint32_t acceso = via << 8 | r << 2;
+            // accede a la direccion base y a un offset dentro del mismo bloque
+            patron.push_back(acceso);
+            patron.push_back(acceso | 1);
+            // accede a bloques adyacentes (si existen)
+            if (via > 0) patron.push_back(acceso | 2);
+            if (via < asociatividad - 1) patron.push_back(acceso | 3);
+            // repite acceso a la base cada 2 iteraciones
+            if (r % 2 == 0) patron.push_back(acceso);
         }
     }
-    
-    // 3. mezcla los accesos pero mantiene cierta localidad
-    std::shuffle(direcciones.begin(), direcciones.end(), gen);
-    
-    // 4. añade un pequeño porcentaje de accesos aleatorios (1%)
-    std::uniform_int_distribution<> dist_global(0, tamanoCache * 4);
-    for (size_t i = 0; i < direcciones.size()/100; ++i) {
-        // genera direccion aleatoria alineada a bloque
-        int addr = dist_global(gen) & ~(tamanoBloque-1);
-        if (addr >= 0) {
-            direcciones.push_back(addr);
+    const uint64_t accesosBloques = static_cast<uint64_t>(numConjuntos) * patron.size();
+    // 4. se añade un pequeño porcentaje de accesos aleatorios (1%) al final
+    const uint64_t accesosGlobales = accesosBloques / 100;
+    std::vector<uint64_t> direcciones(accesosBloques + accesosGlobales);
+
+    // flujos independientes para los offsets y para los accesos globales
+    const AleatorioContador offsets(semilla, 0);
+    const AleatorioContador globales(semilla, 1);
+    // 3. mezcla los accesos: la posicion i recibe el acceso mezcla(i) de la secuencia ordenada
+    const PermutacionAleatoria mezcla(std::max<uint64_t>(accesosBloques, 1), semilla);
+    const uint64_t rangoGlobal = static_cast<uint64_t>(tamanoCache) * 4 + 1;
+    const uint64_t mascaraBloque = ~static_cast<uint64_t>(tamanoBloque - 1);
+
+    repartir(direcciones.size(), hilos, [&](std::size_t inicio, std::size_t fin) {
+        for (std::size_t i = inicio; i < fin; ++i) {
+            if (i >= accesosBloques) {
+                // direccion aleatoria alineada a bloque
+                direcciones[i] = base + (globales.enRango(i - accesosBloques, rangoGlobal) & mascaraBloque);
+                continue;
+            }
+            const uint64_t acceso = mezcla(i);
+            const uint64_t conjunto = acceso / patron.size();
+            const uint32_t clase = patron[acceso % patron.size()];
+            // calcula direccion base del bloque
+            const uint64_t bloque = conjunto * asociatividad + (clase >> 8);
+            uint64_t direccion = base + bloque * tamanoBloque;
+            switch (clase & 3) {
+                case 1: {
+                    // offset en [1, tamanoBloque - 1], uno por bloque y repeticion
+                    const uint64_t contador = bloque * repeticionesPorBloque + (clase >> 2 & 63);
+                    if (tamanoBloque > 1) direccion += 1 + offsets.enRango(contador, tamanoBloque - 1);
+                    break;
+                }
+                case 2: direccion -= tamanoBloque; break;
+                case 3: direccion += tamanoBloque; break;
+            }
+            direcciones[i] = direccion;
         }
-    }
-    
+    });
+
     // devuelve la secuencia generada
     return direcciones;
 }
 
 // implementacion de la version anterior (compatibilidad)
-std::vector<int> GeneradorDatos::generarSecuenciaCacheConsciente(int tamanoCache, int tamanoBloque, int asociatividad) {
+std::vector<uint64_t> GeneradorDatos::generarSecuenciaCacheConsciente(int tamanoCache, int tamanoBloque, int asociatividad) {
     // simplemente llama a la nueva version con casteo de tipos
     return generarSecuenciaOptimizada(static_cast<uint32_t>(tamanoCache), 
                                     static_cast<uint32_t>(tamanoBloque), 
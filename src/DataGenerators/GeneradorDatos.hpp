@@ -5,24 +5,38 @@
 
 // incluye la libreria para usar contenedores vector
 #include <vector>
+// incluye la definicion de size_t
+#include <cstddef>
 // incluye definiciones de tipos enteros de tamaño fijo
-#include <cstdint>  // para uint32_t
+#include <cstdint>  // para uint32_t y uint64_t
 
 // clase para generar diferentes tipos de secuencias de datos
+// todas las direcciones son de 64 bits, como las que recibe la cache
+// (estas secuencias se guardan enteras; para trazas largas ver CargasTrabajo.hpp)
+// las secuencias aleatorias dependen solo de la semilla: se generan con un generador basado
+// en contador repartiendo el vector entre hilos (hilos = 0 usa todos los nucleos del anfitrion)
+// y el resultado es el mismo con cualquier numero de hilos
 class GeneradorDatos {
 public:
-    // metodo estatico que genera una secuencia lineal de numeros
-    static std::vector<int> generarSecuenciaLineal(int inicio, int fin, int paso);
+    // semilla de las secuencias cuando no se indica otra
+    static constexpr uint64_t SEMILLA_POR_DEFECTO = 0x5EEDCAC4E;
+
+    // metodo estatico que genera una secuencia lineal de direcciones [inicio, fin)
+    static std::vector<uint64_t> generarSecuenciaLineal(uint64_t inicio, uint64_t fin, uint64_t paso);
     
-    // metodo estatico que genera una secuencia de numeros aleatorios
-    static std::vector<int> generarSecuenciaAleatoria(int tamano, int rangoMin, int rangoMax);
+    // metodo estatico que genera una secuencia de direcciones aleatorias en [rangoMin, rangoMax]
+    static std::vector<uint64_t> generarSecuenciaAleatoria(std::size_t tamano, uint64_t rangoMin, uint64_t rangoMax,
+                                                           uint64_t semilla = SEMILLA_POR_DEFECTO, unsigned hilos = 0);
     
     // version optimizada para generar secuencias con alta tasa de aciertos en cache
     // utiliza parametros especificos de la cache (tamaño, bloque, asociatividad)
-    static std::vector<int> generarSecuenciaOptimizada(uint32_t tamanoCache, uint32_t tamanoBloque, uint32_t asociatividad);
+    // base desplaza todas las direcciones (por ejemplo, por encima de 4 GiB)
+    static std::vector<uint64_t> generarSecuenciaOptimizada(uint32_t tamanoCache, uint32_t tamanoBloque,
+                                                            uint32_t asociatividad, uint64_t base = 0,
+                                                            uint64_t semilla = SEMILLA_POR_DEFECTO, unsigned hilos = 0);
     
     // version anterior del generador consciente de cache (marcada como obsoleta)
-    static std::vector<int> generarSecuenciaCacheConsciente(int tamanoCache, int tamanoBloque, int asociatividad);
+    static std::vector<uint64_t> generarSecuenciaCacheConsciente(int tamanoCache, int tamanoBloque, int asociatividad);
 };
 
 // fin de la directiva de preprocesador ifndef
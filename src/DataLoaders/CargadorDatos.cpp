@@ -2,16 +2,16 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <stdexcept>
 
-// carga un modelo 3d desde un archivo de texto
-std::vector<Vertice> CargadorDatos::cargarModeloDesdeArchivo(const std::string& rutaArchivo) {
+// lee los vertices "x y z" del archivo de texto, una linea por vertice
+static std::vector<Vertice> leerTexto(const std::string& rutaArchivo) {
     std::vector<Vertice> vertices;
     std::ifstream archivo(rutaArchivo);
     std::string linea;
 
     if (!archivo.is_open()) {
-        std::cerr << "error: no se pudo abrir el archivo " << rutaArchivo << std::endl;
-        return vertices;
+        throw std::runtime_error("No se pudo abrir el modelo " + rutaArchivo);
     }
 
     while (std::getline(archivo, linea)) {
@@ -23,4 +23,32 @@ std::vector<Vertice> CargadorDatos::cargarModeloDesdeArchivo(const std::string&
 
     archivo.close();
     return vertices;
+}
+
+// carga un modelo 3d desde un archivo de texto
+std::vector<Vertice> CargadorDatos::cargarModeloDesdeArchivo(const std::string& rutaArchivo) {
+    // la cache binaria evita analizar el texto
+    const std::string rutaBinaria = rutaMallaBinaria(rutaArchivo);
+    if (mallaBinariaVigente(rutaBinaria, rutaArchivo)) {
+        try {
+            return MallaProyectada(rutaBinaria).copiarVertices();
+        } catch (const std::runtime_error&) {
+            // cache no valida: se lee el modelo de texto
+        }
+    }
+    try {
+        return leerTexto(rutaArchivo);
+    } catch (const std::runtime_error&) {
+        std::cerr << "error: no se pudo abrir el archivo " << rutaArchivo << std::endl;
+        return std::vector<Vertice>();
+    }
+}
+
+// abre el modelo a traves de su cache binaria
+MallaProyectada CargadorDatos::abrirModelo(const std::string& rutaArchivo, bool guardarBinaria) {
+    return abrirConMallaBinaria(rutaArchivo, guardarBinaria, [&]() {
+        MallaIndexada malla;
+        malla.vertices = leerTexto(rutaArchivo);
+        return malla;
+    });
 }
\ No newline at end of file
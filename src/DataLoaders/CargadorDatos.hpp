@@ -4,11 +4,18 @@
 #include <vector>
 #include <string>
 #include "Common/Vertice.hpp"  // Incluir la definicion de Vertice
+#include "DataLoaders/MallaBinaria.hpp"
 
 class CargadorDatos {
 public:
     // carga un modelo 3d desde un archivo de texto
+    // si junto al modelo hay una malla binaria vigente (ruta + ".cmsh") la usa en su lugar
     static std::vector<Vertice> cargarModeloDesdeArchivo(const std::string& rutaArchivo);
+
+    // abre el modelo a traves de su cache binaria (solo vertices): si la cache es vigente se
+    // proyecta en memoria sin analizar ni copiar; si no, se lee el texto y se guarda la cache
+    // (si guardarBinaria y se puede escribir); lanza std::runtime_error si no se puede leer
+    static MallaProyectada abrirModelo(const std::string& rutaArchivo, bool guardarBinaria = true);
 };
 
 #endif // CARGADORDATOS_HPP
\ No newline at end of file
@@ -0,0 +1,218 @@
+// incluye la definicion del importador
+#include "ImportadorTrazas.hpp"
+// para conversion de numeros sin iostreams ni locale
+#include <charconv>
+// para memchr, memcpy y memmove
+#include <cstring>
+// para errno
+#include <cerrno>
+// para manejo de excepciones
+#include <stdexcept>
+// lectura de archivos (posix)
+#include <fcntl.h>
+#include <unistd.h>
+
+// salta espacios y tabuladores
+static const char* saltarEspacios(const char* p, const char* fin) {
+    while (p < fin && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+// lee un numero hexadecimal (con o sin prefijo 0x); devuelve nullptr si no hay ninguno
+static const char* leerHexadecimal(const char* p, const char* fin, uint64_t& valor) {
+    if (fin - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) p += 2;
+    const std::from_chars_result resultado = std::from_chars(p, fin, valor, 16);
+    return resultado.ec == std::errc() ? resultado.ptr : nullptr;
+}
+
+// abre la traza y reserva el buffer
+ImportadorTraza::ImportadorTraza(const std::string& rutaArchivo, FormatoTrazaExterna formato,
+                                 bool incluirInstrucciones) :
+    descriptor(-1), propio(false), formato(formato), incluirInstrucciones(incluirInstrucciones),
+    buffer(TAMANO_BUFFER), inicio(0), fin(0), finArchivo(false),
+    registros(0), bytesLeidos(0), lineasIgnoradas(0) {
+
+    // "-" lee de la entrada estandar (traza en una tuberia)
+    if (rutaArchivo == "-") {
+        descriptor = STDIN_FILENO;
+        return;
+    }
+    descriptor = ::open(rutaArchivo.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo abrir la traza " + rutaArchivo);
+    }
+    propio = true;
+    // la traza se recorre una vez de principio a fin
+    ::posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+}
+
+ImportadorTraza::~ImportadorTraza() {
+    cerrar();
+}
+
+// libera el descriptor si es propio
+void ImportadorTraza::cerrar() {
+    if (propio && descriptor >= 0) {
+        ::close(descriptor);
+    }
+    descriptor = -1;
+}
+
+// mueve los bytes pendientes al principio y llena el resto del buffer
+bool ImportadorTraza::rellenar() {
+    if (inicio > 0) {
+        std::memmove(buffer.data(), buffer.data() + inicio, fin - inicio);
+        fin -= inicio;
+        inicio = 0;
+    }
+    // en una tuberia read devuelve lo que haya: se sigue leyendo hasta llenar el buffer
+    while (!finArchivo && fin < buffer.size()) {
+        const ssize_t leidos = ::read(descriptor, buffer.data() + fin, buffer.size() - fin);
+        if (leidos < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Error al leer la traza");
+        }
+        if (leidos == 0) {
+            finArchivo = true;
+            break;
+        }
+        fin += static_cast<std::size_t>(leidos);
+        bytesLeidos += static_cast<uint64_t>(leidos);
+    }
+    return fin > inicio;
+}
+
+// añade un acceso al tramo (las instrucciones se descartan si asi se pidio)
+void ImportadorTraza::anadir(TramoTraza& tramo, uint64_t direccion, TipoAcceso tipo, uint64_t pc) {
+    if (tipo == TipoAcceso::INSTRUCCION && !incluirInstrucciones) return;
+    tramo.direcciones.push_back(direccion);
+    tramo.tipos.push_back(tipo);
+    if (formato == FormatoTrazaExterna::CHAMPSIM) tramo.pcs.push_back(pc);
+    ++registros;
+}
+
+// decodifica una linea de DineroIV o de lackey
+void ImportadorTraza::decodificarLinea(const char* linea, const char* finLinea, TramoTraza& tramo) {
+    if (finLinea > linea && finLinea[-1] == '\r') --finLinea;
+    const char* p = saltarEspacios(linea, finLinea);
+    // lineas en blanco
+    if (p == finLinea) return;
+    uint64_t direccion = 0;
+
+    if (formato == FormatoTrazaExterna::DINERO) {
+        // etiqueta decimal y direccion hexadecimal; el tamaño se ignora
+        int etiqueta = -1;
+        const std::from_chars_result resultado = std::from_chars(p, finLinea, etiqueta);
+        const char* campo = resultado.ec == std::errc() ? saltarEspacios(resultado.ptr, finLinea) : nullptr;
+        if (campo == nullptr || leerHexadecimal(campo, finLinea, direccion) == nullptr) {
+            ++lineasIgnoradas;
+            return;
+        }
+        switch (etiqueta) {
+            case 0: anadir(tramo, direccion, TipoAcceso::LECTURA, 0); return;
+            case 1: anadir(tramo, direccion, TipoAcceso::ESCRITURA, 0); return;
+            case 2: anadir(tramo, direccion, TipoAcceso::INSTRUCCION, 0); return;
+            // 3 (escape) y 4 (vaciado de cache) no son accesos
+            case 3:
+            case 4: return;
+        }
+        ++lineasIgnoradas;
+        return;
+    }
+
+    // lackey: operacion, espacios y "direccion,tamaño"; las cabeceras "==pid==" no son accesos
+    const char operacion = *p;
+    const char* campo = saltarEspacios(p + 1, finLinea);
+    if ((operacion != 'I' && operacion != 'L' && operacion != 'S' && operacion != 'M') || campo == p + 1 ||
+        leerHexadecimal(campo, finLinea, direccion) == nullptr) {
+        ++lineasIgnoradas;
+        return;
+    }
+    switch (operacion) {
+        case 'I': anadir(tramo, direccion, TipoAcceso::INSTRUCCION, 0); return;
+        case 'L': anadir(tramo, direccion, TipoAcceso::LECTURA, 0); return;
+        case 'S': anadir(tramo, direccion, TipoAcceso::ESCRITURA, 0); return;
+    }
+    // modificacion: lectura seguida de escritura del mismo dato
+    anadir(tramo, direccion, TipoAcceso::LECTURA, 0);
+    anadir(tramo, direccion, TipoAcceso::ESCRITURA, 0);
+}
+
+// decodifica un registro de ChampSim: busqueda de la instruccion, lecturas y escrituras
+// (las direcciones a cero son huecos sin usar)
+void ImportadorTraza::decodificarChampSim(const char* registro, TramoTraza& tramo) {
+    uint64_t ip = 0;
+    uint64_t destinos[2];
+    uint64_t origenes[4];
+    std::memcpy(&ip, registro, sizeof(ip));
+    std::memcpy(destinos, registro + 16, sizeof(destinos));
+    std::memcpy(origenes, registro + 32, sizeof(origenes));
+
+    anadir(tramo, ip, TipoAcceso::INSTRUCCION, ip);
+    for (uint64_t origen : origenes) {
+        if (origen != 0) anadir(tramo, origen, TipoAcceso::LECTURA, ip);
+    }
+    for (uint64_t destino : destinos) {
+        if (destino != 0) anadir(tramo, destino, TipoAcceso::ESCRITURA, ip);
+    }
+}
+
+// decodifica el siguiente tramo de accesos
+bool ImportadorTraza::siguienteTramo(TramoTraza& tramo, std::size_t maxRegistros) {
+    tramo.direcciones.clear();
+    tramo.tipos.clear();
+    tramo.pcs.clear();
+
+    while (tramo.direcciones.size() < maxRegistros) {
+        if (formato == FormatoTrazaExterna::CHAMPSIM) {
+            // registros completos que quedan en el buffer
+            if (fin - inicio < TAMANO_REGISTRO_CHAMPSIM) {
+                if (!finArchivo) {
+                    rellenar();
+                    continue;
+                }
+                // un registro cortado al final del archivo no se puede decodificar
+                if (fin > inicio) {
+                    ++lineasIgnoradas;
+                    inicio = fin;
+                }
+                break;
+            }
+            decodificarChampSim(buffer.data() + inicio, tramo);
+            inicio += TAMANO_REGISTRO_CHAMPSIM;
+            continue;
+        }
+
+        // formatos de texto: una linea por iteracion
+        const char* linea = buffer.data() + inicio;
+        const char* salto = static_cast<const char*>(std::memchr(linea, '\n', fin - inicio));
+        if (salto == nullptr) {
+            if (!finArchivo && (inicio > 0 || fin < buffer.size())) {
+                rellenar();
+                continue;
+            }
+            // ultima linea sin salto, o linea mas larga que el buffer (se descarta)
+            if (finArchivo) {
+                if (fin > inicio) decodificarLinea(linea, buffer.data() + fin, tramo);
+                inicio = fin;
+                break;
+            }
+            ++lineasIgnoradas;
+            inicio = fin;
+            continue;
+        }
+        decodificarLinea(linea, salto, tramo);
+        inicio = static_cast<std::size_t>(salto - buffer.data()) + 1;
+    }
+    return !tramo.direcciones.empty();
+}
+
+// nombre del formato para mensajes e informes
+const char* nombreFormatoTrazaExterna(FormatoTrazaExterna formato) {
+    switch (formato) {
+        case FormatoTrazaExterna::DINERO:   return "dinero";
+        case FormatoTrazaExterna::LACKEY:   return "lackey";
+        case FormatoTrazaExterna::CHAMPSIM: return "champsim";
+    }
+    return "desconocido";
+}
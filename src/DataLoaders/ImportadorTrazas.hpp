@@ -0,0 +1,93 @@
+// directiva para evitar inclusiones multiples
+#ifndef IMPORTADORTRAZAS_HPP
+#define IMPORTADORTRAZAS_HPP
+
+// inclusion para el buffer de lectura
+#include <vector>
+// inclusion para la ruta del archivo
+#include <string>
+// inclusion para tipos size_t
+#include <cstddef>
+// inclusion para tipos enteros de tamaño fijo
+#include <cstdint>
+// inclusion del tramo de registros que consume la cache
+#include "DataLoaders/TrazaBinaria.hpp"
+
+// formatos de traza de otras herramientas
+enum class FormatoTrazaExterna {
+    DINERO,   // texto de DineroIV: "etiqueta direccion_hex [tamaño]" (0 lectura, 1 escritura, 2 instruccion)
+    LACKEY,   // salida de valgrind --tool=lackey --trace-mem=yes ("I", " L", " S", " M direccion,tamaño")
+    CHAMPSIM  // registros binarios de 64 bytes de ChampSim (descomprimidos)
+};
+
+// importador en flujo de trazas externas
+// lee el archivo (o la entrada estandar con la ruta "-") en bloques grandes con read(),
+// sin iostreams, y convierte los numeros con std::from_chars; los tramos que devuelve
+// son los mismos que los de LectorTrazaBinaria, asi que van directos a Cache::accederLote
+class ImportadorTraza {
+private:
+    // descriptor del archivo o de la entrada estandar
+    int descriptor;
+    // true si el descriptor lo abrio el importador y debe cerrarlo
+    bool propio;
+    FormatoTrazaExterna formato;
+    // false descarta las busquedas de instruccion
+    bool incluirInstrucciones;
+
+    // buffer de lectura: [inicio, fin) son bytes leidos aun sin procesar
+    std::vector<char> buffer;
+    std::size_t inicio;
+    std::size_t fin;
+    bool finArchivo;
+
+    // contadores
+    uint64_t registros;
+    uint64_t bytesLeidos;
+    uint64_t lineasIgnoradas;
+
+    // mueve lo pendiente al principio del buffer y lee mas; false si no queda nada por leer
+    bool rellenar();
+    // decodifica una linea de texto (sin el salto) y añade sus accesos al tramo
+    void decodificarLinea(const char* linea, const char* finLinea, TramoTraza& tramo);
+    // decodifica un registro binario de ChampSim y añade sus accesos al tramo
+    void decodificarChampSim(const char* registro, TramoTraza& tramo);
+    // añade un acceso al tramo
+    void anadir(TramoTraza& tramo, uint64_t direccion, TipoAcceso tipo, uint64_t pc);
+    // libera el descriptor
+    void cerrar();
+
+public:
+    // bytes leidos en cada llamada al sistema
+    static constexpr std::size_t TAMANO_BUFFER = std::size_t(1) << 22;
+    // bytes de un registro de ChampSim: ip, 2 banderas de salto, 2 + 4 registros,
+    // 2 direcciones de destino y 4 de origen
+    static constexpr std::size_t TAMANO_REGISTRO_CHAMPSIM = 64;
+
+    // abre la traza ("-" = entrada estandar); lanza std::runtime_error si no se puede abrir
+    ImportadorTraza(const std::string& rutaArchivo, FormatoTrazaExterna formato,
+                    bool incluirInstrucciones = true);
+    ~ImportadorTraza();
+    ImportadorTraza(const ImportadorTraza&) = delete;
+    ImportadorTraza& operator=(const ImportadorTraza&) = delete;
+
+    // decodifica al menos maxRegistros accesos si quedan (un registro que genera varios
+    // accesos puede pasarse unos pocos); devuelve false al llegar al final
+    // tipos siempre se rellena; pcs solo en ChampSim
+    bool siguienteTramo(TramoTraza& tramo, std::size_t maxRegistros = LectorTrazaBinaria::REGISTROS_POR_TRAMO);
+
+    // metodos de consulta
+    bool tieneTipos() const { return true; }
+    bool tienePC() const { return formato == FormatoTrazaExterna::CHAMPSIM; }
+    // accesos devueltos hasta ahora
+    uint64_t getRegistros() const { return registros; }
+    // bytes leidos de la traza hasta ahora
+    uint64_t getBytesLeidos() const { return bytesLeidos; }
+    // lineas (o registros incompletos) que no se pudieron interpretar
+    uint64_t getLineasIgnoradas() const { return lineasIgnoradas; }
+};
+
+// devuelve el nombre legible de un formato externo
+const char* nombreFormatoTrazaExterna(FormatoTrazaExterna formato);
+
+// fin de la directiva de preprocesador ifndef
+#endif // IMPORTADORTRAZAS_HPP
@@ -1,31 +1,330 @@
 #include "LectorModelos3D.hpp"
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+// proyeccion de archivos en memoria (posix)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-// carga un modelo 3d desde un archivo .obj
-std::vector<Vertice> LectorModelos3D::cargarModeloOBJ(const std::string& rutaArchivo) {
+// esquina de cara sin resolver: indices base 0 absolutos (>= 0), relativos al principio
+// del tramo (desplazados por RELATIVO, asi siempre son muy negativos) o AUSENTE
+static constexpr int64_t AUSENTE = -1;
+static constexpr int64_t RELATIVO = -(int64_t(1) << 62);
+
+// resultado de analizar un tramo del archivo
+struct TramoOBJ {
     std::vector<Vertice> vertices;
-    std::ifstream archivo(rutaArchivo);
-    std::string linea;
+    std::vector<Vertice> normales;
+    std::vector<CoordenadaTextura> texturas;
+    // tres esquinas por triangulo
+    std::vector<int64_t> indices;
+    std::vector<int64_t> indicesTextura;
+    std::vector<int64_t> indicesNormales;
+    // esquinas de la cara en curso (se reutiliza entre caras)
+    std::vector<int64_t> cara;
+    bool conTextura = false;
+    bool conNormal = false;
+    // alguna cara usa el indice 0, que no existe en OBJ
+    bool indiceInvalido = false;
+};
 
-    if (!archivo.is_open()) {
-        std::cerr << "error: no se pudo abrir el archivo " << rutaArchivo << std::endl;
-        return vertices;
+// archivo proyectado en memoria, se libera al salir del ambito
+struct ArchivoProyectado {
+    int descriptor = -1;
+    const char* datos = nullptr;
+    std::size_t tamano = 0;
+
+    explicit ArchivoProyectado(const std::string& rutaArchivo) {
+        descriptor = ::open(rutaArchivo.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("No se pudo abrir el modelo " + rutaArchivo);
+        }
+        struct stat informacion;
+        if (::fstat(descriptor, &informacion) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error("No se pudo leer el modelo " + rutaArchivo);
+        }
+        tamano = static_cast<std::size_t>(informacion.st_size);
+        // un archivo vacio no se puede proyectar (y no hay nada que leer)
+        if (tamano == 0) return;
+        void* proyeccion = ::mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (proyeccion == MAP_FAILED) {
+            ::close(descriptor);
+            throw std::runtime_error("No se pudo proyectar el modelo " + rutaArchivo);
+        }
+        datos = static_cast<const char*>(proyeccion);
+        // los hilos recorren todo el archivo a la vez: se pide leerlo entero por adelantado
+        ::madvise(proyeccion, tamano, MADV_WILLNEED);
+    }
+    ~ArchivoProyectado() {
+        if (datos != nullptr) ::munmap(const_cast<char*>(datos), tamano);
+        if (descriptor >= 0) ::close(descriptor);
+    }
+    ArchivoProyectado(const ArchivoProyectado&) = delete;
+    ArchivoProyectado& operator=(const ArchivoProyectado&) = delete;
+};
+
+// ejecuta funcion(i) para i en [0, cantidad), cada una en su hilo (la 0 en el hilo actual)
+template <typename Funcion>
+static void enParalelo(std::size_t cantidad, Funcion funcion) {
+    std::vector<std::thread> trabajadores;
+    trabajadores.reserve(cantidad > 0 ? cantidad - 1 : 0);
+    for (std::size_t i = 1; i < cantidad; ++i) {
+        trabajadores.emplace_back(funcion, i);
+    }
+    if (cantidad > 0) funcion(std::size_t(0));
+    for (auto& trabajador : trabajadores) {
+        trabajador.join();
     }
+}
 
-    while (std::getline(archivo, linea)) {
-        std::istringstream ss(linea);
-        std::string tipo;
-        ss >> tipo;
+// salta espacios y tabuladores
+static const char* saltarEspacios(const char* p, const char* fin) {
+    while (p < fin && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
 
-        if (tipo == "v") { // solo nos interesan los vertices
+// lee un real tras los espacios (from_chars no admite el signo +); si no hay ninguno deja 0
+static const char* leerReal(const char* p, const char* fin, float& valor) {
+    p = saltarEspacios(p, fin);
+    if (p < fin && *p == '+') ++p;
+    const std::from_chars_result resultado = std::from_chars(p, fin, valor);
+    if (resultado.ec != std::errc()) {
+        valor = 0.0f;
+        return p;
+    }
+    return resultado.ptr;
+}
+
+// convierte un indice de OBJ (base 1, negativo = relativo al ultimo definido) al formato del tramo
+static int64_t convertirIndice(int64_t indice, std::size_t definidosEnTramo, TramoOBJ& tramo) {
+    if (indice > 0) return indice - 1;
+    if (indice < 0) return RELATIVO + static_cast<int64_t>(definidosEnTramo) + indice;
+    tramo.indiceInvalido = true;
+    return AUSENTE;
+}
+
+// lee las esquinas de una cara ("v", "v/vt", "v//vn" o "v/vt/vn") y la abre en abanico
+static void leerCara(const char* p, const char* fin, TramoOBJ& tramo) {
+    // cada esquina ocupa tres posiciones en cara: vertice, textura y normal
+    tramo.cara.clear();
+    while (true) {
+        p = saltarEspacios(p, fin);
+        int64_t vertice = 0;
+        std::from_chars_result resultado = std::from_chars(p, fin, vertice);
+        if (resultado.ec != std::errc()) break;
+        p = resultado.ptr;
+        int64_t textura = AUSENTE;
+        int64_t normal = AUSENTE;
+        if (p < fin && *p == '/') {
+            ++p;
+            int64_t indice = 0;
+            resultado = std::from_chars(p, fin, indice);
+            if (resultado.ec == std::errc()) {
+                p = resultado.ptr;
+                textura = convertirIndice(indice, tramo.texturas.size(), tramo);
+                tramo.conTextura = true;
+            }
+            if (p < fin && *p == '/') {
+                ++p;
+                resultado = std::from_chars(p, fin, indice);
+                if (resultado.ec == std::errc()) {
+                    p = resultado.ptr;
+                    normal = convertirIndice(indice, tramo.normales.size(), tramo);
+                    tramo.conNormal = true;
+                }
+            }
+        }
+        tramo.cara.push_back(convertirIndice(vertice, tramo.vertices.size(), tramo));
+        tramo.cara.push_back(textura);
+        tramo.cara.push_back(normal);
+    }
+
+    // abanico: (0, i, i + 1) para cada i
+    const std::size_t esquinas = tramo.cara.size() / 3;
+    for (std::size_t i = 1; i + 1 < esquinas; ++i) {
+        for (std::size_t esquina : {std::size_t(0), i, i + 1}) {
+            tramo.indices.push_back(tramo.cara[esquina * 3]);
+            tramo.indicesTextura.push_back(tramo.cara[esquina * 3 + 1]);
+            tramo.indicesNormales.push_back(tramo.cara[esquina * 3 + 2]);
+        }
+    }
+}
+
+// analiza las lineas de [p, fin); el tramo empieza al principio de una linea
+static void analizarTramo(const char* p, const char* fin, bool soloVertices, TramoOBJ& tramo) {
+    while (p < fin) {
+        const char* salto = static_cast<const char*>(std::memchr(p, '\n', fin - p));
+        const char* finLinea = salto != nullptr ? salto : fin;
+        const char* linea = saltarEspacios(p, finLinea);
+        p = finLinea + 1;
+
+        if (finLinea - linea < 2) continue;
+        const char tipo = linea[0];
+        const char subtipo = linea[1];
+        if (tipo == 'v' && (subtipo == ' ' || subtipo == '\t')) {
+            // "v x y z [w]": la w y los colores por vertice se ignoran
             Vertice v;
-            ss >> v.x >> v.y >> v.z;
-            vertices.push_back(v);
+            const char* q = leerReal(linea + 1, finLinea, v.x);
+            q = leerReal(q, finLinea, v.y);
+            leerReal(q, finLinea, v.z);
+            tramo.vertices.push_back(v);
+        }
+        else if (soloVertices) {
+            continue;
+        }
+        else if (tipo == 'v' && subtipo == 'n') {
+            Vertice n;
+            const char* q = leerReal(linea + 2, finLinea, n.x);
+            q = leerReal(q, finLinea, n.y);
+            leerReal(q, finLinea, n.z);
+            tramo.normales.push_back(n);
         }
+        else if (tipo == 'v' && subtipo == 't') {
+            // "vt u [v [w]]"
+            CoordenadaTextura t;
+            const char* q = leerReal(linea + 2, finLinea, t.u);
+            leerReal(q, finLinea, t.v);
+            tramo.texturas.push_back(t);
+        }
+        else if (tipo == 'f' && (subtipo == ' ' || subtipo == '\t')) {
+            leerCara(linea + 1, finLinea, tramo);
+        }
+        // comentarios, grupos, materiales y demas se ignoran
+    }
+}
+
+// resuelve una esquina del tramo con los elementos definidos en los tramos anteriores
+static uint32_t resolverIndice(int64_t indice, uint64_t anteriores, uint64_t total, bool& fueraDeRango) {
+    if (indice == AUSENTE) return MallaIndexada::SIN_INDICE;
+    const int64_t absoluto = indice >= 0 ? indice : static_cast<int64_t>(anteriores) + (indice - RELATIVO);
+    if (absoluto < 0 || static_cast<uint64_t>(absoluto) >= total) {
+        fueraDeRango = true;
+        return MallaIndexada::SIN_INDICE;
+    }
+    return static_cast<uint32_t>(absoluto);
+}
+
+// lee el archivo en tramos paralelos y une los resultados
+static MallaIndexada cargarOBJ(const std::string& rutaArchivo, unsigned hilos, bool soloVertices) {
+    MallaIndexada malla;
+    ArchivoProyectado archivo(rutaArchivo);
+    if (archivo.tamano == 0) return malla;
+
+    // por defecto un hilo por nucleo del anfitrion, con tramos de al menos MINIMO_POR_HILO bytes
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t numTramos = std::min<std::size_t>(
+        hilos, std::max<std::size_t>(1, archivo.tamano / LectorModelos3D::MINIMO_POR_HILO));
+
+    // limites de los tramos: cada uno se adelanta hasta el siguiente salto de linea
+    const char* datos = archivo.datos;
+    const char* finDatos = datos + archivo.tamano;
+    std::vector<const char*> limites(numTramos + 1, finDatos);
+    limites[0] = datos;
+    for (std::size_t i = 1; i < numTramos; ++i) {
+        const char* corte = std::max(limites[i - 1], datos + archivo.tamano * i / numTramos);
+        const char* salto = static_cast<const char*>(std::memchr(corte, '\n', finDatos - corte));
+        limites[i] = salto != nullptr ? salto + 1 : finDatos;
+    }
+
+    // 1. analisis de cada tramo en su hilo
+    std::vector<TramoOBJ> tramos(numTramos);
+    enParalelo(numTramos, [&](std::size_t i) {
+        analizarTramo(limites[i], limites[i + 1], soloVertices, tramos[i]);
+    });
+
+    // 2. posicion de cada tramo en los vectores finales
+    struct Desplazamientos {
+        uint64_t vertices = 0, normales = 0, texturas = 0, indices = 0;
+    };
+    std::vector<Desplazamientos> inicio(numTramos + 1);
+    bool conTextura = false;
+    bool conNormal = false;
+    for (std::size_t i = 0; i < numTramos; ++i) {
+        const TramoOBJ& tramo = tramos[i];
+        if (tramo.indiceInvalido) {
+            throw std::runtime_error("Cara con indice 0 en el modelo " + rutaArchivo);
+        }
+        inicio[i + 1].vertices = inicio[i].vertices + tramo.vertices.size();
+        inicio[i + 1].normales = inicio[i].normales + tramo.normales.size();
+        inicio[i + 1].texturas = inicio[i].texturas + tramo.texturas.size();
+        inicio[i + 1].indices = inicio[i].indices + tramo.indices.size();
+        conTextura = conTextura || tramo.conTextura;
+        conNormal = conNormal || tramo.conNormal;
     }
+    const Desplazamientos& totales = inicio[numTramos];
+    if (totales.vertices > MallaIndexada::SIN_INDICE) {
+        throw std::runtime_error("Demasiados vertices en el modelo " + rutaArchivo);
+    }
+
+    // 3. union en vectores reservados de antemano, cada tramo copiado por su hilo
+    malla.vertices.resize(totales.vertices);
+    malla.normales.resize(totales.normales);
+    malla.texturas.resize(totales.texturas);
+    malla.indices.resize(totales.indices);
+    if (conTextura) malla.indicesTextura.resize(totales.indices);
+    if (conNormal) malla.indicesNormales.resize(totales.indices);
+    std::vector<char> fueraDeRango(numTramos, 0);
+    enParalelo(numTramos, [&](std::size_t i) {
+        TramoOBJ& tramo = tramos[i];
+        const Desplazamientos& desde = inicio[i];
+        std::copy(tramo.vertices.begin(), tramo.vertices.end(), malla.vertices.begin() + desde.vertices);
+        std::copy(tramo.normales.begin(), tramo.normales.end(), malla.normales.begin() + desde.normales);
+        std::copy(tramo.texturas.begin(), tramo.texturas.end(), malla.texturas.begin() + desde.texturas);
+        bool fuera = false;
+        for (std::size_t k = 0; k < tramo.indices.size(); ++k) {
+            const std::size_t destino = desde.indices + k;
+            malla.indices[destino] = resolverIndice(tramo.indices[k], desde.vertices, totales.vertices, fuera);
+            if (conTextura) {
+                malla.indicesTextura[destino] =
+                    resolverIndice(tramo.indicesTextura[k], desde.texturas, totales.texturas, fuera);
+            }
+            if (conNormal) {
+                malla.indicesNormales[destino] =
+                    resolverIndice(tramo.indicesNormales[k], desde.normales, totales.normales, fuera);
+            }
+        }
+        fueraDeRango[i] = fuera;
+        // libera el tramo en cuanto se ha copiado
+        tramo = TramoOBJ();
+    });
+    if (std::find(fueraDeRango.begin(), fueraDeRango.end(), 1) != fueraDeRango.end()) {
+        throw std::runtime_error("Cara con un indice inexistente en el modelo " + rutaArchivo);
+    }
+    return malla;
+}
+
+// carga un modelo 3d desde un archivo .obj
+std::vector<Vertice> LectorModelos3D::cargarModeloOBJ(const std::string& rutaArchivo) {
+    try {
+        // la cache binaria evita analizar el texto
+        const std::string rutaBinaria = rutaMallaBinaria(rutaArchivo);
+        if (mallaBinariaVigente(rutaBinaria, rutaArchivo)) {
+            try {
+                return MallaProyectada(rutaBinaria).copiarVertices();
+            } catch (const std::runtime_error&) {
+                // cache no valida: se lee el modelo de texto
+            }
+        }
+        return cargarOBJ(rutaArchivo, 0, true).vertices;
+    }
+    catch (const std::runtime_error&) {
+        std::cerr << "error: no se pudo abrir el archivo " << rutaArchivo << std::endl;
+        return std::vector<Vertice>();
+    }
+}
+
+// carga la malla completa de un .obj
+MallaIndexada LectorModelos3D::cargarMallaOBJ(const std::string& rutaArchivo, unsigned hilos) {
+    return cargarOBJ(rutaArchivo, hilos, false);
+}
 
-    archivo.close();
-    return vertices;
+// abre la malla de un .obj a traves de su cache binaria
+MallaProyectada LectorModelos3D::abrirMallaOBJ(const std::string& rutaArchivo, bool guardarBinaria) {
+    return abrirConMallaBinaria(rutaArchivo, guardarBinaria, [&]() { return cargarOBJ(rutaArchivo, 0, false); });
 }
\ No newline at end of file
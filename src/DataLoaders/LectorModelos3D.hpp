@@ -4,11 +4,31 @@
 #include <vector>
 #include <string>
 #include "Common/Vertice.hpp"  // Incluir la definicion de Vertice
+#include "Common/MallaIndexada.hpp"
+#include "DataLoaders/MallaBinaria.hpp"
 
 class LectorModelos3D {
 public:
-    // carga un modelo 3d desde un archivo .obj
+    // bytes minimos de cada tramo: con archivos pequeños no compensa lanzar hilos
+    static constexpr std::size_t MINIMO_POR_HILO = std::size_t(1) << 20;
+
+    // carga un modelo 3d desde un archivo .obj (solo los vertices)
+    // si junto al modelo hay una malla binaria vigente (ruta + ".cmsh") la usa en su lugar
+    // si no se puede leer el archivo avisa por std::cerr y devuelve un vector vacio
     static std::vector<Vertice> cargarModeloOBJ(const std::string& rutaArchivo);
+
+    // carga la malla completa de un .obj (v, vn, vt y f) proyectando el archivo en memoria:
+    // lo parte en tramos que terminan en salto de linea, los analiza en paralelo con
+    // std::from_chars (hilos = 0 usa todos los nucleos del anfitrion) y une los tramos en
+    // vectores reservados de antemano; los indices negativos (relativos) se resuelven al unir
+    // lanza std::runtime_error si no se puede leer el archivo o una cara usa un indice inexistente
+    static MallaIndexada cargarMallaOBJ(const std::string& rutaArchivo, unsigned hilos = 0);
+
+    // abre la malla de un .obj a traves de su cache binaria: si la cache es vigente se proyecta
+    // en memoria y se usa sin analizar ni copiar; si no, se carga el .obj con cargarMallaOBJ y
+    // se guarda la cache (si guardarBinaria y se puede escribir) para la proxima vez
+    // lanza std::runtime_error igual que cargarMallaOBJ
+    static MallaProyectada abrirMallaOBJ(const std::string& rutaArchivo, bool guardarBinaria = true);
 };
 
 #endif // LECTORMODELOS3D_HPP
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "MallaBinaria.hpp"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <utility>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+// proyeccion de archivos en memoria (posix)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// redondea al siguiente multiplo de la alineacion de los bloques
+static uint64_t alinear(uint64_t bytes) {
+    return (bytes + formatoMalla::ALINEACION - 1) & ~static_cast<uint64_t>(formatoMalla::ALINEACION - 1);
+}
+
+// posicion de cada bloque respecto al final de la cabecera
+struct DisposicionMalla {
+    uint64_t vertices, normales, texturas, indices, indicesTextura, indicesNormales, total;
+};
+
+// calcula la disposicion de los bloques a partir de los tamaños
+static DisposicionMalla disponer(uint64_t numVertices, uint64_t numNormales, uint64_t numTexturas,
+                                 uint64_t numIndices, uint16_t banderas) {
+    DisposicionMalla disposicion;
+    disposicion.vertices = 0;
+    disposicion.normales = disposicion.vertices + alinear(numVertices * sizeof(Vertice));
+    disposicion.texturas = disposicion.normales + alinear(numNormales * sizeof(Vertice));
+    disposicion.indices = disposicion.texturas + alinear(numTexturas * sizeof(CoordenadaTextura));
+    const uint64_t bytesIndices = alinear(numIndices * sizeof(uint32_t));
+    disposicion.indicesTextura = disposicion.indices + bytesIndices;
+    disposicion.indicesNormales = disposicion.indicesTextura +
+                                  ((banderas & formatoMalla::CON_INDICES_TEXTURA) ? bytesIndices : 0);
+    disposicion.total = disposicion.indicesNormales +
+                        ((banderas & formatoMalla::CON_INDICES_NORMALES) ? bytesIndices : 0);
+    return disposicion;
+}
+
+// suma de comprobacion: cuatro acumuladores independientes (para no encadenar las
+// multiplicaciones) que mezclan una palabra de 64 bits cada uno y se combinan al final
+uint64_t sumaComprobacionMalla(const unsigned char* datos, std::size_t tamano) {
+    const uint64_t primo1 = 0x9E3779B185EBCA87ull;
+    const uint64_t primo2 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t acumuladores[4] = {primo1, primo2, ~primo1, ~primo2};
+    auto mezclar = [&](uint64_t acumulador, uint64_t palabra) {
+        acumulador += palabra * primo2;
+        acumulador = (acumulador << 31) | (acumulador >> 33);
+        return acumulador * primo1;
+    };
+    std::size_t posicion = 0;
+    for (; posicion + 32 <= tamano; posicion += 32) {
+        uint64_t palabras[4];
+        std::memcpy(palabras, datos + posicion, sizeof(palabras));
+        for (int i = 0; i < 4; ++i) acumuladores[i] = mezclar(acumuladores[i], palabras[i]);
+    }
+    // resto: palabras sueltas y la ultima rellenada con ceros
+    for (; posicion < tamano; posicion += 8) {
+        uint64_t palabra = 0;
+        std::memcpy(&palabra, datos + posicion, std::min<std::size_t>(8, tamano - posicion));
+        acumuladores[0] = mezclar(acumuladores[0], palabra);
+    }
+    uint64_t suma = tamano;
+    for (uint64_t acumulador : acumuladores) {
+        suma = mezclar(suma ^ acumulador, acumulador);
+    }
+    return suma ^ (suma >> 29);
+}
+
+// escribe la malla en formato binario
+void escribirMallaBinaria(const std::string& rutaArchivo, const MallaIndexada& malla) {
+    if (malla.vertices.size() >= MallaIndexada::SIN_INDICE || malla.indices.size() % 3 != 0) {
+        throw std::runtime_error("La malla no se puede guardar en formato binario");
+    }
+    const bool conTextura = !malla.indicesTextura.empty();
+    const bool conNormales = !malla.indicesNormales.empty();
+    if ((conTextura && malla.indicesTextura.size() != malla.indices.size()) ||
+        (conNormales && malla.indicesNormales.size() != malla.indices.size())) {
+        throw std::runtime_error("La malla no se puede guardar en formato binario");
+    }
+    const uint16_t banderas = (conTextura ? formatoMalla::CON_INDICES_TEXTURA : 0) |
+                              (conNormales ? formatoMalla::CON_INDICES_NORMALES : 0);
+    const DisposicionMalla disposicion = disponer(malla.vertices.size(), malla.normales.size(),
+                                                  malla.texturas.size(), malla.indices.size(), banderas);
+
+    // archivo completo en memoria, con el relleno a cero
+    std::vector<unsigned char> contenido(formatoMalla::TAMANO_CABECERA + disposicion.total, 0);
+    unsigned char* bloques = contenido.data() + formatoMalla::TAMANO_CABECERA;
+    auto copiar = [&](uint64_t posicion, const auto& vector) {
+        if (!vector.empty()) std::memcpy(bloques + posicion, vector.data(), vector.size() * sizeof(vector[0]));
+    };
+    copiar(disposicion.vertices, malla.vertices);
+    copiar(disposicion.normales, malla.normales);
+    copiar(disposicion.texturas, malla.texturas);
+    copiar(disposicion.indices, malla.indices);
+    copiar(disposicion.indicesTextura, malla.indicesTextura);
+    copiar(disposicion.indicesNormales, malla.indicesNormales);
+
+    // cabecera
+    const uint64_t campos[6] = {malla.vertices.size(), malla.normales.size(), malla.texturas.size(),
+                                malla.indices.size(), disposicion.total,
+                                sumaComprobacionMalla(bloques, disposicion.total)};
+    std::memcpy(contenido.data(), formatoMalla::MAGIA, sizeof(formatoMalla::MAGIA));
+    std::memcpy(contenido.data() + 4, &formatoMalla::VERSION, sizeof(formatoMalla::VERSION));
+    std::memcpy(contenido.data() + 6, &banderas, sizeof(banderas));
+    std::memcpy(contenido.data() + 8, campos, sizeof(campos));
+
+    // temporal y renombrado
+    const std::string temporal = rutaArchivo + ".tmp";
+    {
+        std::ofstream archivo(temporal, std::ios::binary | std::ios::trunc);
+        if (!archivo.is_open()) {
+            throw std::runtime_error("No se pudo crear la malla binaria " + rutaArchivo);
+        }
+        archivo.write(reinterpret_cast<const char*>(contenido.data()), static_cast<std::streamsize>(contenido.size()));
+        archivo.close();
+        if (archivo.fail()) {
+            std::remove(temporal.c_str());
+            throw std::runtime_error("Error al escribir la malla binaria " + rutaArchivo);
+        }
+    }
+    if (std::rename(temporal.c_str(), rutaArchivo.c_str()) != 0) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo crear la malla binaria " + rutaArchivo);
+    }
+}
+
+// ruta de la cache binaria de un modelo de texto
+std::string rutaMallaBinaria(const std::string& rutaModelo) {
+    return rutaModelo + formatoMalla::EXTENSION;
+}
+
+// compara las fechas de modificacion (con nanosegundos)
+bool mallaBinariaVigente(const std::string& rutaBinaria, const std::string& rutaModelo) {
+    struct stat binaria;
+    if (::stat(rutaBinaria.c_str(), &binaria) != 0) return false;
+    struct stat modelo;
+    if (::stat(rutaModelo.c_str(), &modelo) != 0) return true;
+    if (binaria.st_mtim.tv_sec != modelo.st_mtim.tv_sec) return binaria.st_mtim.tv_sec > modelo.st_mtim.tv_sec;
+    return binaria.st_mtim.tv_nsec >= modelo.st_mtim.tv_nsec;
+}
+
+// proyecta el archivo y coloca la vista sobre sus bloques
+MallaProyectada::MallaProyectada(const std::string& rutaArchivo) :
+    descriptor(-1), datos(nullptr), tamanoArchivo(0) {
+
+    descriptor = ::open(rutaArchivo.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo abrir la malla binaria " + rutaArchivo);
+    }
+    struct stat informacion;
+    if (::fstat(descriptor, &informacion) != 0 ||
+        static_cast<std::size_t>(informacion.st_size) < formatoMalla::TAMANO_CABECERA) {
+        cerrar();
+        throw std::runtime_error("Malla binaria sin cabecera: " + rutaArchivo);
+    }
+    tamanoArchivo = static_cast<std::size_t>(informacion.st_size);
+    void* proyeccion = ::mmap(nullptr, tamanoArchivo, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (proyeccion == MAP_FAILED) {
+        cerrar();
+        throw std::runtime_error("No se pudo proyectar la malla binaria " + rutaArchivo);
+    }
+    datos = static_cast<const unsigned char*>(proyeccion);
+
+    // valida la cabecera
+    uint16_t version = 0;
+    uint16_t banderas = 0;
+    uint64_t campos[6];
+    std::memcpy(&version, datos + 4, sizeof(version));
+    std::memcpy(&banderas, datos + 6, sizeof(banderas));
+    std::memcpy(campos, datos + 8, sizeof(campos));
+    if (std::memcmp(datos, formatoMalla::MAGIA, sizeof(formatoMalla::MAGIA)) != 0 ||
+        version != formatoMalla::VERSION) {
+        cerrar();
+        throw std::runtime_error("Malla binaria con formato no valido: " + rutaArchivo);
+    }
+    // cada bloque debe caber en el archivo (tambien evita desbordar al calcular la disposicion)
+    for (int i = 0; i < 4; ++i) {
+        if (campos[i] > tamanoArchivo) {
+            cerrar();
+            throw std::runtime_error("Malla binaria truncada: " + rutaArchivo);
+        }
+    }
+    const DisposicionMalla disposicion = disponer(campos[0], campos[1], campos[2], campos[3], banderas);
+    if (campos[4] != disposicion.total || tamanoArchivo != formatoMalla::TAMANO_CABECERA + disposicion.total ||
+        campos[3] % 3 != 0) {
+        cerrar();
+        throw std::runtime_error("Malla binaria truncada: " + rutaArchivo);
+    }
+
+    // vista sobre los bloques, sin copiar nada
+    const unsigned char* bloques = datos + formatoMalla::TAMANO_CABECERA;
+    numVertices = campos[0];
+    numNormales = campos[1];
+    numTexturas = campos[2];
+    numIndices = campos[3];
+    vertices = reinterpret_cast<const Vertice*>(bloques + disposicion.vertices);
+    normales = reinterpret_cast<const Vertice*>(bloques + disposicion.normales);
+    texturas = reinterpret_cast<const CoordenadaTextura*>(bloques + disposicion.texturas);
+    indices = reinterpret_cast<const uint32_t*>(bloques + disposicion.indices);
+    indicesTextura = (banderas & formatoMalla::CON_INDICES_TEXTURA)
+        ? reinterpret_cast<const uint32_t*>(bloques + disposicion.indicesTextura) : nullptr;
+    indicesNormales = (banderas & formatoMalla::CON_INDICES_NORMALES)
+        ? reinterpret_cast<const uint32_t*>(bloques + disposicion.indicesNormales) : nullptr;
+}
+
+// toma una malla ya cargada en memoria
+MallaProyectada::MallaProyectada(MallaIndexada malla) :
+    descriptor(-1), datos(nullptr), tamanoArchivo(0), propia(std::move(malla)) {
+    verPropia();
+}
+
+// mueve la proyeccion o la malla propia (los vectores movidos conservan su memoria)
+MallaProyectada::MallaProyectada(MallaProyectada&& otra) noexcept :
+    descriptor(otra.descriptor), datos(otra.datos), tamanoArchivo(otra.tamanoArchivo),
+    propia(std::move(otra.propia)), vertices(otra.vertices), normales(otra.normales), texturas(otra.texturas),
+    indices(otra.indices), indicesTextura(otra.indicesTextura), indicesNormales(otra.indicesNormales),
+    numVertices(otra.numVertices), numNormales(otra.numNormales), numTexturas(otra.numTexturas),
+    numIndices(otra.numIndices) {
+    otra.descriptor = -1;
+    otra.datos = nullptr;
+    otra.tamanoArchivo = 0;
+    otra.verPropia();
+}
+
+MallaProyectada::~MallaProyectada() {
+    cerrar();
+}
+
+// apunta la vista a la malla propia
+void MallaProyectada::verPropia() {
+    vertices = propia.vertices.data();
+    normales = propia.normales.data();
+    texturas = propia.texturas.data();
+    indices = propia.indices.data();
+    indicesTextura = propia.indicesTextura.empty() ? nullptr : propia.indicesTextura.data();
+    indicesNormales = propia.indicesNormales.empty() ? nullptr : propia.indicesNormales.data();
+    numVertices = propia.vertices.size();
+    numNormales = propia.normales.size();
+    numTexturas = propia.texturas.size();
+    numIndices = propia.indices.size();
+}
+
+// libera la proyeccion y el descriptor
+void MallaProyectada::cerrar() {
+    if (datos != nullptr) {
+        ::munmap(const_cast<unsigned char*>(datos), tamanoArchivo);
+        datos = nullptr;
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+}
+
+// recalcula la suma de comprobacion de los datos
+bool MallaProyectada::comprobarSuma() const {
+    if (datos == nullptr) return true;
+    uint64_t suma = 0;
+    std::memcpy(&suma, datos + 48, sizeof(suma));
+    return sumaComprobacionMalla(datos + formatoMalla::TAMANO_CABECERA,
+                                 tamanoArchivo - formatoMalla::TAMANO_CABECERA) == suma;
+}
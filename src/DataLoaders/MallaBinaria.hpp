@@ -0,0 +1,137 @@
+#ifndef MALLABINARIA_HPP
+#define MALLABINARIA_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "Common/MallaIndexada.hpp"
+
+// formato binario de malla (little-endian), cache de los modelos de texto:
+//   cabecera de 64 bytes
+//     0  magia "CMSH"
+//     4  version (uint16, actualmente 1)
+//     6  banderas (uint16, bit 0 = indices de textura, bit 1 = indices de normales)
+//     8  numero de vertices (uint64)
+//     16 numero de normales (uint64)
+//     24 numero de coordenadas de textura (uint64)
+//     32 numero de indices, tres por triangulo (uint64)
+//     40 bytes de datos tras la cabecera (uint64)
+//     48 suma de comprobacion de los datos (uint64)
+//     56 reservado (ceros)
+//   bloques en este orden, cada uno alineado a 64 bytes y rellenado con ceros:
+//     vertices (3 float), normales (3 float), texturas (2 float),
+//     indices, indices de textura, indices de normales (uint32; los dos ultimos solo con su bandera)
+namespace formatoMalla {
+    constexpr char MAGIA[4] = {'C', 'M', 'S', 'H'};
+    constexpr uint16_t VERSION = 1;
+    constexpr std::size_t TAMANO_CABECERA = 64;
+    constexpr std::size_t ALINEACION = 64;
+    constexpr uint16_t CON_INDICES_TEXTURA = 1u << 0;
+    constexpr uint16_t CON_INDICES_NORMALES = 1u << 1;
+    // extension que se añade a la ruta del modelo de texto
+    constexpr const char* EXTENSION = ".cmsh";
+}
+
+// suma de comprobacion de los datos de una malla binaria (por palabras de 64 bits)
+uint64_t sumaComprobacionMalla(const unsigned char* datos, std::size_t tamano);
+
+// escribe la malla en formato binario; se escribe en un temporal que luego se renombra,
+// asi un lector nunca ve un archivo a medias
+// lanza std::runtime_error si no se puede escribir o la malla no cabe en indices de 32 bits
+void escribirMallaBinaria(const std::string& rutaArchivo, const MallaIndexada& malla);
+
+// ruta de la cache binaria de un modelo de texto
+std::string rutaMallaBinaria(const std::string& rutaModelo);
+
+// true si la cache binaria existe y no es mas antigua que el modelo de texto
+// (si el modelo ya no existe, basta con que exista la cache)
+bool mallaBinariaVigente(const std::string& rutaBinaria, const std::string& rutaModelo);
+
+// malla lista para usar: un archivo binario proyectado en memoria y usado en su sitio, sin
+// analizar ni copiar nada, o una MallaIndexada propia cuando no hay archivo binario
+// los punteros siguen validos mientras viva el objeto
+class MallaProyectada {
+private:
+    // descriptor y proyeccion del archivo (-1 y nullptr si la malla esta en memoria)
+    int descriptor;
+    const unsigned char* datos;
+    std::size_t tamanoArchivo;
+    // malla en memoria cuando no viene de un archivo
+    MallaIndexada propia;
+
+    // vista de los bloques
+    const Vertice* vertices;
+    const Vertice* normales;
+    const CoordenadaTextura* texturas;
+    const uint32_t* indices;
+    const uint32_t* indicesTextura;
+    const uint32_t* indicesNormales;
+    std::size_t numVertices;
+    std::size_t numNormales;
+    std::size_t numTexturas;
+    std::size_t numIndices;
+
+    // apunta la vista a la malla propia
+    void verPropia();
+    // libera la proyeccion y el descriptor
+    void cerrar();
+
+public:
+    // proyecta y valida la cabecera y los tamaños (no recorre los datos);
+    // lanza std::runtime_error si el archivo no es una malla binaria valida
+    explicit MallaProyectada(const std::string& rutaArchivo);
+    // toma una malla ya cargada en memoria
+    explicit MallaProyectada(MallaIndexada malla);
+    ~MallaProyectada();
+    MallaProyectada(MallaProyectada&& otra) noexcept;
+    MallaProyectada(const MallaProyectada&) = delete;
+    MallaProyectada& operator=(const MallaProyectada&) = delete;
+    MallaProyectada& operator=(MallaProyectada&&) = delete;
+
+    // recalcula la suma de comprobacion y la compara con la cabecera (recorre todo el archivo;
+    // una malla en memoria siempre es correcta)
+    bool comprobarSuma() const;
+    // copia los vertices a un vector
+    std::vector<Vertice> copiarVertices() const { return std::vector<Vertice>(vertices, vertices + numVertices); }
+
+    // metodos de consulta (los indices de textura y normales son nullptr si la malla no los tiene)
+    bool estaProyectada() const { return datos != nullptr; }
+    const Vertice* getVertices() const { return vertices; }
+    const Vertice* getNormales() const { return normales; }
+    const CoordenadaTextura* getTexturas() const { return texturas; }
+    const uint32_t* getIndices() const { return indices; }
+    const uint32_t* getIndicesTextura() const { return indicesTextura; }
+    const uint32_t* getIndicesNormales() const { return indicesNormales; }
+    std::size_t getNumVertices() const { return numVertices; }
+    std::size_t getNumNormales() const { return numNormales; }
+    std::size_t getNumTexturas() const { return numTexturas; }
+    std::size_t getNumIndices() const { return numIndices; }
+    std::size_t getNumTriangulos() const { return numIndices / 3; }
+};
+
+// usa la cache binaria del modelo si esta vigente; si no, lo carga con cargar() (que devuelve
+// una MallaIndexada y lanza std::runtime_error si no puede) y, si se pide, guarda la cache
+template <typename Cargar>
+MallaProyectada abrirConMallaBinaria(const std::string& rutaModelo, bool guardarBinaria, Cargar cargar) {
+    const std::string rutaBinaria = rutaMallaBinaria(rutaModelo);
+    if (mallaBinariaVigente(rutaBinaria, rutaModelo)) {
+        try {
+            return MallaProyectada(rutaBinaria);
+        } catch (const std::runtime_error&) {
+            // cache dañada o de otra version: se vuelve a generar
+        }
+    }
+    MallaIndexada malla = cargar();
+    if (guardarBinaria) {
+        try {
+            escribirMallaBinaria(rutaBinaria, malla);
+        } catch (const std::runtime_error&) {
+            // sin permiso de escritura junto al modelo: se sigue sin cache
+        }
+    }
+    return MallaProyectada(std::move(malla));
+}
+
+#endif // MALLABINARIA_HPP
@@ -0,0 +1,464 @@
+#include "NubePuntos.hpp"
+#include "DataLoaders/MallaBinaria.hpp"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+// proyeccion de archivos en memoria y lectura posicional (posix)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// bytes de texto que se leen de una vez (la linea mas larga admitida)
+static constexpr std::size_t BYTES_POR_LECTURA = std::size_t(1) << 20;
+
+// redondea al siguiente multiplo de la alineacion de los puntos
+static uint64_t alinear(uint64_t bytes) {
+    return (bytes + formatoIndiceNube::ALINEACION - 1) & ~static_cast<uint64_t>(formatoIndiceNube::ALINEACION - 1);
+}
+
+// analiza una linea "x y z" (from_chars no admite el signo +); false si no tiene tres
+// numeros, como una linea vacia o un comentario
+static bool leerPunto(const char* p, const char* fin, Vertice& punto) {
+    float* coordenadas[3] = {&punto.x, &punto.y, &punto.z};
+    for (float* coordenada : coordenadas) {
+        while (p < fin && (*p == ' ' || *p == '\t')) ++p;
+        if (p < fin && *p == '+') ++p;
+        const std::from_chars_result resultado = std::from_chars(p, fin, *coordenada);
+        if (resultado.ec != std::errc()) return false;
+        p = resultado.ptr;
+    }
+    return true;
+}
+
+// recorre los puntos del texto leyendo BYTES_POR_LECTURA cada vez, asi que la memoria no
+// depende del tamaño del archivo; funcion(punto) devuelve false para dejar de leer
+template <typename Funcion>
+static void recorrerTexto(const std::string& rutaModelo, Funcion funcion) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> archivo(std::fopen(rutaModelo.c_str(), "rb"), &std::fclose);
+    if (!archivo) {
+        throw std::runtime_error("No se pudo abrir la nube de puntos " + rutaModelo);
+    }
+    std::vector<char> buffer(BYTES_POR_LECTURA);
+    // bytes de una linea a medias que quedaron del bloque anterior
+    std::size_t pendientes = 0;
+    bool finArchivo = false;
+    while (!finArchivo) {
+        const std::size_t leidos = std::fread(buffer.data() + pendientes, 1, buffer.size() - pendientes, archivo.get());
+        if (leidos == 0) {
+            if (std::ferror(archivo.get())) {
+                throw std::runtime_error("Error al leer la nube de puntos " + rutaModelo);
+            }
+            finArchivo = true;
+        }
+        const char* inicio = buffer.data();
+        const char* limite = inicio + pendientes + leidos;
+        // se analiza hasta el ultimo salto de linea; al final del archivo, todo
+        const char* corte = limite;
+        if (!finArchivo) {
+            while (corte > inicio && corte[-1] != '\n') --corte;
+            if (corte == inicio && limite == inicio + buffer.size()) {
+                throw std::runtime_error("Linea demasiado larga en la nube de puntos " + rutaModelo);
+            }
+        }
+        for (const char* p = inicio; p < corte;) {
+            const char* salto = static_cast<const char*>(std::memchr(p, '\n', corte - p));
+            const char* finLinea = salto ? salto : corte;
+            Vertice punto;
+            if (leerPunto(p, finLinea, punto) && !funcion(punto)) return;
+            p = finLinea + 1;
+        }
+        pendientes = limite - corte;
+        std::memmove(buffer.data(), corte, pendientes);
+    }
+}
+
+// rejilla del indice sobre la caja de la nube
+struct RejillaNube {
+    float minimo[3];
+    float maximo[3];
+    unsigned celdas;
+
+    // posicion en un eje (los puntos fuera de la caja o no finitos van al borde)
+    uint32_t posicion(int eje, float coordenada) const {
+        const float extension = maximo[eje] - minimo[eje];
+        const float t = extension > 0.0f ? (coordenada - minimo[eje]) / extension * celdas : 0.0f;
+        if (t >= static_cast<float>(celdas)) return celdas - 1;
+        return t >= 1.0f ? static_cast<uint32_t>(t) : 0;
+    }
+    uint32_t celda(const Vertice& punto) const {
+        return (posicion(2, punto.z) * celdas + posicion(1, punto.y)) * celdas + posicion(0, punto.x);
+    }
+    // distancia al cuadrado de un punto a la caja de una celda
+    float distancia2(uint32_t celda, const Vertice& punto) const {
+        const uint32_t indices[3] = {celda % celdas, celda / celdas % celdas, celda / celdas / celdas};
+        const float coordenadas[3] = {punto.x, punto.y, punto.z};
+        float suma = 0.0f;
+        for (int eje = 0; eje < 3; ++eje) {
+            const float lado = (maximo[eje] - minimo[eje]) / celdas;
+            const float bajo = minimo[eje] + lado * indices[eje];
+            const float alto = bajo + lado;
+            const float fuera = coordenadas[eje] < bajo ? bajo - coordenadas[eje]
+                              : (coordenadas[eje] > alto ? coordenadas[eje] - alto : 0.0f);
+            suma += fuera * fuera;
+        }
+        return suma;
+    }
+};
+
+// construye el indice sin cargar la nube en memoria
+void construirIndiceNube(const std::string& rutaModelo, const std::string& rutaIndice, unsigned celdasPorEje) {
+    if (celdasPorEje == 0 || celdasPorEje > formatoIndiceNube::CELDAS_MAXIMAS) {
+        throw std::invalid_argument("Celdas por eje del indice fuera de rango");
+    }
+
+    // 1. caja de los puntos finitos y numero de puntos
+    RejillaNube rejilla;
+    rejilla.celdas = celdasPorEje;
+    for (int eje = 0; eje < 3; ++eje) {
+        rejilla.minimo[eje] = std::numeric_limits<float>::max();
+        rejilla.maximo[eje] = std::numeric_limits<float>::lowest();
+    }
+    uint64_t numPuntos = 0;
+    recorrerTexto(rutaModelo, [&](const Vertice& punto) {
+        ++numPuntos;
+        const float coordenadas[3] = {punto.x, punto.y, punto.z};
+        if (std::isfinite(coordenadas[0]) && std::isfinite(coordenadas[1]) && std::isfinite(coordenadas[2])) {
+            for (int eje = 0; eje < 3; ++eje) {
+                rejilla.minimo[eje] = std::min(rejilla.minimo[eje], coordenadas[eje]);
+                rejilla.maximo[eje] = std::max(rejilla.maximo[eje], coordenadas[eje]);
+            }
+        }
+        return true;
+    });
+    if (rejilla.minimo[0] > rejilla.maximo[0]) {
+        // sin puntos finitos: caja vacia en el origen
+        std::fill(rejilla.minimo, rejilla.minimo + 3, 0.0f);
+        std::fill(rejilla.maximo, rejilla.maximo + 3, 0.0f);
+    }
+
+    // 2. puntos por celda y tabla de posiciones
+    const uint32_t numCeldas = celdasPorEje * celdasPorEje * celdasPorEje;
+    std::vector<uint64_t> tabla(numCeldas + 1, 0);
+    recorrerTexto(rutaModelo, [&](const Vertice& punto) {
+        ++tabla[rejilla.celda(punto) + 1];
+        return true;
+    });
+    for (uint32_t celda = 0; celda < numCeldas; ++celda) tabla[celda + 1] += tabla[celda];
+    if (tabla.back() != numPuntos) {
+        throw std::runtime_error("La nube de puntos cambio mientras se indexaba: " + rutaModelo);
+    }
+
+    // 3. reparto de los puntos en el archivo proyectado (la memoria la gestiona el sistema)
+    const uint64_t inicioPuntos = alinear(formatoIndiceNube::TAMANO_CABECERA + tabla.size() * sizeof(uint64_t));
+    const uint64_t tamano = inicioPuntos + numPuntos * sizeof(Vertice);
+    const std::string temporal = rutaIndice + ".tmp";
+    const int descriptor = ::open(temporal.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo crear el indice " + rutaIndice);
+    }
+    void* proyeccion = MAP_FAILED;
+    if (::ftruncate(descriptor, static_cast<off_t>(tamano)) == 0) {
+        proyeccion = ::mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    if (proyeccion == MAP_FAILED) {
+        ::close(descriptor);
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo crear el indice " + rutaIndice);
+    }
+    unsigned char* datos = static_cast<unsigned char*>(proyeccion);
+    bool cambio = false;
+    try {
+        const uint16_t celdas16 = static_cast<uint16_t>(celdasPorEje);
+        std::memcpy(datos, formatoIndiceNube::MAGIA, sizeof(formatoIndiceNube::MAGIA));
+        std::memcpy(datos + 4, &formatoIndiceNube::VERSION, sizeof(formatoIndiceNube::VERSION));
+        std::memcpy(datos + 6, &celdas16, sizeof(celdas16));
+        std::memcpy(datos + 8, &numPuntos, sizeof(numPuntos));
+        std::memcpy(datos + 16, rejilla.minimo, sizeof(rejilla.minimo));
+        std::memcpy(datos + 28, rejilla.maximo, sizeof(rejilla.maximo));
+        std::memcpy(datos + formatoIndiceNube::TAMANO_CABECERA, tabla.data(), tabla.size() * sizeof(uint64_t));
+        std::vector<uint64_t> cursores(tabla.begin(), tabla.end() - 1);
+        Vertice* puntos = reinterpret_cast<Vertice*>(datos + inicioPuntos);
+        recorrerTexto(rutaModelo, [&](const Vertice& punto) {
+            const uint32_t celda = rejilla.celda(punto);
+            if (cursores[celda] == tabla[celda + 1]) {
+                cambio = true;
+                return false;
+            }
+            puntos[cursores[celda]++] = punto;
+            return true;
+        });
+    } catch (...) {
+        ::munmap(proyeccion, tamano);
+        ::close(descriptor);
+        std::remove(temporal.c_str());
+        throw;
+    }
+    const bool escrito = ::munmap(proyeccion, tamano) == 0 && ::close(descriptor) == 0;
+    if (cambio || !escrito) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error(cambio ? "La nube de puntos cambio mientras se indexaba: " + rutaModelo
+                                        : "Error al escribir el indice " + rutaIndice);
+    }
+    if (std::rename(temporal.c_str(), rutaIndice.c_str()) != 0) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo crear el indice " + rutaIndice);
+    }
+}
+
+// ruta del indice espacial de una nube de texto
+std::string rutaIndiceNube(const std::string& rutaModelo) {
+    return rutaModelo + formatoIndiceNube::EXTENSION;
+}
+
+// lee bytes en una posicion del archivo (pread puede devolver menos de lo pedido)
+static void leerEn(int descriptor, uint64_t posicion, void* destino, std::size_t bytes) {
+    unsigned char* cursor = static_cast<unsigned char*>(destino);
+    while (bytes > 0) {
+        const ssize_t leidos = ::pread(descriptor, cursor, bytes, static_cast<off_t>(posicion));
+        if (leidos <= 0) {
+            throw std::runtime_error("Error al leer el indice de la nube de puntos");
+        }
+        cursor += leidos;
+        posicion += static_cast<uint64_t>(leidos);
+        bytes -= static_cast<std::size_t>(leidos);
+    }
+}
+
+// indice abierto: cabecera y tabla en memoria; los puntos se leen del archivo por celdas
+struct IndiceAbierto {
+    int descriptor = -1;
+    RejillaNube rejilla;
+    uint64_t inicioPuntos = 0;
+    std::vector<uint64_t> tabla;
+
+    ~IndiceAbierto() { cerrar(); }
+    void cerrar() {
+        if (descriptor >= 0) ::close(descriptor);
+        descriptor = -1;
+    }
+
+    // abre y valida la cabecera, la tabla y el tamaño; lanza std::runtime_error si no es valido
+    void abrir(const std::string& rutaIndice) {
+        cerrar();
+        descriptor = ::open(rutaIndice.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("No se pudo abrir el indice " + rutaIndice);
+        }
+        unsigned char cabecera[formatoIndiceNube::TAMANO_CABECERA];
+        const off_t tamano = ::lseek(descriptor, 0, SEEK_END);
+        if (tamano < static_cast<off_t>(sizeof(cabecera))) {
+            throw std::runtime_error("Indice sin cabecera: " + rutaIndice);
+        }
+        leerEn(descriptor, 0, cabecera, sizeof(cabecera));
+        uint16_t version, celdas;
+        uint64_t numPuntos;
+        std::memcpy(&version, cabecera + 4, sizeof(version));
+        std::memcpy(&celdas, cabecera + 6, sizeof(celdas));
+        std::memcpy(&numPuntos, cabecera + 8, sizeof(numPuntos));
+        std::memcpy(rejilla.minimo, cabecera + 16, sizeof(rejilla.minimo));
+        std::memcpy(rejilla.maximo, cabecera + 28, sizeof(rejilla.maximo));
+        rejilla.celdas = celdas;
+        if (std::memcmp(cabecera, formatoIndiceNube::MAGIA, sizeof(formatoIndiceNube::MAGIA)) != 0 ||
+            version != formatoIndiceNube::VERSION || celdas == 0 || celdas > formatoIndiceNube::CELDAS_MAXIMAS) {
+            throw std::runtime_error("Indice con formato no valido: " + rutaIndice);
+        }
+        tabla.resize(std::size_t(celdas) * celdas * celdas + 1);
+        inicioPuntos = alinear(formatoIndiceNube::TAMANO_CABECERA + tabla.size() * sizeof(uint64_t));
+        if (numPuntos > (std::numeric_limits<uint64_t>::max() - inicioPuntos) / sizeof(Vertice) ||
+            static_cast<uint64_t>(tamano) != inicioPuntos + numPuntos * sizeof(Vertice)) {
+            throw std::runtime_error("Indice con tamaño no valido: " + rutaIndice);
+        }
+        leerEn(descriptor, formatoIndiceNube::TAMANO_CABECERA, tabla.data(), tabla.size() * sizeof(uint64_t));
+        if (tabla.front() != 0 || tabla.back() != numPuntos ||
+            !std::is_sorted(tabla.begin(), tabla.end())) {
+            throw std::runtime_error("Indice con tabla no valida: " + rutaIndice);
+        }
+    }
+};
+
+// comprueba la configuracion y arranca el hilo
+CargadorNubePuntos::CargadorNubePuntos(const std::string& rutaModelo, const ConfiguracionNube& configuracion) :
+    rutaModelo(rutaModelo), configuracion(configuracion), cola(configuracion.bloquesEnCola),
+    foco(configuracion.foco), generacionPedida(1), generacionServida(0),
+    parar(false), puntosEnviados(0), fallo(false) {
+
+    if (configuracion.puntosPorBloque == 0) {
+        throw std::invalid_argument("Los bloques de la nube necesitan al menos un punto");
+    }
+    if (configuracion.usarIndice &&
+        (configuracion.celdasPorEje == 0 || configuracion.celdasPorEje > formatoIndiceNube::CELDAS_MAXIMAS ||
+         !(configuracion.radio >= 0.0f))) {
+        throw std::invalid_argument("Configuracion del indice de la nube no valida");
+    }
+    // sin el texto basta con que exista el indice
+    if (::access(rutaModelo.c_str(), R_OK) != 0 &&
+        !(configuracion.usarIndice && ::access(rutaIndiceNube(rutaModelo).c_str(), R_OK) == 0)) {
+        throw std::runtime_error("No se pudo abrir la nube de puntos " + rutaModelo);
+    }
+    hilo = std::thread(&CargadorNubePuntos::trabajar, this);
+}
+
+// para el hilo (si espera hueco en la cola, lo deja en cuanto lo ve)
+CargadorNubePuntos::~CargadorNubePuntos() {
+    parar.store(true, std::memory_order_relaxed);
+    if (hilo.joinable()) hilo.join();
+}
+
+// cuerpo del hilo: con indice si se pide y se puede, si no el texto en orden
+void CargadorNubePuntos::trabajar() {
+    try {
+        if (!configuracion.usarIndice || !servirIndice()) {
+            leerEnOrden();
+        }
+    } catch (...) {
+        error = std::current_exception();
+        fallo.store(true, std::memory_order_release);
+    }
+}
+
+// espera hueco en la cola
+bool CargadorNubePuntos::entregar(BloquePuntos&& bloque) {
+    const std::size_t cantidad = bloque.puntos.size();
+    while (!cola.intentarMeter(std::move(bloque))) {
+        if (parar.load(std::memory_order_relaxed)) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    puntosEnviados.fetch_add(cantidad, std::memory_order_relaxed);
+    return true;
+}
+
+// lee todo el texto en orden
+void CargadorNubePuntos::leerEnOrden() {
+    const std::size_t puntosPorBloque = configuracion.puntosPorBloque;
+    BloquePuntos bloque;
+    bloque.puntos.reserve(puntosPorBloque);
+    bool seguir = true;
+    recorrerTexto(rutaModelo, [&](const Vertice& punto) {
+        bloque.puntos.push_back(punto);
+        if (bloque.puntos.size() < puntosPorBloque) return true;
+        seguir = entregar(std::move(bloque));
+        bloque = BloquePuntos();
+        bloque.puntos.reserve(puntosPorBloque);
+        return seguir;
+    });
+    if (seguir && !bloque.puntos.empty()) {
+        seguir = entregar(std::move(bloque));
+    }
+    // sin indice el foco no cambia nada: cualquier generacion queda servida
+    if (seguir) generacionServida.store(std::numeric_limits<uint64_t>::max(), std::memory_order_release);
+}
+
+// sirve las celdas del indice segun el foco
+bool CargadorNubePuntos::servirIndice() {
+    const std::string rutaIndice = rutaIndiceNube(rutaModelo);
+    IndiceAbierto indice;
+    // misma regla que la cache de mallas: vale si no es mas antiguo que el texto
+    bool abierto = false;
+    if (mallaBinariaVigente(rutaIndice, rutaModelo)) {
+        try {
+            indice.abrir(rutaIndice);
+            abierto = indice.rejilla.celdas == configuracion.celdasPorEje;
+        } catch (const std::runtime_error&) {
+            // indice dañado o de otra version: se vuelve a construir
+        }
+    }
+    if (!abierto) {
+        try {
+            construirIndiceNube(rutaModelo, rutaIndice, configuracion.celdasPorEje);
+            indice.abrir(rutaIndice);
+        } catch (const std::runtime_error&) {
+            // sin permiso de escritura junto a la nube: se lee el texto en orden
+            return false;
+        }
+    }
+
+    const uint32_t numCeldas = static_cast<uint32_t>(indice.tabla.size() - 1);
+    const float radio2 = configuracion.radio * configuracion.radio;
+    // celdas que tiene el visor y celdas por enviar, de la mas lejana a la mas cercana
+    std::vector<char> enviada(numCeldas, 0);
+    std::vector<uint32_t> pendientes;
+    std::vector<std::pair<float, uint32_t>> cercanas;
+    uint64_t generacion = 0;
+    while (!parar.load(std::memory_order_relaxed)) {
+        const uint64_t pedida = generacionPedida.load(std::memory_order_acquire);
+        if (pedida != generacion) {
+            generacion = pedida;
+            Vertice centro;
+            {
+                std::lock_guard<std::mutex> bloqueo(cerrojoFoco);
+                centro = foco;
+            }
+            // primero los descartes, para que lo residente no crezca al moverse
+            cercanas.clear();
+            for (uint32_t celda = 0; celda < numCeldas; ++celda) {
+                if (indice.tabla[celda] == indice.tabla[celda + 1]) continue;
+                if (indice.rejilla.distancia2(celda, centro) <= radio2) {
+                    if (!enviada[celda]) cercanas.emplace_back(indice.rejilla.distancia2(celda, centro), celda);
+                } else if (enviada[celda]) {
+                    BloquePuntos aviso;
+                    aviso.celda = celda;
+                    aviso.descartar = true;
+                    if (!entregar(std::move(aviso))) return true;
+                    enviada[celda] = 0;
+                }
+            }
+            std::sort(cercanas.begin(), cercanas.end(), std::greater<std::pair<float, uint32_t>>());
+            pendientes.clear();
+            for (const auto& cercana : cercanas) pendientes.push_back(cercana.second);
+        }
+        if (pendientes.empty()) {
+            generacionServida.store(generacion, std::memory_order_release);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+        const uint32_t celda = pendientes.back();
+        pendientes.pop_back();
+        const uint64_t fin = indice.tabla[celda + 1];
+        for (uint64_t inicio = indice.tabla[celda]; inicio < fin; inicio += configuracion.puntosPorBloque) {
+            BloquePuntos bloque;
+            bloque.celda = celda;
+            bloque.puntos.resize(static_cast<std::size_t>(std::min<uint64_t>(configuracion.puntosPorBloque, fin - inicio)));
+            leerEn(indice.descriptor, indice.inicioPuntos + inicio * sizeof(Vertice),
+                   bloque.puntos.data(), bloque.puntos.size() * sizeof(Vertice));
+            if (!entregar(std::move(bloque))) return true;
+        }
+        enviada[celda] = 1;
+    }
+    return true;
+}
+
+// saca el siguiente bloque listo sin esperar
+bool CargadorNubePuntos::siguienteBloque(BloquePuntos& bloque) {
+    if (cola.intentarSacar(bloque)) return true;
+    if (fallo.load(std::memory_order_acquire)) {
+        // el hilo pudo dejar un ultimo bloque justo antes de fallar
+        if (cola.intentarSacar(bloque)) return true;
+        std::rethrow_exception(error);
+    }
+    return false;
+}
+
+// mueve el foco
+void CargadorNubePuntos::enfocar(float x, float y, float z) {
+    if (!configuracion.usarIndice) return;
+    {
+        std::lock_guard<std::mutex> bloqueo(cerrojoFoco);
+        if (foco.x == x && foco.y == y && foco.z == z) return;
+        foco = Vertice{x, y, z};
+    }
+    generacionPedida.fetch_add(1, std::memory_order_release);
+}
+
+// nada pendiente en el hilo ni en la cola
+bool CargadorNubePuntos::estaAlDia() const {
+    const uint64_t servida = generacionServida.load(std::memory_order_acquire);
+    return servida >= generacionPedida.load(std::memory_order_acquire) && cola.estaVacia();
+}
@@ -0,0 +1,130 @@
+#ifndef NUBEPUNTOS_HPP
+#define NUBEPUNTOS_HPP
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include "Common/Vertice.hpp"
+#include "Common/ColaSinBloqueo.hpp"
+
+// indice espacial de una nube de puntos de texto ("x y z" por linea), little-endian:
+//   cabecera de 64 bytes
+//     0  magia "CPIX"
+//     4  version (uint16, actualmente 1)
+//     6  celdas por eje (uint16)
+//     8  numero de puntos (uint64)
+//     16 esquina minima de la caja (3 float)
+//     28 esquina maxima de la caja (3 float)
+//     40 reservado (ceros)
+//   tabla de celdas^3 + 1 posiciones (uint64, en puntos): la celda c ocupa [tabla[c], tabla[c + 1])
+//   puntos (3 float) ordenados por celda, alineados a 64 bytes; celda = (iz * celdas + iy) * celdas + ix
+namespace formatoIndiceNube {
+    constexpr char MAGIA[4] = {'C', 'P', 'I', 'X'};
+    constexpr uint16_t VERSION = 1;
+    constexpr std::size_t TAMANO_CABECERA = 64;
+    constexpr std::size_t ALINEACION = 64;
+    constexpr unsigned CELDAS_POR_DEFECTO = 16;
+    constexpr unsigned CELDAS_MAXIMAS = 128;
+    // extension que se añade a la ruta de la nube de texto
+    constexpr const char* EXTENSION = ".cpix";
+}
+
+// construye el indice sin cargar la nube en memoria: tres pasadas por bloques sobre el texto
+// (caja, puntos por celda y reparto) y los puntos se colocan en el archivo proyectado; se escribe
+// en un temporal que luego se renombra
+// lanza std::invalid_argument si celdasPorEje no esta en [1, CELDAS_MAXIMAS] y
+// std::runtime_error si no se puede leer la nube o escribir el indice
+void construirIndiceNube(const std::string& rutaModelo, const std::string& rutaIndice,
+                         unsigned celdasPorEje = formatoIndiceNube::CELDAS_POR_DEFECTO);
+
+// ruta del indice espacial de una nube de texto
+std::string rutaIndiceNube(const std::string& rutaModelo);
+
+// tramo de puntos que el cargador entrega al visor
+struct BloquePuntos {
+    static constexpr uint32_t SIN_CELDA = UINT32_MAX;
+    std::vector<Vertice> puntos;
+    // celda del indice de la que vienen (SIN_CELDA al leer el texto en orden)
+    uint32_t celda = SIN_CELDA;
+    // aviso sin puntos: el foco se ha alejado y el visor debe soltar los bloques de la celda
+    bool descartar = false;
+};
+
+struct ConfiguracionNube {
+    // puntos por bloque entregado
+    std::size_t puntosPorBloque = std::size_t(1) << 16;
+    // bloques listos que puede haber en la cola; con el visor parado el hilo espera, asi que la
+    // memoria en vuelo no pasa de puntosPorBloque * bloquesEnCola puntos
+    std::size_t bloquesEnCola = 16;
+    // usa el indice espacial (ruta + ".cpix", se crea o renueva si hace falta) y solo entrega
+    // las celdas a menos de radio del foco, de la mas cercana a la mas lejana
+    bool usarIndice = false;
+    unsigned celdasPorEje = formatoIndiceNube::CELDAS_POR_DEFECTO;
+    float radio = 10.0f;
+    // foco inicial (enfocar lo mueve)
+    Vertice foco = {0.0f, 0.0f, 0.0f};
+};
+
+// carga una nube de puntos de texto en segundo plano: un hilo analiza el archivo por bloques de
+// tamaño acotado y los pasa al visor por una cola sin cerrojos, de modo que el primer bloque se
+// puede dibujar enseguida mientras llega el resto
+// con indice, lo residente son las celdas cercanas al foco: al mover el foco el hilo manda los
+// avisos de descarte de las celdas que quedan lejos y despues las celdas nuevas
+class CargadorNubePuntos {
+private:
+    const std::string rutaModelo;
+    const ConfiguracionNube configuracion;
+    ColaSinBloqueo<BloquePuntos> cola;
+
+    // foco pedido por el visor; cada cambio sube la generacion pedida y el hilo publica la
+    // ultima generacion que ha servido entera
+    std::mutex cerrojoFoco;
+    Vertice foco;
+    std::atomic<uint64_t> generacionPedida;
+    std::atomic<uint64_t> generacionServida;
+
+    std::atomic<bool> parar;
+    std::atomic<uint64_t> puntosEnviados;
+    // error del hilo, que se relanza en el hilo del visor
+    std::atomic<bool> fallo;
+    std::exception_ptr error;
+    std::thread hilo;
+
+    // cuerpo del hilo
+    void trabajar();
+    // lee todo el texto en orden
+    void leerEnOrden();
+    // sirve las celdas del indice segun el foco; false si no hay indice utilizable
+    bool servirIndice();
+    // espera hueco en la cola; false si hay que parar
+    bool entregar(BloquePuntos&& bloque);
+
+public:
+    // lanza std::invalid_argument si la configuracion no es valida y std::runtime_error si no
+    // se puede abrir el archivo
+    explicit CargadorNubePuntos(const std::string& rutaModelo,
+                                const ConfiguracionNube& configuracion = ConfiguracionNube());
+    ~CargadorNubePuntos();
+    CargadorNubePuntos(const CargadorNubePuntos&) = delete;
+    CargadorNubePuntos& operator=(const CargadorNubePuntos&) = delete;
+
+    // saca el siguiente bloque listo sin esperar; false si de momento no hay ninguno
+    // relanza el error del hilo (std::runtime_error) una vez entregado lo que ya estaba listo
+    bool siguienteBloque(BloquePuntos& bloque);
+    // mueve el foco (solo tiene efecto con indice)
+    void enfocar(float x, float y, float z);
+    // true cuando el hilo no tiene nada pendiente (todo el archivo o todas las celdas del foco
+    // actual) y ya se han sacado todos los bloques
+    bool estaAlDia() const;
+
+    // metodos de consulta
+    uint64_t getPuntosEnviados() const { return puntosEnviados.load(std::memory_order_relaxed); }
+    const ConfiguracionNube& getConfiguracion() const { return configuracion; }
+};
+
+#endif // NUBEPUNTOS_HPP
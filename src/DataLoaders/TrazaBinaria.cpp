@@ -0,0 +1,198 @@
+#include "TrazaBinaria.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+// proyeccion de archivos en memoria (posix)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// lee un entero little-endian de 'ancho' bytes (el anfitrion es little-endian)
+static uint64_t leerEntero(const unsigned char* origen, std::size_t ancho) {
+    uint64_t valor = 0;
+    std::memcpy(&valor, origen, ancho);
+    return valor;
+}
+
+// abre el archivo, lo proyecta y valida la cabecera
+LectorTrazaBinaria::LectorTrazaBinaria(const std::string& rutaArchivo) :
+    descriptor(-1), datos(nullptr), tamanoArchivo(0), anchoDireccion(0), banderas(0),
+    numRegistros(0), tamanoRegistro(0), siguiente(0), inicioResidente(0) {
+
+    descriptor = ::open(rutaArchivo.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("No se pudo abrir la traza " + rutaArchivo);
+    }
+    struct stat informacion;
+    if (::fstat(descriptor, &informacion) != 0 ||
+        static_cast<std::size_t>(informacion.st_size) < formatoTraza::TAMANO_CABECERA) {
+        cerrar();
+        throw std::runtime_error("Traza sin cabecera: " + rutaArchivo);
+    }
+    tamanoArchivo = static_cast<std::size_t>(informacion.st_size);
+
+    void* proyeccion = ::mmap(nullptr, tamanoArchivo, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (proyeccion == MAP_FAILED) {
+        cerrar();
+        throw std::runtime_error("No se pudo proyectar la traza " + rutaArchivo);
+    }
+    datos = static_cast<const unsigned char*>(proyeccion);
+    // la traza se recorre una vez de principio a fin
+    ::madvise(proyeccion, tamanoArchivo, MADV_SEQUENTIAL);
+
+    // valida la cabecera
+    uint16_t version = 0;
+    std::memcpy(&version, datos + 4, sizeof(version));
+    anchoDireccion = datos[6];
+    banderas = datos[7];
+    std::memcpy(&numRegistros, datos + 8, sizeof(numRegistros));
+    if (std::memcmp(datos, formatoTraza::MAGIA, sizeof(formatoTraza::MAGIA)) != 0 ||
+        version != formatoTraza::VERSION) {
+        cerrar();
+        throw std::runtime_error("Formato de traza no reconocido: " + rutaArchivo);
+    }
+    if (anchoDireccion != 4 && anchoDireccion != 8) {
+        cerrar();
+        throw std::runtime_error("Ancho de direccion no soportado en " + rutaArchivo);
+    }
+    tamanoRegistro = anchoDireccion + (tieneTipos() ? 1 : 0) + (tienePC() ? anchoDireccion : 0);
+
+    // el numero de registros debe cuadrar con el tamaño del archivo
+    if ((tamanoArchivo - formatoTraza::TAMANO_CABECERA) / tamanoRegistro != numRegistros ||
+        (tamanoArchivo - formatoTraza::TAMANO_CABECERA) % tamanoRegistro != 0) {
+        cerrar();
+        throw std::runtime_error("Traza truncada o cabecera incompleta: " + rutaArchivo);
+    }
+    inicioResidente = 0;
+}
+
+LectorTrazaBinaria::~LectorTrazaBinaria() {
+    cerrar();
+}
+
+// libera la proyeccion y el descriptor
+void LectorTrazaBinaria::cerrar() {
+    if (datos != nullptr) {
+        ::munmap(const_cast<unsigned char*>(datos), tamanoArchivo);
+        datos = nullptr;
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+}
+
+// decodifica el siguiente tramo de registros
+bool LectorTrazaBinaria::siguienteTramo(TramoTraza& tramo, std::size_t maxRegistros) {
+    const std::size_t n = static_cast<std::size_t>(
+        std::min<uint64_t>(maxRegistros, numRegistros - siguiente));
+    tramo.direcciones.resize(n);
+    tramo.tipos.resize(tieneTipos() ? n : 0);
+    tramo.pcs.resize(tienePC() ? n : 0);
+    if (n == 0) return false;
+
+    const std::size_t desplazamiento = formatoTraza::TAMANO_CABECERA + siguiente * tamanoRegistro;
+    const unsigned char* registro = datos + desplazamiento;
+    if (banderas == 0 && anchoDireccion == 4) {
+        // caso mas comun: solo direcciones de 32 bits
+        for (std::size_t i = 0; i < n; ++i, registro += 4) {
+            tramo.direcciones[i] = leerEntero(registro, 4);
+        }
+    } else if (banderas == 0) {
+        // solo direcciones de 64 bits
+        for (std::size_t i = 0; i < n; ++i, registro += 8) {
+            tramo.direcciones[i] = leerEntero(registro, 8);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i, registro += tamanoRegistro) {
+            const unsigned char* campo = registro;
+            tramo.direcciones[i] = leerEntero(campo, anchoDireccion);
+            campo += anchoDireccion;
+            if (tieneTipos()) {
+                tramo.tipos[i] = static_cast<TipoAcceso>(*campo);
+                campo += 1;
+            }
+            if (tienePC()) {
+                tramo.pcs[i] = leerEntero(campo, anchoDireccion);
+            }
+        }
+    }
+    siguiente += n;
+
+    // devuelve al sistema las paginas completas ya consumidas
+    const std::size_t pagina = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t finConsumido = (desplazamiento + n * tamanoRegistro) / pagina * pagina;
+    if (finConsumido > inicioResidente) {
+        ::madvise(const_cast<unsigned char*>(datos) + inicioResidente, finConsumido - inicioResidente,
+                  MADV_DONTNEED);
+        inicioResidente = finConsumido;
+    }
+    return true;
+}
+
+// crea el archivo y escribe una cabecera provisional
+EscritorTrazaBinaria::EscritorTrazaBinaria(const std::string& rutaArchivo, int anchoDireccion,
+                                           bool conTipos, bool conPC) :
+    anchoDireccion(static_cast<uint8_t>(anchoDireccion)),
+    banderas(static_cast<uint8_t>((conTipos ? formatoTraza::CON_TIPO : 0) |
+                                  (conPC ? formatoTraza::CON_PC : 0))),
+    numRegistros(0) {
+
+    if (anchoDireccion != 4 && anchoDireccion != 8) {
+        throw std::invalid_argument("Ancho de direccion debe ser 4 u 8 bytes");
+    }
+    archivo.open(rutaArchivo, std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) {
+        throw std::runtime_error("No se pudo crear la traza " + rutaArchivo);
+    }
+
+    // cabecera con numero de registros 0 hasta cerrar
+    unsigned char cabecera[formatoTraza::TAMANO_CABECERA] = {};
+    std::memcpy(cabecera, formatoTraza::MAGIA, sizeof(formatoTraza::MAGIA));
+    std::memcpy(cabecera + 4, &formatoTraza::VERSION, sizeof(formatoTraza::VERSION));
+    cabecera[6] = this->anchoDireccion;
+    cabecera[7] = banderas;
+    archivo.write(reinterpret_cast<const char*>(cabecera), sizeof(cabecera));
+}
+
+EscritorTrazaBinaria::~EscritorTrazaBinaria() {
+    // un destructor no debe lanzar: los errores de cierre se pierden aqui
+    try {
+        cerrar();
+    } catch (...) {
+    }
+}
+
+// añade un registro empaquetado
+void EscritorTrazaBinaria::escribir(uint64_t direccion, TipoAcceso tipo, uint64_t pc) {
+    // una traza de 32 bits no puede guardar direcciones mas altas sin perderlas
+    const bool pcAlto = (banderas & formatoTraza::CON_PC) != 0 && pc > UINT32_MAX;
+    if (anchoDireccion == 4 && (direccion > UINT32_MAX || pcAlto)) {
+        throw std::invalid_argument("Dirección no cabe en una traza de 32 bits");
+    }
+    unsigned char registro[17];
+    std::size_t longitud = 0;
+    std::memcpy(registro, &direccion, anchoDireccion);
+    longitud += anchoDireccion;
+    if (banderas & formatoTraza::CON_TIPO) {
+        registro[longitud++] = static_cast<unsigned char>(tipo);
+    }
+    if (banderas & formatoTraza::CON_PC) {
+        std::memcpy(registro + longitud, &pc, anchoDireccion);
+        longitud += anchoDireccion;
+    }
+    archivo.write(reinterpret_cast<const char*>(registro), static_cast<std::streamsize>(longitud));
+    ++numRegistros;
+}
+
+// completa la cabecera con el numero de registros
+void EscritorTrazaBinaria::cerrar() {
+    if (!archivo.is_open()) return;
+    archivo.seekp(8);
+    archivo.write(reinterpret_cast<const char*>(&numRegistros), sizeof(numRegistros));
+    archivo.close();
+    if (archivo.fail()) {
+        throw std::runtime_error("Error al escribir la traza");
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef TRAZABINARIA_HPP
+#define TRAZABINARIA_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include "Common/TipoAcceso.hpp"
+
+// formato binario de traza (little-endian):
+//   cabecera de 32 bytes
+//     0  magia "CTRZ"
+//     4  version (uint16, actualmente 1)
+//     6  ancho de direccion en bytes (uint8, 4 u 8)
+//     7  banderas (uint8, bit 0 = tipo de acceso, bit 1 = pc)
+//     8  numero de registros (uint64)
+//     16 reservado (ceros)
+//   registros empaquetados: direccion [ancho], tipo [1 byte si bit 0], pc [ancho si bit 1]
+namespace formatoTraza {
+    constexpr char MAGIA[4] = {'C', 'T', 'R', 'Z'};
+    constexpr uint16_t VERSION = 1;
+    constexpr std::size_t TAMANO_CABECERA = 32;
+    constexpr uint8_t CON_TIPO = 1u << 0;
+    constexpr uint8_t CON_PC = 1u << 1;
+}
+
+// bloque de registros decodificados, reutilizado entre lecturas
+struct TramoTraza {
+    // direcciones de los accesos
+    std::vector<uint64_t> direcciones;
+    // tipo de cada acceso (vacio si la traza no lo registra)
+    std::vector<TipoAcceso> tipos;
+    // contador de programa de cada acceso (vacio si la traza no lo registra)
+    std::vector<uint64_t> pcs;
+};
+
+// lector en flujo de una traza binaria proyectada en memoria (mmap)
+// solo decodifica un tramo cada vez y libera las paginas ya consumidas,
+// de modo que la memoria usada no depende del tamaño del archivo
+class LectorTrazaBinaria {
+private:
+    // descriptor del archivo abierto
+    int descriptor;
+    // proyeccion del archivo completo
+    const unsigned char* datos;
+    // tamaño del archivo en bytes
+    std::size_t tamanoArchivo;
+    // campos de la cabecera
+    uint8_t anchoDireccion;
+    uint8_t banderas;
+    uint64_t numRegistros;
+    // bytes por registro
+    std::size_t tamanoRegistro;
+    // siguiente registro por leer
+    uint64_t siguiente;
+    // primer byte que aun no se ha devuelto al sistema
+    std::size_t inicioResidente;
+
+    // libera la proyeccion y el descriptor
+    void cerrar();
+
+public:
+    // registros que se decodifican por tramo si no se indica otra cosa
+    static constexpr std::size_t REGISTROS_POR_TRAMO = std::size_t(1) << 16;
+
+    // abre y valida la traza; lanza std::runtime_error si no es valida
+    explicit LectorTrazaBinaria(const std::string& rutaArchivo);
+    ~LectorTrazaBinaria();
+    LectorTrazaBinaria(const LectorTrazaBinaria&) = delete;
+    LectorTrazaBinaria& operator=(const LectorTrazaBinaria&) = delete;
+
+    // decodifica hasta maxRegistros en tramo, devuelve false al llegar al final
+    bool siguienteTramo(TramoTraza& tramo, std::size_t maxRegistros = REGISTROS_POR_TRAMO);
+    // vuelve al primer registro; las paginas de la nueva pasada se vuelven a liberar desde el principio
+    void reiniciar() {
+        siguiente = 0;
+        inicioResidente = 0;
+    }
+
+    // metodos de consulta
+    uint64_t getNumRegistros() const { return numRegistros; }
+    int getAnchoDireccion() const { return anchoDireccion; }
+    bool tieneTipos() const { return (banderas & formatoTraza::CON_TIPO) != 0; }
+    bool tienePC() const { return (banderas & formatoTraza::CON_PC) != 0; }
+};
+
+// escritor de trazas binarias con buffer
+class EscritorTrazaBinaria {
+private:
+    std::ofstream archivo;
+    uint8_t anchoDireccion;
+    uint8_t banderas;
+    uint64_t numRegistros;
+
+public:
+    // crea el archivo; lanza std::invalid_argument o std::runtime_error
+    EscritorTrazaBinaria(const std::string& rutaArchivo, int anchoDireccion = 4,
+                         bool conTipos = false, bool conPC = false);
+    // completa la cabecera si no se llamo a cerrar
+    ~EscritorTrazaBinaria();
+
+    // añade un registro (tipo y pc se ignoran si la traza no los registra)
+    // lanza std::invalid_argument si la direccion o el pc no caben en el ancho de la traza
+    void escribir(uint64_t direccion, TipoAcceso tipo = TipoAcceso::LECTURA, uint64_t pc = 0);
+    // escribe el numero de registros en la cabecera y cierra el archivo
+    void cerrar();
+
+    // registros escritos hasta ahora
+    uint64_t getNumRegistros() const { return numRegistros; }
+};
+
+#endif // TRAZABINARIA_HPP
@@ -4,6 +4,9 @@
 // Inclusión del manejador de entradas de usuario
 #include "Graficos/InputHandler.hpp"
 
+// Transformación de vértices al espacio de la cámara
+#include "Graficos/Proyeccion.hpp"
+
 // Librería para operaciones matemáticas (sin, cos, etc.)
 #include <cmath>
 
@@ -108,26 +111,6 @@ void CameraController::actualizar(Camara& camara, const EstadoEntrada& entrada,
 
 // Función que transforma un vértice al espacio de la cámara
 void CameraController::transformarVertice(Vertice& v, const Camara& cam) {
-    // Calcula la posición relativa del vértice respecto a la cámara
-    float dx = v.x - cam.x;
-    float dy = v.y - cam.y;
-    float dz = v.z - cam.z;
-
-    // Precalcula componentes para rotación horizontal
-    float cosY = cos(cam.rotY), sinY = sin(cam.rotY);
-    // Aplica rotación horizontal al eje X
-    float x1 = dx * cosY + dz * sinY;
-    // Aplica rotación horizontal al eje Z
-    float z1 = -dx * sinY + dz * cosY;
-
-    // Limita y prepara la rotación vertical
-    float rotX = std::clamp(cam.rotX, -1.48f, 1.48f);
-    // Precalcula componentes para rotación vertical
-    float cosX = cos(rotX), sinX = sin(rotX);
-    // Aplica rotación vertical al eje Y
-    v.y = dy * cosX - z1 * sinX;
-    // Aplica rotación vertical al eje Z
-    v.z = dy * sinX + z1 * cosX;
-    // Asigna la nueva posición X transformada
-    v.x = x1;
-}
\ No newline at end of file
+    // la transformación vive en Proyeccion, sin dependencias de SFML
+    Proyeccion::transformarVertice(v, cam);
+}
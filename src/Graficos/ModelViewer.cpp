@@ -28,18 +28,29 @@
 // incluye módulos de ventana de SFML
 #include <SFML/Window.hpp>
 
-// función principal para visualización del modelo
-void ModelViewer::visualizar(const std::vector<Vertice>& vertices, 
-                           const Cache& cache,
-                           double tiempoSimulacion, 
-                           bool modoGrafico, 
-                           const sf::Font& fuente,
-                           sf::RenderWindow& ventana) {
-    // si no está en modo gráfico, termina la función
-    if (!modoGrafico) {
-        return;
-    }
-
+// incluye el cargador de nubes de puntos en segundo plano
+#include "../DataLoaders/NubePuntos.hpp"
+
+// bloques de la nube que se recogen como mucho en cada frame
+static const int BLOQUES_POR_FRAME = 4;
+
+// posiciones que ocupan en la nube dibujada los puntos llegados de una celda
+struct TramoNube {
+    uint32_t celda;
+    size_t inicio;
+    size_t cantidad;
+};
+
+// bucle común de los visores: ventana, entrada, cámara e interfaz;
+// modelo(camara) devuelve los vértices a dibujar en cada frame
+template <typename Modelo>
+static void ejecutarVisor(const Cache& cache,
+                          double tiempoSimulacion,
+                          size_t cantidadVertices,
+                          const std::vector<std::pair<int, int>>& conexiones,
+                          const sf::Font& fuente,
+                          sf::RenderWindow& ventana,
+                          Modelo modelo) {
     // bloque try-catch para manejo de errores
     try {
         // verifica si la ventana está abierta
@@ -58,15 +69,10 @@ void ModelViewer::visualizar(const std::vector<Vertice>& vertices,
         // centra el cursor en la ventana
         sf::Mouse::setPosition(sf::Vector2i(ventana.getSize().x/2, ventana.getSize().y/2), ventana);
 
-        // vector para almacenar conexiones entre vértices
-        std::vector<std::pair<int, int>> conexiones;
-        // configura las conexiones entre vértices
-        Renderer::configurarConexiones(vertices, conexiones);
-        
         // estructura para elementos de la interfaz de usuario
         UIHandler::ElementosUI interfaz;
         // inicializa los elementos de la interfaz
-        UIHandler::inicializar(interfaz, fuente, cache, tiempoSimulacion, vertices.size());
+        UIHandler::inicializar(interfaz, fuente, cache, tiempoSimulacion, cantidadVertices);
         
         // crea una cámara y estado de entrada
         Camara camara;
@@ -106,7 +112,7 @@ void ModelViewer::visualizar(const std::vector<Vertice>& vertices,
                 // limpia la ventana con color de fondo
                 ventana.clear(sf::Color(45, 45, 60));
                 // renderiza el modelo 3D
-                Renderer::renderizarModelo(ventana, vertices, conexiones, camara, Renderer::MODO_MIXTO);
+                Renderer::renderizarModelo(ventana, modelo(camara), conexiones, camara, Renderer::MODO_MIXTO);
                 
                 // dibuja puntero FPS en el centro
                 Renderer::dibujarPuntero(ventana, sf::Color::White);
@@ -133,4 +139,93 @@ void ModelViewer::visualizar(const std::vector<Vertice>& vertices,
         std::cerr << "Error fatal en ModelViewer: " << e.what() << "\n";
         throw;
     }
+}
+
+// función principal para visualización del modelo
+void ModelViewer::visualizar(const std::vector<Vertice>& vertices, 
+                           const Cache& cache,
+                           double tiempoSimulacion, 
+                           bool modoGrafico, 
+                           const sf::Font& fuente,
+                           sf::RenderWindow& ventana) {
+    // si no está en modo gráfico, termina la función
+    if (!modoGrafico) {
+        return;
+    }
+
+    // vector para almacenar conexiones entre vértices
+    std::vector<std::pair<int, int>> conexiones;
+    // configura las conexiones entre vértices
+    Renderer::configurarConexiones(vertices, conexiones);
+
+    // el modelo no cambia entre frames
+    ejecutarVisor(cache, tiempoSimulacion, vertices.size(), conexiones, fuente, ventana,
+                  [&](const Camara&) -> const std::vector<Vertice>& { return vertices; });
+}
+
+// visualización de una nube de puntos mientras se carga
+void ModelViewer::visualizarNube(CargadorNubePuntos& cargador,
+                               const Cache& cache,
+                               double tiempoSimulacion,
+                               bool modoGrafico,
+                               const sf::Font& fuente,
+                               sf::RenderWindow& ventana) {
+    // si no está en modo gráfico, termina la función
+    if (!modoGrafico) {
+        return;
+    }
+
+    // puntos recibidos hasta ahora, una sola copia que se dibuja tal cual, y los tramos que
+    // ocupa cada celda para poder soltarlos
+    std::vector<Vertice> puntos;
+    std::vector<TramoNube> tramos;
+    // quita los tramos de una celda desplazando hacia delante los que van detrás
+    auto soltarCelda = [&](uint32_t celda) {
+        size_t libre = 0;
+        size_t quedan = 0;
+        for (size_t i = 0; i < tramos.size(); ++i) {
+            const TramoNube tramo = tramos[i];
+            if (tramo.celda == celda) continue;
+            if (tramo.inicio != libre) {
+                std::copy(puntos.begin() + tramo.inicio, puntos.begin() + tramo.inicio + tramo.cantidad,
+                          puntos.begin() + libre);
+            }
+            tramos[quedan++] = TramoNube{tramo.celda, libre, tramo.cantidad};
+            libre += tramo.cantidad;
+        }
+        tramos.resize(quedan);
+        puntos.resize(libre);
+    };
+    // los puntos sueltos no tienen aristas
+    const std::vector<std::pair<int, int>> sinConexiones;
+    bool cargaFallida = false;
+
+    ejecutarVisor(cache, tiempoSimulacion, 0, sinConexiones, fuente, ventana,
+                  [&](const Camara& camara) -> const std::vector<Vertice>& {
+        if (cargaFallida) return puntos;
+        try {
+            // el índice sirve primero las celdas cercanas a la cámara
+            cargador.enfocar(camara.x, camara.y, camara.z);
+            BloquePuntos bloque;
+            // pocos bloques por frame para que la carga no frene el dibujo
+            for (int i = 0; i < BLOQUES_POR_FRAME && cargador.siguienteBloque(bloque); ++i) {
+                if (bloque.descartar) {
+                    soltarCelda(bloque.celda);
+                    continue;
+                }
+                // bloques seguidos de la misma celda amplían su último tramo
+                if (!tramos.empty() && tramos.back().celda == bloque.celda) {
+                    tramos.back().cantidad += bloque.puntos.size();
+                } else {
+                    tramos.push_back(TramoNube{bloque.celda, puntos.size(), bloque.puntos.size()});
+                }
+                puntos.insert(puntos.end(), bloque.puntos.begin(), bloque.puntos.end());
+            }
+        } catch (const std::runtime_error& e) {
+            // se sigue mostrando lo que ya se había cargado
+            std::cerr << "Error al cargar la nube de puntos: " << e.what() << "\n";
+            cargaFallida = true;
+        }
+        return puntos;
+    });
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "../Cache/Cache.hpp"
 #include "../Common/Vertice.hpp"
 
+class CargadorNubePuntos;
+
 class ModelViewer {
 public:
     static void visualizar(const std::vector<Vertice>& modelo, 
@@ -14,6 +16,14 @@ public:
                          bool modoGrafico,
                          const sf::Font& font,
                          sf::RenderWindow& ventana); // Parámetro añadido
+
+    // dibuja la nube desde el primer frame y añade los bloques según llegan del cargador
+    static void visualizarNube(CargadorNubePuntos& cargador,
+                             const Cache& cache,
+                             double tiempoSimulacion,
+                             bool modoGrafico,
+                             const sf::Font& fuente,
+                             sf::RenderWindow& ventana);
 };
 
 #endif // MODEL_VIEWER_HPP
\ No newline at end of file
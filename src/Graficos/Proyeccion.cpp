@@ -0,0 +1,82 @@
+// incluye la definición de la proyección
+#include "Graficos/Proyeccion.hpp"
+
+// funciones matemáticas (sin, cos, tan)
+#include <cmath>
+
+// algoritmos como std::clamp
+#include <algorithm>
+
+// distancia mínima de visualización
+constexpr float Z_NEAR = 0.05f;
+
+// distancia máxima de visualización
+constexpr float Z_FAR = 100.0f;
+
+// campo de visión en radianes (60 grados)
+constexpr float FOV = 60.0f * 3.14159f / 180.0f;
+
+// relación de aspecto (1024x768)
+constexpr float ASPECT_RATIO = 1024.0f / 768.0f;
+
+// factor de escala de la vista
+constexpr float VIEWPORT_SCALE = 400.0f;
+
+// rotaciones de la cámara ya evaluadas
+struct RotacionCamara {
+    float cosY, sinY, cosX, sinX;
+};
+
+// evalúa senos y cosenos de la cámara (la rotación vertical se limita)
+static RotacionCamara calcularRotacion(const Camara& cam) {
+    float rotX = std::clamp(cam.rotX, -1.48f, 1.48f);
+    return RotacionCamara{std::cos(cam.rotY), std::sin(cam.rotY), std::cos(rotX), std::sin(rotX)};
+}
+
+// transforma un vértice con la rotación ya evaluada
+static void aplicarRotacion(Vertice& v, const Camara& cam, const RotacionCamara& r) {
+    // posición relativa del vértice respecto a la cámara
+    float dx = v.x - cam.x;
+    float dy = v.y - cam.y;
+    float dz = v.z - cam.z;
+
+    // rotación horizontal de los ejes X y Z
+    float x1 = dx * r.cosY + dz * r.sinY;
+    float z1 = -dx * r.sinY + dz * r.cosY;
+
+    // rotación vertical de los ejes Y y Z
+    v.y = dy * r.cosX - z1 * r.sinX;
+    v.z = dy * r.sinX + z1 * r.cosX;
+    v.x = x1;
+}
+
+// transforma un vértice al espacio de la cámara
+void Proyeccion::transformarVertice(Vertice& v, const Camara& camara) {
+    aplicarRotacion(v, camara, calcularRotacion(camara));
+}
+
+// transforma y proyecta todos los vértices
+void Proyeccion::proyectarVertices(const std::vector<Vertice>& vertices, const Camara& camara,
+                                   std::vector<PuntoProyectado>& proyectados) {
+    const RotacionCamara rotacion = calcularRotacion(camara);
+    // factor de perspectiva común a todos los vértices
+    const float tanMedioFov = std::tan(FOV / 2);
+
+    proyectados.resize(vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        Vertice vt = vertices[i];
+        // transforma a espacio de cámara
+        aplicarRotacion(vt, camara, rotacion);
+
+        // proyección perspectiva
+        if (vt.z < -Z_NEAR && vt.z > -Z_FAR) {
+            float factor = 1.0f / (-vt.z * tanMedioFov);
+            proyectados[i].x = vt.x * factor * ASPECT_RATIO * VIEWPORT_SCALE + 512.0f;
+            proyectados[i].y = -vt.y * factor * VIEWPORT_SCALE + 384.0f;
+        } else {
+            // posición fuera de pantalla si no es visible
+            proyectados[i].x = FUERA_DE_PANTALLA;
+            proyectados[i].y = FUERA_DE_PANTALLA;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// protección para evitar inclusiones múltiples
+#ifndef PROYECCION_HPP
+#define PROYECCION_HPP
+
+// contenedor para los vértices
+#include <vector>
+// definición de la estructura Vertice
+#include "Common/Vertice.hpp"
+// definición de la cámara
+#include "Graficos/CameraController.hpp"
+
+// posición en pantalla de un vértice proyectado
+struct PuntoProyectado {
+    float x, y;
+};
+
+// transformación y proyección de vértices sin dependencias de SFML,
+// compartida por el renderizador y el benchmark
+class Proyeccion {
+public:
+    // posición de pantalla de los vértices fuera del volumen visible
+    static constexpr float FUERA_DE_PANTALLA = -10000.0f;
+
+    // transforma un vértice al espacio de la cámara
+    static void transformarVertice(Vertice& v, const Camara& camara);
+
+    // transforma y proyecta todos los vértices; los senos y cosenos de la cámara
+    // se calculan una sola vez por llamada en lugar de una vez por vértice
+    static void proyectarVertices(const std::vector<Vertice>& vertices, const Camara& camara,
+                                  std::vector<PuntoProyectado>& proyectados);
+};
+
+#endif // PROYECCION_HPP
@@ -7,6 +7,9 @@
 // incluye controlador de cámara
 #include "CameraController.hpp"
 
+// incluye transformación y proyección de vértices
+#include "Proyeccion.hpp"
+
 // incluye algoritmos como sort
 #include <algorithm>
 
@@ -25,21 +28,6 @@ const sf::Color COLOR_ARISTAS(255, 200, 50, 220);
 // color para vértices (blanco brillante)
 const sf::Color COLOR_VERTICES(240, 240, 240, 255);
 
-// distancia mínima de visualización
-constexpr float Z_NEAR = 0.05f;
-
-// distancia máxima de visualización
-constexpr float Z_FAR = 100.0f;
-
-// campo de visión en radianes (60 grados)
-constexpr float FOV = 60.0f * 3.14159f / 180.0f;
-
-// relación de aspecto (1024x768)
-constexpr float ASPECT_RATIO = 1024.0f / 768.0f;
-
-// factor de escala de la vista
-constexpr float VIEWPORT_SCALE = 400.0f;
-
 // genera las caras de los modelos predefinidos
 void Renderer::generarCaras(const std::vector<Vertice>& /*vertices*/,
                           std::vector<std::vector<int>>& caras,
@@ -103,29 +91,12 @@ void Renderer::renderizarModelo(sf::RenderWindow& ventana,
     ventana.clear(FONDO);
 
     // 1. transformación y proyección de vértices
+    std::vector<PuntoProyectado> proyectados;
+    Proyeccion::proyectarVertices(vertices, camara, proyectados);
     std::vector<sf::Vector2f> verticesProyectados;
-    verticesProyectados.reserve(vertices.size());
-    
-    // procesa cada vértice
-    for (const auto& v : vertices) {
-        Vertice vt = v;
-        // transforma a espacio de cámara
-        CameraController::transformarVertice(vt, camara);
-
-        // proyección perspectiva
-        if (vt.z < -Z_NEAR && vt.z > -Z_FAR) {
-            // cálculo de factor de perspectiva
-            float factor = 1.0f / (-vt.z * tan(FOV/2));
-            // proyección en x e y
-            float x = vt.x * factor * ASPECT_RATIO * VIEWPORT_SCALE + 512.0f;
-            float y = -vt.y * factor * VIEWPORT_SCALE + 384.0f;
-            
-            // guarda vértice proyectado
-            verticesProyectados.emplace_back(x, y);
-        } else {
-            // posición fuera de pantalla si no es visible
-            verticesProyectados.emplace_back(-10000, -10000);
-        }
+    verticesProyectados.reserve(proyectados.size());
+    for (const auto& p : proyectados) {
+        verticesProyectados.emplace_back(p.x, p.y);
     }
 
     // 2. renderizado de caras con ordenación por profundidad
@@ -8,14 +8,41 @@
 #include <stdexcept>
 // para verificar existencia de archivos
 #include <sys/stat.h>
+// para argumentos de linea de ordenes
+#include <string>
+// para escribir el informe en un archivo
+#include <fstream>
+// para el lector de la traza elegido en tiempo de ejecucion
+#include <memory>
+// para esperar los bloques de la nube
+#include <thread>
+// para partir la lista de conjuntos de --curva
+#include <algorithm>
 // para gráficos 2D
 #include <SFML/Graphics.hpp>
 // para manejo de ventanas
 #include <SFML/Window.hpp>
 // nuestro archivo de caché
 #include "Cache/Cache.hpp"
+// varios nucleos con caches coherentes
+#include "Cache/SistemaCoherente.hpp"
+// informe de la simulacion en JSON o CSV
+#include "Cache/InformeCache.hpp"
+// caches con la geometria fijada en compilacion
+#include "Cache/CacheFija.hpp"
+// distancias de pila para la curva de fallos de todas las caches LRU
+#include "Cache/DistanciaPila.hpp"
 // generador de patrones de acceso
 #include "DataGenerators/GeneradorDatos.hpp"
+// lector de trazas binarias
+#include "DataLoaders/TrazaBinaria.hpp"
+// importadores de trazas de DineroIV, lackey y ChampSim
+#include "DataLoaders/ImportadorTrazas.hpp"
+// lectores de modelos .obj y de texto, con su cache binaria
+#include "DataLoaders/LectorModelos3D.hpp"
+#include "DataLoaders/CargadorDatos.hpp"
+// carga de nubes de puntos en segundo plano
+#include "DataLoaders/NubePuntos.hpp"
 // generador de modelos 3D básicos
 #include "DataGenerators/GeneradorModelos3D.hpp"
 // visualizador 3D principal
@@ -33,6 +60,16 @@ int mostrarMenuModelado();
 void mostrarEstadisticasCache(const Cache& cache, double simTime);
 // carga fuente tipográfica desde archivo
 bool cargarFuente(sf::Font& font, const std::string& path);
+// simula una traza binaria sin ventana ni menús
+int ejecutarTraza(int argc, char* argv[]);
+// simula una traza binaria por nucleo con caches coherentes
+int ejecutarCoherencia(int argc, char* argv[]);
+// simulacion por lotes configurada por opciones, con informe JSON o CSV
+int ejecutarSimulacion(int argc, char* argv[]);
+// convierte un modelo .obj o de texto a malla binaria
+int ejecutarConversionMalla(int argc, char* argv[]);
+// carga una nube de puntos por bloques sin ventana y mide la carga
+int ejecutarNube(int argc, char* argv[]);
 
 // implementación función limpiar terminal
 void limpiarTerminal() {
@@ -92,11 +129,12 @@ int mostrarMenuModelado() {
         std::cout << "\n=== MENU DE MODELADO 3D ===\n";
         std::cout << "1. Visualizar cubo\n";
         std::cout << "2. Visualizar piramide\n";
-        std::cout << "3. Volver al menu principal\n";
-        std::cout << "Seleccione una opcion (1-3): ";
+        std::cout << "3. Visualizar nube de puntos (archivo x y z)\n";
+        std::cout << "4. Volver al menu principal\n";
+        std::cout << "Seleccione una opcion (1-4): ";
         
         // valida la entrada
-        if (std::cin >> opcion && opcion >= 1 && opcion <= 3) {
+        if (std::cin >> opcion && opcion >= 1 && opcion <= 4) {
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             return opcion;
         }
@@ -126,22 +164,476 @@ bool cargarFuente(sf::Font& font, const std::string& path) {
     return (stat(path.c_str(), &buffer) == 0) && font.loadFromFile(path);
 }
 
+// modo sin interfaz: --traza archivo [tamaño bloque vias] [--clasificar]
+// --clasificar separa los fallos en obligatorios, de capacidad y de conflicto (mantiene una
+// cache LRU de sombra: cuesta alrededor del doble y desactiva los caminos rapidos)
+int ejecutarTraza(int argc, char* argv[]) {
+    std::vector<std::string> posicionales;
+    bool clasificar = false;
+    for (int i = 3; i < argc; ++i) {
+        if (std::string(argv[i]) == "--clasificar") clasificar = true;
+        else posicionales.push_back(argv[i]);
+    }
+    // geometría por defecto igual a la del modo interactivo
+    int tamano = posicionales.size() > 0 ? std::stoi(posicionales[0]) : 1024;
+    int bloque = posicionales.size() > 1 ? std::stoi(posicionales[1]) : 64;
+    int vias = posicionales.size() > 2 ? std::stoi(posicionales[2]) : 4;
+    Cache cache(tamano, bloque, vias);
+    if (clasificar) cache.configurarClasificacion(true);
+
+    // abre la traza proyectada en memoria
+    LectorTrazaBinaria lector(argv[2]);
+    TramoTraza tramo;
+
+    // la traza se consume por tramos, nunca entera en memoria
+    auto startSim = std::chrono::high_resolution_clock::now();
+    while (lector.siguienteTramo(tramo)) {
+        // las trazas con tipo distinguen lecturas y escrituras
+        if (lector.tieneTipos()) {
+            cache.accederLote(tramo.direcciones.data(), tramo.tipos.data(), tramo.direcciones.size());
+            continue;
+        }
+        cache.accederLote(tramo.direcciones);
+    }
+    double simTime = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startSim).count();
+
+    // muestra resultados
+    std::cout << "Traza: " << argv[2] << " (" << lector.getNumRegistros() << " accesos, "
+              << lector.getAnchoDireccion() * 8 << " bits)\n";
+    std::cout << "Tiempo simulacion: " << simTime << " ms\n";
+    cache.imprimirEstadisticas();
+    return EXIT_SUCCESS;
+}
+
+// modo sin interfaz: --malla modelo [destino]
+// convierte un .obj (o un modelo de texto "x y z") a malla binaria; por defecto el destino es
+// modelo.cmsh, que los lectores usan en lugar del texto mientras no sea mas antiguo que el
+int ejecutarConversionMalla(int argc, char* argv[]) {
+    const std::string origen = argv[2];
+    const std::string destino = argc > 3 ? argv[3] : rutaMallaBinaria(origen);
+    const bool esObj = origen.size() >= 4 && origen.compare(origen.size() - 4, 4, ".obj") == 0;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    MallaIndexada malla;
+    if (esObj) {
+        malla = LectorModelos3D::cargarMallaOBJ(origen);
+    } else {
+        // lanza si no se puede leer (una cache vigente da los mismos vertices)
+        malla.vertices = CargadorDatos::abrirModelo(origen, false).copiarVertices();
+    }
+    double tiempoTexto = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+    escribirMallaBinaria(destino, malla);
+
+    // comprueba la malla escrita y mide lo que cuesta abrirla
+    inicio = std::chrono::high_resolution_clock::now();
+    MallaProyectada proyectada(destino);
+    double tiempoBinario = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+    if (!proyectada.comprobarSuma()) {
+        throw std::runtime_error("La suma de comprobacion de " + destino + " no coincide");
+    }
+    std::cout << "Malla binaria: " << destino << " (" << proyectada.getNumVertices() << " vertices, "
+              << proyectada.getNumTriangulos() << " triangulos)\n";
+    std::cout << "Lectura del texto: " << tiempoTexto << " ms, apertura del binario: " << tiempoBinario << " ms\n";
+    return EXIT_SUCCESS;
+}
+
+// modo sin interfaz: --nube archivo [--indice] [--celdas n] [--radio r] [--foco x y z]
+// recoge los bloques como lo haria el visor; con --indice solo las celdas a menos de radio del foco
+int ejecutarNube(int argc, char* argv[]) {
+    ConfiguracionNube configuracion;
+    for (int i = 3; i < argc; ++i) {
+        const std::string opcion = argv[i];
+        // las opciones con valor consumen los argumentos siguientes
+        auto valor = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Falta el valor de " + opcion);
+            return argv[++i];
+        };
+        if (opcion == "--indice") configuracion.usarIndice = true;
+        else if (opcion == "--celdas") configuracion.celdasPorEje = static_cast<unsigned>(std::stoul(valor()));
+        else if (opcion == "--radio") configuracion.radio = std::stof(valor());
+        else if (opcion == "--foco") {
+            configuracion.foco.x = std::stof(valor());
+            configuracion.foco.y = std::stof(valor());
+            configuracion.foco.z = std::stof(valor());
+        }
+        else throw std::invalid_argument("Opcion desconocida: " + opcion);
+    }
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    CargadorNubePuntos cargador(argv[2], configuracion);
+    BloquePuntos bloque;
+    double primerBloque = -1.0;
+    uint64_t bloques = 0;
+    uint64_t residentes = 0;
+    // espera corta sin bloque: el hilo del cargador trabaja mientras tanto
+    while (true) {
+        if (!cargador.siguienteBloque(bloque)) {
+            if (cargador.estaAlDia()) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        if (primerBloque < 0.0) {
+            primerBloque = std::chrono::duration<double, std::milli>(
+                std::chrono::high_resolution_clock::now() - inicio).count();
+        }
+        if (bloque.descartar) continue;
+        ++bloques;
+        residentes += bloque.puntos.size();
+    }
+    double tiempoCarga = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - inicio).count();
+
+    std::cout << "Nube: " << argv[2] << " (" << residentes << " puntos en " << bloques << " bloques"
+              << (configuracion.usarIndice ? ", celdas cercanas al foco" : "") << ")\n";
+    std::cout << "Primer bloque: " << primerBloque << " ms, carga completa: " << tiempoCarga << " ms\n";
+    return EXIT_SUCCESS;
+}
+
+// modo sin interfaz: --coherencia [mesi|moesi] traza0 traza1 ...
+int ejecutarCoherencia(int argc, char* argv[]) {
+    int primera = 2;
+    ProtocoloCoherencia protocolo = ProtocoloCoherencia::MESI;
+    if (std::string(argv[2]) == "mesi" || std::string(argv[2]) == "moesi") {
+        protocolo = std::string(argv[2]) == "moesi" ? ProtocoloCoherencia::MOESI : ProtocoloCoherencia::MESI;
+        ++primera;
+    }
+
+    // una traza por nucleo, cargada entera en memoria
+    std::vector<TrazaNucleo> trazas;
+    for (int i = primera; i < argc; ++i) {
+        LectorTrazaBinaria lector(argv[i]);
+        TramoTraza tramo;
+        TrazaNucleo traza;
+        while (lector.siguienteTramo(tramo)) {
+            traza.direcciones.insert(traza.direcciones.end(), tramo.direcciones.begin(), tramo.direcciones.end());
+            if (lector.tieneTipos()) {
+                traza.tipos.insert(traza.tipos.end(), tramo.tipos.begin(), tramo.tipos.end());
+            }
+        }
+        trazas.push_back(std::move(traza));
+    }
+    if (trazas.empty()) {
+        throw std::invalid_argument("Se necesita al menos una traza");
+    }
+
+    // L1 privada de 32K y 8 vias por nucleo, LLC compartida de 1M y 16 vias
+    SistemaCoherente sistema(static_cast<int>(trazas.size()), {32768, 64, 8}, {1048576, 64, 16}, protocolo);
+    auto startSim = std::chrono::high_resolution_clock::now();
+    sistema.simular(trazas);
+    double simTime = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - startSim).count();
+
+    std::cout << "Tiempo simulacion: " << simTime << " ms\n";
+    sistema.imprimirEstadisticas();
+    return EXIT_SUCCESS;
+}
+
+// convierte un tamaño con sufijo opcional K, M o G (32K = 32768)
+static int leerTamano(const std::string& texto) {
+    std::size_t usados = 0;
+    long long valor = std::stoll(texto, &usados);
+    const std::string sufijo = texto.substr(usados);
+    if (sufijo == "K" || sufijo == "k") valor <<= 10;
+    else if (sufijo == "M" || sufijo == "m") valor <<= 20;
+    else if (sufijo == "G" || sufijo == "g") valor <<= 30;
+    else if (!sufijo.empty()) throw std::invalid_argument("Sufijo de tamaño no valido: " + texto);
+    if (valor <= 0 || valor > 0x7fffffff) throw std::invalid_argument("Tamaño fuera de rango: " + texto);
+    return static_cast<int>(valor);
+}
+
+// politica de reemplazo por nombre corto
+static PoliticaReemplazo leerPolitica(const std::string& nombre) {
+    if (nombre == "lru") return PoliticaReemplazo::LRU;
+    if (nombre == "plru") return PoliticaReemplazo::PLRU_ARBOL;
+    if (nombre == "srrip") return PoliticaReemplazo::SRRIP;
+    if (nombre == "brrip") return PoliticaReemplazo::BRRIP;
+    if (nombre == "fifo") return PoliticaReemplazo::FIFO;
+    if (nombre == "random") return PoliticaReemplazo::ALEATORIA;
+    throw std::invalid_argument("Politica desconocida: " + nombre);
+}
+
+// prefetcher por nombre corto
+static TipoPrefetcher leerPrefetcher(const std::string& nombre) {
+    if (nombre == "none") return TipoPrefetcher::NINGUNO;
+    if (nombre == "next") return TipoPrefetcher::LINEA_SIGUIENTE;
+    if (nombre == "stride") return TipoPrefetcher::STRIDE_PC;
+    if (nombre == "stream") return TipoPrefetcher::FLUJO;
+    throw std::invalid_argument("Prefetcher desconocido: " + nombre);
+}
+
+// funcion de indice por nombre corto
+static FuncionIndice leerIndice(const std::string& nombre) {
+    if (nombre == "mask") return FuncionIndice::MASCARA;
+    if (nombre == "mod") return FuncionIndice::MODULO;
+    if (nombre == "xor") return FuncionIndice::XOR;
+    if (nombre == "prime") return FuncionIndice::PRIMO;
+    if (nombre == "skew") return FuncionIndice::SESGADA;
+    throw std::invalid_argument("Funcion de indice desconocida: " + nombre);
+}
+
+// formato de traza externa por nombre corto
+static FormatoTrazaExterna leerFormatoExterno(const std::string& nombre) {
+    if (nombre == "din") return FormatoTrazaExterna::DINERO;
+    if (nombre == "lackey") return FormatoTrazaExterna::LACKEY;
+    if (nombre == "champsim") return FormatoTrazaExterna::CHAMPSIM;
+    throw std::invalid_argument("Formato de traza desconocido: " + nombre);
+}
+
+// modo por lotes: --sim --trace archivo [--size 32K] [--block 64] [--ways 8] [--policy lru]
+// [--write wb|wt] [--no-write-allocate] [--prefetch none|next|stride|stream] [--classify]
+// [--sample N] (simula uno de cada N conjuntos y estima la tasa global)
+// [--index mask|mod|xor|prime|skew] (mod, prime y skew admiten conjuntos no potencia de dos)
+// [--import din|lackey|champsim] [--no-instructions] (traza externa; --trace - lee la entrada
+// estandar, p. ej. valgrind --tool=lackey --trace-mem=yes prog 2>&1 | ... --trace -)
+// [--format json|csv] [--no-header] [--output archivo]
+// no crea ventanas, fuentes ni menus: pensado para barridos desde scripts
+int ejecutarSimulacion(int argc, char* argv[]) {
+    std::string rutaTraza;
+    std::string rutaSalida;
+    int tamano = 1024;
+    int bloque = 64;
+    int vias = 4;
+    PoliticaReemplazo politica = PoliticaReemplazo::LRU;
+    PoliticaEscritura escritura = PoliticaEscritura::WRITE_BACK;
+    bool asignarEnEscritura = true;
+    ConfiguracionPrefetch prefetch;
+    bool clasificar = false;
+    int factorMuestreo = 1;
+    FuncionIndice indice = FuncionIndice::MASCARA;
+    bool importar = false;
+    FormatoTrazaExterna formatoExterno = FormatoTrazaExterna::DINERO;
+    bool incluirInstrucciones = true;
+    FormatoInforme formato = FormatoInforme::JSON;
+    bool cabeceraCsv = true;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string opcion = argv[i];
+        // las opciones con valor consumen el argumento siguiente
+        auto valor = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Falta el valor de " + opcion);
+            return argv[++i];
+        };
+        if (opcion == "--trace") rutaTraza = valor();
+        else if (opcion == "--size") tamano = leerTamano(valor());
+        else if (opcion == "--block") bloque = leerTamano(valor());
+        else if (opcion == "--ways") vias = std::stoi(valor());
+        else if (opcion == "--policy") politica = leerPolitica(valor());
+        else if (opcion == "--write") {
+            const std::string nombre = valor();
+            if (nombre != "wb" && nombre != "wt") throw std::invalid_argument("Politica de escritura desconocida: " + nombre);
+            escritura = nombre == "wt" ? PoliticaEscritura::WRITE_THROUGH : PoliticaEscritura::WRITE_BACK;
+        }
+        else if (opcion == "--no-write-allocate") asignarEnEscritura = false;
+        else if (opcion == "--prefetch") prefetch.tipo = leerPrefetcher(valor());
+        else if (opcion == "--classify") clasificar = true;
+        else if (opcion == "--sample") factorMuestreo = std::stoi(valor());
+        else if (opcion == "--index") indice = leerIndice(valor());
+        else if (opcion == "--import") {
+            importar = true;
+            formatoExterno = leerFormatoExterno(valor());
+        }
+        else if (opcion == "--no-instructions") incluirInstrucciones = false;
+        else if (opcion == "--format") {
+            const std::string nombre = valor();
+            if (nombre != "json" && nombre != "csv") throw std::invalid_argument("Formato desconocido: " + nombre);
+            formato = nombre == "csv" ? FormatoInforme::CSV : FormatoInforme::JSON;
+        }
+        else if (opcion == "--no-header") cabeceraCsv = false;
+        else if (opcion == "--output") rutaSalida = valor();
+        else throw std::invalid_argument("Opcion desconocida: " + opcion);
+    }
+    if (rutaTraza.empty()) {
+        throw std::invalid_argument("--sim necesita --trace archivo");
+    }
+
+    // traza binaria proyectada en memoria o traza externa importada en flujo
+    std::unique_ptr<LectorTrazaBinaria> lector;
+    std::unique_ptr<ImportadorTraza> importador;
+    if (importar) importador = std::make_unique<ImportadorTraza>(rutaTraza, formatoExterno, incluirInstrucciones);
+    else lector = std::make_unique<LectorTrazaBinaria>(rutaTraza);
+    auto siguienteTramo = [&](TramoTraza& tramo) {
+        return importador ? importador->siguienteTramo(tramo) : lector->siguienteTramo(tramo);
+    };
+    const bool conTipos = importador || lector->tieneTipos();
+    // los pc de la traza (binaria con pc o ChampSim) entrenan al prefetcher de strides
+    const bool conPC = importador ? importador->tienePC() : lector->tienePC();
+    TramoTraza tramo;
+    EjecucionSimulacion ejecucion;
+    ejecucion.traza = rutaTraza;
+    auto simular = [&](auto& cache) {
+        cache.configurarEscritura(escritura, asignarEnEscritura);
+        if (prefetch.tipo != TipoPrefetcher::NINGUNO) cache.configurarPrefetch(prefetch);
+        if (clasificar) cache.configurarClasificacion(true);
+        if (factorMuestreo != 1) cache.configurarMuestreo(factorMuestreo);
+
+        // la traza se consume por tramos, como en --traza
+        auto startSim = std::chrono::steady_clock::now();
+        while (siguienteTramo(tramo)) {
+            if (conPC) {
+                cache.accederLote(tramo.direcciones.data(), conTipos ? tramo.tipos.data() : nullptr,
+                                  tramo.pcs.data(), tramo.direcciones.size());
+                continue;
+            }
+            if (conTipos) {
+                cache.accederLote(tramo.direcciones.data(), tramo.tipos.data(), tramo.direcciones.size());
+                continue;
+            }
+            cache.accederLote(tramo.direcciones);
+        }
+        ejecucion.milisegundos = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startSim).count();
+        return resumirCache(cache);
+    };
+    // las geometrias habituales usan CacheFija, que solo indexa con mascara;
+    // las demas funciones de indice usan siempre la cache dinamica
+    ResumenCache resumen;
+    if (indice == FuncionIndice::MASCARA) {
+        resumen = conCacheEspecializada(tamano, bloque, vias, politica, simular);
+    } else {
+        Cache cache(tamano, bloque, vias, politica, indice);
+        resumen = simular(cache);
+    }
+
+    // informe en la salida estandar o en un archivo
+    if (rutaSalida.empty()) {
+        escribirInforme(std::cout, resumen, ejecucion, formato, cabeceraCsv);
+        return EXIT_SUCCESS;
+    }
+    std::ofstream salida(rutaSalida);
+    if (!salida) {
+        throw std::runtime_error("No se pudo escribir " + rutaSalida);
+    }
+    escribirInforme(salida, resumen, ejecucion, formato, cabeceraCsv);
+    return EXIT_SUCCESS;
+}
+
+// curva de fallos LRU en una sola pasada: --curva --trace archivo [--block 64]
+// [--sets 1,64,1024] (numeros de conjuntos, potencias de dos; 1 = totalmente asociativa)
+// [--max-ways 64] [--import din|lackey|champsim] [--no-instructions] [--format text|csv]
+// da los fallos de todas las caches LRU de esos conjuntos y de 1 a max-ways vias
+int ejecutarCurva(int argc, char* argv[]) {
+    std::string rutaTraza;
+    int bloque = 64;
+    std::vector<int> conjuntos = {1};
+    int viasMaximas = 64;
+    bool importar = false;
+    FormatoTrazaExterna formatoExterno = FormatoTrazaExterna::DINERO;
+    bool incluirInstrucciones = true;
+    bool csv = false;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string opcion = argv[i];
+        auto valor = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Falta el valor de " + opcion);
+            return argv[++i];
+        };
+        if (opcion == "--trace") rutaTraza = valor();
+        else if (opcion == "--block") bloque = leerTamano(valor());
+        else if (opcion == "--sets") {
+            // lista separada por comas
+            const std::string lista = valor();
+            conjuntos.clear();
+            std::size_t inicio = 0;
+            while (inicio <= lista.size()) {
+                const std::size_t coma = std::min(lista.find(',', inicio), lista.size());
+                conjuntos.push_back(std::stoi(lista.substr(inicio, coma - inicio)));
+                inicio = coma + 1;
+            }
+        }
+        else if (opcion == "--max-ways") viasMaximas = std::stoi(valor());
+        else if (opcion == "--import") {
+            importar = true;
+            formatoExterno = leerFormatoExterno(valor());
+        }
+        else if (opcion == "--no-instructions") incluirInstrucciones = false;
+        else if (opcion == "--format") {
+            const std::string nombre = valor();
+            if (nombre != "text" && nombre != "csv") throw std::invalid_argument("Formato desconocido: " + nombre);
+            csv = nombre == "csv";
+        }
+        else throw std::invalid_argument("Opcion desconocida: " + opcion);
+    }
+    if (rutaTraza.empty()) {
+        throw std::invalid_argument("--curva necesita --trace archivo");
+    }
+    if (viasMaximas <= 0) {
+        throw std::invalid_argument("--max-ways debe ser positivo");
+    }
+
+    // valida bloque y conjuntos antes de abrir la traza
+    DistanciaPila distancias(bloque, conjuntos);
+    std::unique_ptr<LectorTrazaBinaria> lector;
+    std::unique_ptr<ImportadorTraza> importador;
+    if (importar) importador = std::make_unique<ImportadorTraza>(rutaTraza, formatoExterno, incluirInstrucciones);
+    else lector = std::make_unique<LectorTrazaBinaria>(rutaTraza);
+    // una sola pasada por la traza, por tramos
+    TramoTraza tramo;
+    while (importador ? importador->siguienteTramo(tramo) : lector->siguienteTramo(tramo)) {
+        distancias.accederLote(tramo.direcciones);
+    }
+
+    if (!csv) {
+        distancias.imprimirCurva(viasMaximas);
+        return EXIT_SUCCESS;
+    }
+    std::cout << "conjuntos,vias,tamano,fallos,tasa_fallos\n";
+    for (const PuntoCurvaFallos& punto : distancias.curvaFallos(viasMaximas)) {
+        std::cout << punto.numConjuntos << ',' << punto.vias << ',' << punto.tamano << ',' << punto.fallos << ','
+                  << punto.tasaFallos << '\n';
+    }
+    return EXIT_SUCCESS;
+}
+
 // punto de entrada principal del programa
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        // modo por lotes sin SFML, configurado por opciones
+        if (argc >= 2 && std::string(argv[1]) == "--sim") {
+            return ejecutarSimulacion(argc, argv);
+        }
+        // curva de fallos LRU de una traza en una sola pasada
+        if (argc >= 2 && std::string(argv[1]) == "--curva") {
+            return ejecutarCurva(argc, argv);
+        }
+        // modo sin interfaz para simular trazas desde archivo
+        if (argc >= 3 && std::string(argv[1]) == "--traza") {
+            return ejecutarTraza(argc, argv);
+        }
+        // conversion de modelos a malla binaria
+        if (argc >= 3 && std::string(argv[1]) == "--malla") {
+            return ejecutarConversionMalla(argc, argv);
+        }
+        // carga de una nube de puntos por bloques
+        if (argc >= 3 && std::string(argv[1]) == "--nube") {
+            return ejecutarNube(argc, argv);
+        }
+        // modo sin interfaz para varios nucleos coherentes
+        if (argc >= 3 && std::string(argv[1]) == "--coherencia") {
+            return ejecutarCoherencia(argc, argv);
+        }
+
         // inicializa caché con 1024 bytes, bloques de 64, 4 vías
         Cache cache(1024, 64, 4);
+        // prefetch de linea siguiente dos bloques por delante (los bloques traidos
+        // por prefetch no cuentan como accesos)
+        ConfiguracionPrefetch prefetch;
+        prefetch.tipo = TipoPrefetcher::LINEA_SIGUIENTE;
+        prefetch.distancia = 2;
+        cache.configurarPrefetch(prefetch);
         // genera secuencia de direcciones optimizada
-        std::vector<int> addresses = GeneradorDatos::generarSecuenciaOptimizada(1024, 64, 4);
+        std::vector<uint64_t> addresses = GeneradorDatos::generarSecuenciaOptimizada(1024, 64, 4);
 
         // marca tiempo inicial para medir simulación
         auto startSim = std::chrono::high_resolution_clock::now();
         // ejecuta secuencia de accesos a caché
-        for (int addr : addresses) {
+        for (uint64_t addr : addresses) {
             cache.accederConPrefetch(addr);
         }
-        // calcula tiempo transcurrido en milisegundos
-        double simTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        // calcula tiempo transcurrido en milisegundos (con decimales)
+        double simTime = std::chrono::duration<double, std::milli>(
             std::chrono::high_resolution_clock::now() - startSim).count();
 
         // objeto para almacenar la fuente
@@ -193,6 +685,24 @@ int main() {
                                 ventana
                             );
                         }
+                    } else if (modelOption == 3) {
+                        // pide la nube y si se usa el indice espacial
+                        std::string ruta;
+                        std::string respuesta;
+                        std::cout << "Archivo de la nube: ";
+                        std::getline(std::cin, ruta);
+                        std::cout << "Usar indice espacial (s/n): ";
+                        std::getline(std::cin, respuesta);
+                        ConfiguracionNube configuracion;
+                        configuracion.usarIndice = !respuesta.empty() && (respuesta[0] == 's' || respuesta[0] == 'S');
+                        try {
+                            // la ventana se abre enseguida y la nube se va completando
+                            CargadorNubePuntos cargador(ruta, configuracion);
+                            sf::RenderWindow ventana(sf::VideoMode(1024, 768), "Visualizador 3D");
+                            ModelViewer::visualizarNube(cargador, cache, simTime, graphicMode, font, ventana);
+                        } catch (const std::runtime_error& e) {
+                            std::cerr << "Error: " << e.what() << "\n";
+                        }
                     }
                     break;
                 }